@@ -1,90 +0,0 @@
-#pragma once
-
-#include <Adafruit_GFX.h>
-
-// 'arrow_bold_dn', 7x8px
-const unsigned char bmp_arrow_bold_dn [] PROGMEM = {
-	0x40, 0x40, 0x40, 0xa2, 0xa2, 0xc6, 0xee, 0xee
-};
-// 'arrow_bold_up', 7x8px
-const unsigned char bmp_arrow_bold_up [] PROGMEM = {
-	0xee, 0xee, 0xc6, 0xa2, 0xa2, 0x40, 0x40, 0x40
-};
-// 'arrow_thin_dn', 5x9px
-const unsigned char bmp_arrow_thin_dn [] PROGMEM = {
-	0x70, 0x70, 0xa8, 0xa8, 0xa8, 0xa8, 0xd8, 0xd8, 0xd8
-};
-// 'arrow_thin_up', 5x9px
-const unsigned char bmp_arrow_thin_up [] PROGMEM = {
-	0xd8, 0xd8, 0xd8, 0xa8, 0xa8, 0xa8, 0xa8, 0x70, 0x70
-};
-// 'bat_full', 14x5px
-const unsigned char bmp_bat_full [] PROGMEM = {
-	0x00, 0x04, 0x7f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04
-};
-// 'danger', 9x11px
-const unsigned char bmp_danger [] PROGMEM = {
-	0xc1, 0x80, 0x80, 0x80, 0xb6, 0x80, 0xb6, 0x80, 0x80, 0x80, 0xc1, 0x80, 0xd5, 0x80, 0x7f, 0x00, 
-	0x88, 0x80, 0xf7, 0x80, 0x08, 0x00
-};
-// 'gauge_h_bg', 101x16px
-const unsigned char bmp_gauge_h_bg [] PROGMEM = {
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 
-	0x02, 0xaa, 0xab, 0xaa, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x15, 0xff, 
-	0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x01, 0x6a, 0x57, 0xd3, 0x40, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x15, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x0a, 0xaa, 0xab, 0xaa, 0xa8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xbf, 0xff, 0xfb, 0xff, 0xff, 0xbf, 
-	0xff, 0xfb, 0xff, 0xff, 0xbf, 0xf0, 0x2a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 
-	0xaa, 0xaa, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'gauge_t_bg', 101x16px
-const unsigned char bmp_gauge_t_bg [] PROGMEM = {
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2a, 0xaa, 0xaa, 
-	0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa0, 0x3b, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 
-	0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xb0, 0x7f, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 
-	0xff, 0xff, 0xbf, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xf0, 0x00, 0x00, 0xaa, 0xaa, 0xaa, 0xaf, 0xea, 0xaa, 0xd5, 0x55, 0x40, 0x00, 0x00, 0x70, 
-	0x00, 0x00, 0x05, 0x55, 0x7f, 0xff, 0xd5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x55, 0x52, 
-	0xaa, 0xd7, 0xf5, 0x2a, 0xaa, 0xaa, 0x80, 0x00, 0x00, 0x20, 0x00, 0x00, 0x05, 0x55, 0x7f, 0xff, 
-	0xd5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x2a, 0xaa, 0xaa, 0xaf, 0xea, 0xaa, 0xd5, 0x55, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'h_icon', 10x8px
-const unsigned char bmp_h_icon [] PROGMEM = {
-	0xdf, 0xc0, 0xdf, 0xc0, 0x8f, 0xc0, 0x8f, 0xc0, 0x45, 0x80, 0x47, 0x40, 0x06, 0xc0, 0x8d, 0x80
-};
-// 'no_sd_card', 48x10px
-const unsigned char bmp_no_sd_card [] PROGMEM = {
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x5a, 0x1c, 0x23, 0xc2, 
-	0x10, 0x8c, 0x4a, 0xdd, 0xed, 0xde, 0xd6, 0xb4, 0x52, 0xdc, 0x2d, 0xde, 0x10, 0xb4, 0x5a, 0xdf, 
-	0xad, 0xde, 0xd5, 0xb4, 0x5a, 0x1c, 0x23, 0xc2, 0xd4, 0x8c, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xfc, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x01
-};
-// 'sd_card_icon', 4x5px
-const unsigned char bmp_sd_card_icon [] PROGMEM = {
-	0x10, 0x00, 0x00, 0x60, 0x00
-};
-// 'stats_hint', 16x15px
-const unsigned char bmp_stats_hint [] PROGMEM = {
-	0x80, 0x01, 0x7f, 0x7e, 0x63, 0xee, 0x5d, 0xc6, 0x41, 0x82, 0x5d, 0xee, 0x5d, 0xfe, 0x7f, 0xfe, 
-	0x41, 0xfe, 0x55, 0xee, 0x55, 0x82, 0x55, 0xc6, 0x55, 0xee, 0x7f, 0x7e, 0x80, 0x00
-};
-// 'warning', 11x11px
-const unsigned char bmp_warning [] PROGMEM = {
-	0xfb, 0xe0, 0xf1, 0xe0, 0xf5, 0xe0, 0xee, 0xe0, 0xea, 0xe0, 0xdb, 0x60, 0xdb, 0x60, 0xbf, 0xa0, 
-	0xbb, 0xa0, 0x7f, 0xc0, 0x00, 0x00
-};
-// 't_icon', 5x8px
-const unsigned char bmp_t_icon [] PROGMEM = {
-	0x90, 0x98, 0x90, 0x98, 0x90, 0x48, 0x08, 0x98
-};
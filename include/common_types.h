@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RTClib.h"
+#include <cmath>
 #include <cstdint>
 #include <sys/types.h>
 #include "settings.h"
@@ -10,7 +11,7 @@ enum DegreesUnit {
 };
 
 enum AlertLevel {
-    ALERT_NONE, ALERT_WARNING, ALERT_DANGER,
+    ALERT_NONE, ALERT_TRENDING, ALERT_WARNING, ALERT_DANGER,
 };
 
 template <typename T>
@@ -21,6 +22,48 @@ struct MeasurementStatistics {
     T min;
 };
 
+// Time-weighted spread and time spent outside the alert bands over a period, see PeriodMetrics.
+template <typename T>
+struct ExposureStatistics {
+    T mean;
+    T stddev;
+    T outOfBandPercent; // warning + danger
+    T dangerPercent;
+};
+
+// What the history chart shows, cycled by the button. COMPOSITE is every tier at its own
+// resolution (t-1Y..t-0), the others are the last 24h / 7d / 30d at a constant time per pixel.
+enum class HistoryRange : uint8_t {
+    COMPOSITE, LAST_24H, LAST_7D, LAST_30D,
+    COUNT,
+};
+
+inline uint32_t historyRangeSec(HistoryRange range) {
+    switch (range) {
+        case HistoryRange::LAST_24H: return HOUR_PER_DAY * MIN_PER_HOUR * SEC_PER_MIN;
+        case HistoryRange::LAST_7D: return 7 * HOUR_PER_DAY * MIN_PER_HOUR * SEC_PER_MIN;
+        case HistoryRange::LAST_30D: return DAY_PER_MONTH * HOUR_PER_DAY * MIN_PER_HOUR * SEC_PER_MIN;
+        default: return 0;
+    }
+}
+
+// seconds per chart pixel, 0 for the composite layout
+inline uint32_t historyRangePxSec(HistoryRange range) {
+    return historyRangeSec(range) / (CHART_LEN_PX);
+}
+
+// History chart values, newest first, read in place from the StatsCollector tiers instead of
+// being expanded into a float array. Indexing past the end yields NAN, as do gaps in the history.
+struct HistoryView {
+    void* source = nullptr;
+    float (*valueAt)(void* source, uint16_t index, uint32_t pxSec) = nullptr;
+    uint16_t length = 0;
+    HistoryRange range = HistoryRange::COMPOSITE;
+
+    inline uint16_t size() const { return length; }
+    inline float operator[](uint16_t index) const { return index < length ? valueAt(source, index, historyRangePxSec(range)) : NAN; }
+};
+
 struct DisplayRenderPayload {
     float chartYAxisLowTempCelsiusBound = 10.0;
     float chartYAxisHighTempCelsiusBound = 30.0;
@@ -33,19 +76,28 @@ struct DisplayRenderPayload {
     uint64_t sdCardOccupiedBytes = 0;
     DateTime timeinfo;
     float batteryLevel = 0.0;
+    uint32_t projectedRuntimeHours = 0; // 0 = unknown
 
     DegreesUnit degreesUnit = CELSIUS;
     float currentTemperatureCelsius = 0.0;
     float currentHumidity = 0.0;
     AlertLevel temperatureAlert = ALERT_NONE;
     AlertLevel humidityAlert = ALERT_NONE;
+    float temperatureTrendPerHour = NAN;
+    float humidityTrendPerHour = NAN;
     MeasurementStatistics<float> statsT1D;
     MeasurementStatistics<float> statsT1W;
     MeasurementStatistics<float> statsT1M;
     MeasurementStatistics<float> statsH1D;
     MeasurementStatistics<float> statsH1W;
     MeasurementStatistics<float> statsH1M;
+    ExposureStatistics<float> exposureT1D;
+    ExposureStatistics<float> exposureT1W;
+    ExposureStatistics<float> exposureT1M;
+    ExposureStatistics<float> exposureH1D;
+    ExposureStatistics<float> exposureH1W;
+    ExposureStatistics<float> exposureH1M;
 
-    float historyChartT[CHART_LEN_PX];
-    float historyChartH[CHART_LEN_PX];
+    HistoryView historyT;
+    HistoryView historyH;
 };
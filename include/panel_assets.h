@@ -0,0 +1,200 @@
+#pragma once
+
+// Generated by tools/panel_assets.py from img/*.png and the GFX fonts, do not edit.
+// Panel-native layout, see tools/panel_assets.py and PanelCanvas.
+
+#include "panel_canvas.h"
+#include "fnt_04b03b.h"
+#include "fnt_big_digits.h"
+
+// 'arrow_bold_dn', 7x8px
+const uint8_t nbmp_arrow_bold_dn_rows [] PROGMEM = {
+	0x07, 0x18, 0x27, 0xff, 0x3f, 0x1f, 0x07,
+};
+const NativeBitmap nbmp_arrow_bold_dn = { 7, 8, nbmp_arrow_bold_dn_rows };
+
+// 'arrow_bold_up', 7x8px
+const uint8_t nbmp_arrow_bold_up_rows [] PROGMEM = {
+	0xe0, 0x18, 0xe4, 0xff, 0xfc, 0xf8, 0xe0,
+};
+const NativeBitmap nbmp_arrow_bold_up = { 7, 8, nbmp_arrow_bold_up_rows };
+
+// 'arrow_thin_dn', 5x9px
+const uint8_t nbmp_arrow_thin_dn_rows [] PROGMEM = {
+	0x01, 0x80, 0x1e, 0x00, 0xe0, 0x00, 0x1e, 0x00, 0x01, 0x80,
+};
+const NativeBitmap nbmp_arrow_thin_dn = { 5, 9, nbmp_arrow_thin_dn_rows };
+
+// 'arrow_thin_up', 5x9px
+const uint8_t nbmp_arrow_thin_up_rows [] PROGMEM = {
+	0xc0, 0x00, 0x3c, 0x00, 0x03, 0x80, 0x3c, 0x00, 0xc0, 0x00,
+};
+const NativeBitmap nbmp_arrow_thin_up = { 5, 9, nbmp_arrow_thin_up_rows };
+
+// 'bat_full', 14x5px
+const uint8_t nbmp_bat_full_rows [] PROGMEM = {
+	0xf8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xe8, 0xf8, 0x70,
+};
+const NativeBitmap nbmp_bat_full = { 14, 5, nbmp_bat_full_rows };
+
+// 'danger', 9x11px
+const uint8_t nbmp_danger_rows [] PROGMEM = {
+	0x90, 0x00, 0xa3, 0xc0, 0xae, 0x60, 0xa6, 0x60, 0x4f, 0xe0, 0xa6, 0x60, 0xae, 0x60, 0xa3, 0xc0,
+	0x90, 0x00,
+};
+const NativeBitmap nbmp_danger = { 9, 11, nbmp_danger_rows };
+
+// 'gauge_h_bg', 101x16px
+const uint8_t nbmp_gauge_h_bg_rows [] PROGMEM = {
+	0xff, 0xff, 0xc0, 0x21, 0x80, 0x3b, 0xc0, 0x21, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xe0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x1f, 0xe0, 0x3f, 0x80, 0x1d, 0xc0, 0x37,
+	0x80, 0x1d, 0xc0, 0x37, 0x80, 0x15, 0xc0, 0x2b, 0x80, 0x15, 0xc0, 0x2b, 0x80, 0x15, 0xc0, 0x2b,
+	0x80, 0x09, 0xc0, 0x23, 0x80, 0x09, 0xc0, 0x23, 0x80, 0x09, 0xc0, 0x23, 0x80, 0x01, 0xc0, 0x01,
+	0x80, 0x01, 0xe0, 0x23, 0x80, 0x09, 0xc0, 0x23, 0x80, 0x09, 0xc0, 0x2b, 0x80, 0x15, 0xc0, 0x37,
+	0x80, 0x1d, 0xc0, 0x37, 0x80, 0x1d, 0xc0, 0x3f, 0x80, 0x1f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xe0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xe0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f,
+	0x80, 0x3f, 0xc0, 0x3f, 0x80, 0x3f, 0xc0, 0x3f, 0xff, 0xff,
+};
+const NativeBitmap nbmp_gauge_h_bg = { 101, 16, nbmp_gauge_h_bg_rows };
+
+// 'gauge_t_bg', 101x16px
+const uint8_t nbmp_gauge_t_bg_rows [] PROGMEM = {
+	0xff, 0xff, 0xf4, 0x07, 0x84, 0x01, 0xf4, 0x03, 0xfc, 0x01, 0xfc, 0x07, 0xfc, 0x01, 0xfc, 0x03,
+	0xfc, 0x01, 0xfc, 0x0f, 0xfc, 0x01, 0xfc, 0x03, 0xfc, 0x01, 0xfc, 0x07, 0xfc, 0x01, 0xfc, 0x03,
+	0xf8, 0x01, 0xec, 0x07, 0xb8, 0x01, 0xec, 0x03, 0xb8, 0x01, 0xec, 0x07, 0xb8, 0x01, 0xec, 0x03,
+	0xb8, 0x01, 0xec, 0x07, 0xb8, 0x01, 0xec, 0x03, 0xb8, 0x01, 0xd4, 0x07, 0xa8, 0x01, 0xd4, 0x03,
+	0xa8, 0x01, 0xd4, 0x07, 0xa8, 0x01, 0xd4, 0x03, 0xa8, 0x01, 0xd4, 0x07, 0xa8, 0x01, 0xd4, 0x03,
+	0xa8, 0x01, 0xc4, 0x07, 0x90, 0x01, 0xc4, 0x03, 0x90, 0x01, 0x80, 0x07, 0x80, 0x01, 0x80, 0x03,
+	0x80, 0x01, 0x80, 0x0f, 0x80, 0x01, 0xc4, 0x03, 0x90, 0x01, 0xc4, 0x07, 0x90, 0x01, 0xc4, 0x03,
+	0x90, 0x01, 0xd4, 0x07, 0xa8, 0x01, 0xd4, 0x03, 0xa8, 0x01, 0xd4, 0x07, 0xa8, 0x01, 0xd4, 0x03,
+	0xa8, 0x01, 0xb8, 0x07, 0xec, 0x01, 0xb8, 0x03, 0xec, 0x01, 0xb8, 0x07, 0xec, 0x01, 0xb8, 0x03,
+	0xec, 0x01, 0xb8, 0x07, 0xec, 0x01, 0xb8, 0x03, 0xec, 0x01, 0xb8, 0x07, 0xec, 0x01, 0xb8, 0x03,
+	0xec, 0x01, 0xf8, 0x07, 0xfc, 0x01, 0xfc, 0x03, 0xfc, 0x01, 0xfc, 0x07, 0xfc, 0x01, 0xfc, 0x03,
+	0xfc, 0x01, 0xfc, 0x0f, 0xfc, 0x01, 0xfc, 0x03, 0xfc, 0x01, 0xfc, 0x07, 0xfc, 0x01, 0xfc, 0x03,
+	0xfc, 0x01, 0xfc, 0x07, 0xfc, 0x01, 0xfc, 0x03, 0xff, 0xff,
+};
+const NativeBitmap nbmp_gauge_t_bg = { 101, 16, nbmp_gauge_t_bg_rows };
+
+// 'h_icon', 10x8px
+const uint8_t nbmp_h_icon_rows [] PROGMEM = {
+	0x70, 0xcc, 0xff, 0xfc, 0x70, 0x00, 0x90, 0x40, 0x20, 0x90,
+};
+const NativeBitmap nbmp_h_icon = { 10, 8, nbmp_h_icon_rows };
+
+// 'no_sd_card', 48x10px
+const uint8_t nbmp_no_sd_card_rows [] PROGMEM = {
+	0x7f, 0xc0, 0xc0, 0x40, 0xdf, 0x40, 0xc2, 0x40, 0xc4, 0x40, 0xdf, 0x40, 0xc0, 0x40, 0xdf, 0x40,
+	0xd1, 0x40, 0xd1, 0x40, 0xdf, 0x40, 0xc0, 0x40, 0xc0, 0x40, 0xc0, 0x40, 0xd7, 0x40, 0xd5, 0x40,
+	0xd5, 0x40, 0xdd, 0x40, 0xc0, 0x40, 0xdf, 0x40, 0xd1, 0x40, 0xd1, 0x40, 0xce, 0x40, 0xc0, 0x40,
+	0xc0, 0x40, 0xc0, 0x40, 0xdf, 0x40, 0xd1, 0x40, 0xd1, 0x40, 0xd1, 0x40, 0xc0, 0x40, 0xdf, 0x40,
+	0xc5, 0x40, 0xc5, 0x40, 0xdf, 0x40, 0xc0, 0x40, 0xdf, 0x40, 0xc5, 0x40, 0xdd, 0x40, 0xd7, 0x40,
+	0xc0, 0x40, 0xdf, 0x40, 0xd1, 0x40, 0xd1, 0x40, 0xce, 0x40, 0xc0, 0x40, 0xff, 0xc0, 0x7f, 0x80,
+};
+const NativeBitmap nbmp_no_sd_card = { 48, 10, nbmp_no_sd_card_rows };
+
+// 'sd_card_icon', 4x5px
+const uint8_t nbmp_sd_card_icon_rows [] PROGMEM = {
+	0xf8, 0xb8, 0xb8, 0xf0,
+};
+const NativeBitmap nbmp_sd_card_icon = { 4, 5, nbmp_sd_card_icon_rows };
+
+// 'stats_hint', 16x15px
+const uint8_t nbmp_stats_hint_rows [] PROGMEM = {
+	0x7f, 0xfc, 0x80, 0x02, 0xbe, 0xf2, 0x82, 0x2a, 0xbe, 0x2a, 0x82, 0x2a, 0xbe, 0xf2, 0x80, 0x02,
+	0xc0, 0x06, 0x88, 0x22, 0x98, 0x32, 0xbc, 0x7a, 0x98, 0x32, 0x88, 0x22, 0x80, 0x02, 0xff, 0xfc,
+};
+const NativeBitmap nbmp_stats_hint = { 16, 15, nbmp_stats_hint_rows };
+
+// 't_icon', 5x8px
+const uint8_t nbmp_t_icon_rows [] PROGMEM = {
+	0x60, 0xdf, 0xff, 0x60, 0x15,
+};
+const NativeBitmap nbmp_t_icon = { 5, 8, nbmp_t_icon_rows };
+
+// 'warning', 11x11px
+const uint8_t nbmp_warning_rows [] PROGMEM = {
+	0xc0, 0x00, 0xb0, 0x00, 0x8c, 0x00, 0x83, 0x00, 0x80, 0xc0, 0xae, 0x60, 0x80, 0xc0, 0x83, 0x00,
+	0x8c, 0x00, 0xb0, 0x00, 0xc0, 0x00,
+};
+const NativeBitmap nbmp_warning = { 11, 11, nbmp_warning_rows };
+
+// Font: Font_04b03b, 96 glyphs from 0x20
+const uint8_t Font_04b03b_NativeBitmaps [] PROGMEM = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xc0, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0xf8, 0x50, 0xf8, 0x50, 0x00, 0x00, 0x00,
+	0xb0, 0xe8, 0xb8, 0x68, 0x00, 0x00, 0x00, 0x00, 0x98, 0x58, 0x20, 0xd0, 0xc8, 0x00, 0x00, 0x00,
+	0xf8, 0xa8, 0xa8, 0xe0, 0x20, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x70, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xa0, 0x40, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xe0, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x00, 0x00,
+	0xf8, 0x88, 0x88, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x08, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe8, 0xa8, 0xa8, 0xb8, 0x00, 0x00, 0x00, 0x00, 0xa8, 0xa8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0x78, 0x40, 0x40, 0xf8, 0x00, 0x00, 0x00, 0x00, 0xb8, 0xa8, 0xa8, 0xe8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0xa8, 0xa8, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x08, 0xc8, 0x28, 0x18, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0xa8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x38, 0xa8, 0xa8, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x20, 0x50, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0xa0, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x88, 0x50, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xa8, 0x28, 0x38, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x88, 0xe8, 0xa8, 0x78, 0x00, 0x00, 0x00, 0xf8, 0x28, 0x28, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0xa8, 0xb8, 0xe0, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x88, 0x88, 0x88, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x88, 0x88, 0x70, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xa8, 0xa8, 0xa8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x28, 0x28, 0x28, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x88, 0xa8, 0xe8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x20, 0x20, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x88, 0xf8, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xc0, 0x80, 0x88, 0xf8, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x20, 0x20, 0xd8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0xf8, 0x08, 0xf8, 0x00, 0x00, 0x00,
+	0xf8, 0x10, 0x20, 0xf8, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x88, 0x88, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x48, 0x48, 0x78, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x88, 0xc8, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x28, 0xe8, 0xb8, 0x00, 0x00, 0x00, 0x00, 0xb8, 0xa8, 0xa8, 0xe8, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0xf8, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x80, 0x80, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0x78, 0x80, 0x60, 0x18, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x80, 0xf8, 0x80, 0xf8, 0x00, 0x00, 0x00,
+	0xd8, 0x20, 0x20, 0xd8, 0x00, 0x00, 0x00, 0x00, 0xb8, 0xa0, 0xa0, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0xc8, 0xa8, 0xa8, 0x98, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x88, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x80, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xa0, 0xa0, 0xe0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xa0, 0xa0, 0xe0, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xa0, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0xa0, 0xa0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x60, 0xa0, 0xe0, 0xa0, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0xf0, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x70, 0x50, 0xd0, 0x70, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0x20, 0x20, 0xe0, 0x00, 0x00, 0x00, 0x00, 0xd0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x40, 0x40, 0xa0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x20, 0xe0, 0x20, 0xe0, 0x00, 0x00, 0x00,
+	0xe0, 0x20, 0x20, 0xe0, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xa0, 0xa0, 0xe0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0x50, 0x50, 0x70, 0x00, 0x00, 0x00, 0x00, 0x70, 0x50, 0x50, 0xf0, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0xe0, 0xa0, 0xa0, 0x00, 0x00, 0x00, 0x00,
+	0x20, 0xf0, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x80, 0x80, 0xe0, 0x00, 0x00, 0x00, 0x00,
+	0x60, 0x80, 0x80, 0x60, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x80, 0xe0, 0x80, 0xe0, 0x00, 0x00, 0x00,
+	0xa0, 0x40, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x40, 0x40, 0xf0, 0x00, 0x00, 0x00, 0x00,
+	0xa0, 0xa0, 0xe0, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x20, 0xd8, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0xd8, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x80, 0x40, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+const uint16_t Font_04b03b_NativeOffsets [] PROGMEM = {
+	0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120, 128, 136, 144, 152, 160, 168, 176, 184, 192, 200, 208, 216, 224, 232, 240, 248, 256, 264, 272, 280, 288, 296, 304, 312, 320, 328, 336, 344, 352, 360, 368, 376, 384, 392, 400, 408, 416, 424, 432, 440, 448, 456, 464, 472, 480, 488, 496, 504, 512, 520, 528, 536, 544, 552, 560, 568, 576, 584, 592, 600, 608, 616, 624, 632, 640, 648, 656, 664, 672, 680, 688, 696, 704, 712, 720, 728, 736, 744, 752, 760
+};
+const NativeFont Font_04b03b_Native = { &Font_04b03b, Font_04b03b_NativeBitmaps, Font_04b03b_NativeOffsets };
+
+// Font: big_digits, 13 glyphs from 0x2D
+const uint8_t big_digits_NativeBitmaps [] PROGMEM = {
+	0x80, 0x80, 0x80, 0x80, 0xc0, 0xc0, 0xff, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xff, 0x80,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0x80, 0xf8, 0x80, 0x88, 0x80, 0x88, 0x80,
+	0x88, 0x80, 0x8f, 0x80, 0x88, 0x80, 0x88, 0x80, 0x88, 0x80, 0x88, 0x80, 0xff, 0x80, 0x0f, 0x80,
+	0x08, 0x00, 0x08, 0x00, 0x08, 0x00, 0xff, 0x80, 0x8f, 0x80, 0x88, 0x80, 0x88, 0x80, 0x88, 0x80,
+	0xf8, 0x80, 0xff, 0x80, 0x88, 0x80, 0x88, 0x80, 0x88, 0x80, 0xf8, 0x80, 0x00, 0x80, 0x00, 0x80,
+	0x00, 0x80, 0x00, 0x80, 0xff, 0x80, 0xff, 0x80, 0x88, 0x80, 0x88, 0x80, 0x88, 0x80, 0xff, 0x80,
+	0x8f, 0x80, 0x88, 0x80, 0x88, 0x80, 0x88, 0x80, 0xff, 0x80,
+};
+const uint16_t big_digits_NativeOffsets [] PROGMEM = {
+	0, 4, 6, 6, 16, 26, 36, 46, 56, 66, 76, 86, 96
+};
+const NativeFont big_digits_Native = { &big_digits, big_digits_NativeBitmaps, big_digits_NativeOffsets };
+
+const NativeFont* const nativeFonts[] = {
+	&Font_04b03b_Native,
+	&big_digits_Native,
+};
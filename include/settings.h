@@ -51,7 +51,10 @@
 
 // Settings
 #define WIFI_CONNECT_ATTEMPTS 20
-#define WIFI_CONNECT_ATTEMPT_INTERVAL_MS 250 // should be > 50
+#define WIFI_CONNECT_ATTEMPT_INTERVAL_MS 250 // full connect timeout = attempts * interval
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 1500 // cached BSSID/channel/IP, falls back to full connect after this
+#define WIFI_POLL_INTERVAL_MS 10
+#define NTP_SYNC_TIMEOUT_MS 3000
 #define NTP_SERVER_0 "pool.ntp.org"
 #define NTP_SERVER_1 "time.google.com"
 #define NTP_SERVER_2 "time.cloudflare.com"
@@ -61,12 +64,69 @@
 #define BLINK_LED false
 #define WAKEUP_INTERVAL_MS 12000 // energy drain <--> timekeeping accuracy tradeoff
 #define SENSOR_READ_INTERVAL_SEC 40 // 3read/2min
+#define ADAPTIVE_SENSOR_MAX_INTERVAL_SEC 320 // interval doubles per stable reading up to this, keep < 30min (day tier step)
+#define HISTORY_GAP_SEC 15*60 // readings further apart leave a gap in the history instead of stretching over it, keep > ADAPTIVE_SENSOR_MAX_INTERVAL_SEC
+#define ADAPTIVE_SENSOR_STABLE_DELTA_T 0.1 // readings closer than this to the one the interval last reset at count as stable
+#define ADAPTIVE_SENSOR_STABLE_DELTA_H 0.3
+#define SENSOR_RESOLUTION RH12_T14 // Si7021Resolution: RH12_T14, RH11_T11, RH10_T13, RH8_T12
+// Extra sensors, converted together with the Si7021 and fused (per-channel median) into one reading
+#define SENSOR_SHT3X_ADDRESS 0 // 0 = not fitted, 0x44 or 0x45
+#define SENSOR_SHT3X_BUS 0 // 0 = Wire (shared with the Si7021 and the RTC), 1 = Wire1 on I2C1_SDA_PIN/I2C1_SCL_PIN
+#define I2C1_SDA_PIN 25
+#define I2C1_SCL_PIN 26
+#define SENSOR_DHT_PIN -1 // -1 = not fitted
+#define SENSOR_DHT_TYPE DHT22
 #define N_UPDATES_BETWEEN_FULL_REPAINTS 20
+#define FAST_LUT_MAX_AREA_PX 64*40 // partial refreshes of up to this many panel pixels (~ the current readings) run the short custom waveform, larger ones the OTP one, 0 = never
+#define STATS_GRID_MEDIAN 0 // avg, median, max, min over the last 24h / 7d / 30d (sliding)
+#define STATS_GRID_EXPOSURE 1 // mean, std deviation, % of time out of the good band / in danger, for this day / week / month (tumbling, start over at each rollover)
+#define STATS_GRID_MODE STATS_GRID_MEDIAN
+
+#define TELEMETRY_URL "http://192.168.1.10:8080/telemetry" // local collector, see tools/telemetry_collector.py
+#define TELEMETRY_UPLOAD_INTERVAL_SEC 4*60*60 // one batch every 4h, or earlier when the buffer is full
+#define TELEMETRY_RETRY_INTERVAL_SEC 30*60
+#define TELEMETRY_BUFFER_BYTES 1024 // RTC memory, ~300 stable readings
+#define TELEMETRY_HTTP_TIMEOUT_MS 3000
 
 #define ALARM_INTERVAL_SEC 3*60*60+5 // 3h5s for small drift
 #define BUZZ_LENGTH_MS 100
 #define BUZZ_PITCH_HZ 4000 // ~3700-4000 resonance
 #define ALERT_BAT_LOW 0.15
+#define HUMIDITY_BANDS { 60.0, 62.0, 73.0, 75.0, 0.5 } // danger low, warning low, warning high, danger high, hysteresis
+#define TEMPERATURE_BANDS { 17.0, 19.0, 22.0, 24.0, 0.2 }
+#define TREND_ALERT_HORIZON_SEC 3*60*60 // raise "trending out of range" when the warning edge is this close
+#define TREND_MIN_POINTS 10 // hour tier entries (2min each) needed before trusting the trend
+// The values above (intervals, alert bands, Wi-Fi/NTP) are defaults, the runtime config in NVS
+// overrides them, see RuntimeConfig and tools/config_tool.py
+#define SLEEP_LIGHT_ENABLED true // light sleep through gaps shorter than the break-even, false = always deep sleep (for comparing the energy log)
+#define SLEEP_ROM_BOOT_US 40000 // ROM + bootloader part of a deep sleep wakeup, invisible to the firmware - measure with a scope
+#define SLEEP_COLD_WAKE_DEFAULT_US 150000 // until the first cold wakeup was measured
+#define CONFIG_SERIAL_WINDOW_MS 2000 // how long cold boot / button wakeup listens for config commands
+#define STATE_DUMP_LONG_PRESS_MS 1500 // holding the button this long on wakeup sends a state dump instead of switching the chart
+
+// Energy model, see EnergyMeter
+#define BATTERY_CAPACITY_MAH 2600 // 18650 cell
+#define CURRENT_AWAKE_MA 40.0f // CPU at 240MHz, peripherals idle
+#define CURRENT_SLEEP_UA 150.0f // whole board in deep sleep
+#define CURRENT_LIGHT_SLEEP_UA 800.0f // whole board in light sleep, RAM and peripherals kept
+#define CURRENT_RADIO_MA 100.0f // on top of awake
+#define CURRENT_PANEL_REFRESH_MA 4.0f // on top of awake, while the panel updates
+#define CURRENT_BUZZER_MA 20.0f
+#define CHARGE_SENSOR_CONVERSION_UC 3.5f // ~150uA for ~23ms
+#define ENERGY_PROJECTION_MIN_HOURS 1.0f // no runtime projection before this much data
+
+// Logging
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO // levels above this compile to nothing, override with -DLOG_LEVEL=...
+#endif
+#define LOG_BUFFER_WORDS 256 // 1kb of RTC memory, oldest records are dropped when full
+#define LOG_FLUSH_ON_CLICK true // dump the log over serial on button wakeup, errors always flush
+#define LOG_SERIAL_BAUD 115200
 
 
 // Computed
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "settings.h"
+#include "runtime_config.h"
+#include "stats_collector.h"
+
+/*
+ Widens the sensor read interval while readings stay flat and drops back to the base
+ interval on the first reading that moved more than the stability threshold (lid opened,
+ humidifier refilled, ...). The interval doubles per stable reading up to the maximum.
+
+ The change is measured from the reading the interval last reset at, not from the previous
+ one, so a slow drift that stays under the threshold per reading still resets it once it
+ adds up.
+*/
+template <typename compact_t>
+class AdaptiveSampler {
+public:
+  AdaptiveSampler(bool initial) {
+    if (initial) {
+      interval = SENSOR_READ_INTERVAL_SEC;
+      hasReference = false;
+    }
+  }
+
+  uint32_t intervalSec() const {
+    return interval;
+  }
+
+  void update(float temperature, float humidity) {
+    const compact_t t = pack<compact_t>(temperature);
+    const compact_t h = pack<compact_t>(humidity);
+    const bool stable = hasReference
+      && absDiff(t, referenceT) <= pack<compact_t>(ADAPTIVE_SENSOR_STABLE_DELTA_T)
+      && absDiff(h, referenceH) <= pack<compact_t>(ADAPTIVE_SENSOR_STABLE_DELTA_H);
+    if (stable) {
+      interval = std::min(interval * 2, (uint32_t)config.sensorMaxIntervalSec);
+      return;
+    }
+    interval = config.sensorReadIntervalSec;
+    referenceT = t;
+    referenceH = h;
+    hasReference = true;
+  }
+
+private:
+  uint32_t interval;
+  compact_t referenceT; // reading at the last reset
+  compact_t referenceH;
+  bool hasReference;
+
+  static inline compact_t absDiff(compact_t a, compact_t b) {
+    return a > b ? a - b : b - a;
+  }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cmath>
+#include "common_types.h"
+
+struct AlertBands {
+  float dangerLow;   // below: danger
+  float warningLow;  // below: warning
+  float warningHigh; // above: warning
+  float dangerHigh;  // above: danger
+  float hysteresis;  // how far back inside a band a value has to get to lower the alert level
+};
+
+inline AlertLevel bandLevel(float value, float dangerLow, float warningLow, float warningHigh, float dangerHigh) {
+  if (value >= warningLow && value <= warningHigh) return ALERT_NONE;
+  if (value >= dangerLow && value <= dangerHigh) return ALERT_WARNING;
+  return ALERT_DANGER;
+}
+
+/*
+ Alert level for `value` given the level raised last time. A worse level is raised at once,
+ a better one only when the value is `hysteresis` inside its band, so a reading hovering on
+ an edge does not flip the icon (and the repaint / buzzer that go with it) back and forth.
+
+ On top of that a value still inside the good band is flagged ALERT_TRENDING when the trend
+ (units per second) reaches the warning edge within `horizonSec`. The trending flag clears
+ only once the projected crossing is 1.5x the horizon away.
+*/
+inline AlertLevel calcAlert(float value, float slopePerSec, const AlertBands& bands, AlertLevel previous, float horizonSec) {
+  AlertLevel level = bandLevel(value, bands.dangerLow, bands.warningLow, bands.warningHigh, bands.dangerHigh);
+  if (level < previous) {
+    const float h = bands.hysteresis;
+    const AlertLevel settled = bandLevel(value, bands.dangerLow + h, bands.warningLow + h, bands.warningHigh - h, bands.dangerHigh - h);
+    level = settled < previous ? settled : previous;
+  }
+  if (level > ALERT_TRENDING || std::isnan(slopePerSec) || slopePerSec == 0) {
+    return level == ALERT_TRENDING ? ALERT_NONE : level;
+  }
+
+  const float distance = slopePerSec > 0 ? bands.warningHigh - value : value - bands.warningLow;
+  const float secondsToLeave = distance / fabsf(slopePerSec);
+  const float limit = previous == ALERT_TRENDING ? horizonSec * 1.5f : horizonSec;
+  return secondsToLeave <= limit ? ALERT_TRENDING : ALERT_NONE;
+}
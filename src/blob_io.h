@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "alerts.h"
+
+// Little endian field writer/reader shared by the binary formats (runtime config, state dump).
+
+// Writes past `capacity` are dropped but still counted, check overflow() once at the end.
+class BlobWriter {
+public:
+  BlobWriter(uint8_t* data, size_t capacity) : data(data), capacity(capacity) {}
+
+  void u8(uint8_t value) {
+    if (pos < capacity) data[pos] = value;
+    ++pos;
+  }
+
+  void u16(uint16_t value) {
+    u8(value);
+    u8(value >> 8);
+  }
+
+  void u32(uint32_t value) {
+    u16(value);
+    u16(value >> 16);
+  }
+
+  void f32(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    u32(bits);
+  }
+
+  void bands(const AlertBands& bands) {
+    f32(bands.dangerLow);
+    f32(bands.warningLow);
+    f32(bands.warningHigh);
+    f32(bands.dangerHigh);
+    f32(bands.hysteresis);
+  }
+
+  void str(const char* value) {
+    const size_t len = strlen(value);
+    u8(len);
+    for (size_t i = 0; i < len; ++i) u8(value[i]);
+  }
+
+  size_t size() const { return pos; }
+  bool overflow() const { return pos > capacity; }
+  uint8_t* at(size_t offset) { return data + offset; }
+
+private:
+  uint8_t* data;
+  size_t capacity;
+  size_t pos = 0;
+};
+
+// Reads past the end return zeros and set the overflow flag, checked once at the end.
+class BlobReader {
+public:
+  BlobReader(const uint8_t* data, size_t len) : data(data), len(len) {}
+
+  uint8_t u8() {
+    if (pos >= len) {
+      overflow = true;
+      return 0;
+    }
+    return data[pos++];
+  }
+
+  uint16_t u16() {
+    const uint16_t lo = u8();
+    return lo | (u8() << 8);
+  }
+
+  uint32_t u32() {
+    const uint32_t lo = u16();
+    return lo | ((uint32_t)u16() << 16);
+  }
+
+  float f32() {
+    const uint32_t bits = u32();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  AlertBands bands() {
+    AlertBands bands;
+    bands.dangerLow = f32();
+    bands.warningLow = f32();
+    bands.warningHigh = f32();
+    bands.dangerHigh = f32();
+    bands.hysteresis = f32();
+    return bands;
+  }
+
+  // False when the string does not fit into `capacity` including the terminator.
+  bool str(char* out, size_t capacity) {
+    const uint8_t n = u8();
+    if (n >= capacity) return false;
+    for (uint8_t i = 0; i < n; ++i) out[i] = u8();
+    out[n] = '\0';
+    return true;
+  }
+
+  bool overflow = false;
+
+private:
+  const uint8_t* data;
+  size_t len;
+  size_t pos = 0;
+};
+
+// zlib compatible CRC32, bitwise - the blobs are small and this keeps the table out of flash
+inline uint32_t blobCrc32(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
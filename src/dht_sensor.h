@@ -0,0 +1,38 @@
+#pragma once
+
+#include <DHT.h>
+#include <cmath>
+#include "humidity_sensor.h"
+
+/*
+ DHT11/DHT22 behind the HumiditySensor interface. These have no conversion to start: the
+ sensor measures when the host sends the start pulse and answers within ~5ms over its
+ one-wire line, bit-banged with interrupts off. So startConversion() does nothing and the
+ whole read happens in readConversion(), the registry polls it along with the I2C sensors.
+ The library refuses to read more often than every 2s and returns the cached values then.
+*/
+class DhtSensor : public HumiditySensor {
+public:
+  DhtSensor(uint8_t pin, uint8_t type) : dht(pin, type) {}
+
+  bool begin() override {
+    dht.begin();
+    return true;
+  }
+
+  bool startConversion() override { return true; }
+
+  uint32_t conversionTimeUs() const override { return 0; }
+
+  bool readConversion(float* temperature, float* humidity) override {
+    const float t = dht.readTemperature();
+    const float h = dht.readHumidity();
+    if (std::isnan(t) || std::isnan(h)) return false;
+    *temperature = t;
+    *humidity = h;
+    return true;
+  }
+
+private:
+  DHT dht;
+};
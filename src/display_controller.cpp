@@ -1,38 +1,77 @@
 #include "Arduino.h"
 #include "common_types.h"
 #include "display_controller.h"
+#include "repaint_plan.h"
+#include "log.h"
+#include "energy_meter.h"
+#include "peripherals.h"
 #include "esp32-hal.h"
 #include "settings.h"
 #include <cmath>
 
 static const char y04b = Font_04b03b.yAdvance / 2 + 1;
 
-DisplayController::DisplayController(bool initial) : display(GxEPD2_213_B74(5, 17, 16, 4)) {
-    display.init(0, initial);
-    display.setRotation(1);
-    display.setFullWindow();
-    display.setTextColor(GxEPD_BLACK);
-    display.setTextWrap(false);
+DisplayController::DisplayController(bool initial)
+: epd(5, 17, 16, 4), display(nativeFonts, sizeof(nativeFonts) / sizeof(nativeFonts[0])) {
+    if (initial) {
+        powerOnInit = true;
+    }
 }
 
-void DisplayController::debug_print(char* txt) {
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        unsigned long timestamp = micros();
-        display.fillScreen(GxEPD_WHITE);
+void DisplayController::wake() {
+    peripherals.need(Peripherals::PANEL, [this] {
+        epd.init(0, powerOnInit);
+        powerOnInit = false;
+        display.setTextColor(GxEPD_BLACK);
+        display.setTextWrap(false);
+        return true;
+    });
+}
 
-        display.setFont(&Font_04b03b);
-        display.setCursor(0, y04b);
-        display.print(txt);
+void DisplayController::prepare() {
+    wake();
+}
 
-        // display draw time
-        display.setFont(&Font_04b03b);
-        display.setCursor(0, display.height());
-        display.print(micros() - timestamp);
-    } while (display.nextPage());
+void DisplayController::flush(bool full, const DrawFlags drawFlags) {
+    const uint8_t* buffer = display.buffer();
+    if (full) {
+        const int16_t width = PanelCanvas::NATIVE_WIDTH, height = PanelCanvas::NATIVE_HEIGHT;
+        const unsigned long timestampRefresh = micros();
+        epd.writeImage(buffer, 0, 0, width, height);
+        epd.refresh(false);
+        epd.writeImageAgain(buffer, 0, 0, width, height);
+        energyMeter.addRefresh(true, micros() - timestampRefresh);
+        return;
+    }
+    DirtyArea areas[DIRTY_AREAS_MAX];
+    RefreshWindow windows[DIRTY_AREAS_MAX];
+    const uint8_t count = planRefreshWindows(areas, dirtyAreasFor(drawFlags, areas), windows);
+    flushWindows(epd, buffer, windows, count, [](const RefreshWindow& window, uint32_t us) {
+        if (window.fast) {
+            LOG_DEBUG(REPAINT_FAST_LUT, (uint32_t) window.w * window.h);
+            energyMeter.addFastRefresh(us);
+        } else {
+            energyMeter.addRefresh(false, us);
+        }
+    });
+}
 
-    display.hibernate();
+void DisplayController::debug_print(const char* txt) {
+    wake();
+    unsigned long timestamp = micros();
+    display.fillScreen(GxEPD_WHITE);
+
+    display.setFont(&Font_04b03b);
+    display.setCursor(0, y04b);
+    display.print(txt);
+
+    // display draw time
+    display.setFont(&Font_04b03b);
+    display.setCursor(0, display.height());
+    display.print(micros() - timestamp);
+
+    flush(true, DrawFlags::FULL);
+    epd.hibernate();
 }
 
 void DisplayController::repaint(const DrawFlags drawFlags, DisplayRenderPayload* data) {
@@ -41,57 +80,29 @@ void DisplayController::repaint(const DrawFlags drawFlags, DisplayRenderPayload*
     int16_t tbx, tby; uint16_t tbw, tbh;
     char buf[5];
 
+    wake();
     unsigned long timestampFullRepaint = micros();
 
     if (isFlagSet(drawFlags, DrawFlags::FULL)) repaintCounter = 0;
     bool fullRepaint = repaintCounter++ % N_UPDATES_BETWEEN_FULL_REPAINTS == 0 || isFlagSet(drawFlags, DrawFlags::FULL);
-    Serial.print("Doing repaint, full = ");
-    Serial.println(fullRepaint);
-    if (fullRepaint) {
-        display.setFullWindow();
-    } else {
-        struct Rect { 
-            uint8_t x, y, w, h; 
-            inline Rect operator+=(const Rect other) {
-                return Rect {
-                    x = min(this->x, other.x),
-                    y = min(this->y, other.y),
-                    w = max(this->x + this->w, other.x + other.w) - min(this->x, other.x),
-                    h = max(this->y + this->h, other.y + other.h) - min(this->y, other.y),
-                };
-            }
-        };
-        // 0  11  140  56
-        Rect drawArea = Rect { .x=255, .y=255, .w=0, .h=0 };
-        if (isFlagSet(drawFlags, DrawFlags::SD_CARD)) drawArea += Rect { .x=67, .y=0, .w=72, .h=5 }; // (0, 0, 256, 5)
-        if (isFlagSet(drawFlags, DrawFlags::BATTERY)) drawArea += Rect { .x=0, .y=0, .w=36, .h=5 }; // (0, 0, 256, 5)
-        if (isFlagSet(drawFlags, DrawFlags::TIME)) drawArea += Rect { .x=170, .y=0, .w=78, .h=5 }; // (0, 0, 256, 5)
-        if (isFlagSet(drawFlags, DrawFlags::GAUGES)) drawArea += Rect { .x=0, .y=13, .w=105, .h=51 }; // (0, 13, 105, 51)
-        if (isFlagSet(drawFlags, DrawFlags::CURRENT_READINGS)) drawArea += Rect { .x=106, .y=11, .w=34, .h=56 }; // (106, 11, 34, 56)
-        if (isFlagSet(drawFlags, DrawFlags::STATISTICS)) drawArea += Rect { .x=143, .y=13, .w=107, .h=43 }; // (143, 13, 107, 43)
-        if (isFlagSet(drawFlags, DrawFlags::HISTORY_GRAPH)) drawArea += Rect { .x=0, .y=64, .w=255, .h=58 }; // (0, 64, 250, 58)
-        display.setPartialWindow(drawArea.x, drawArea.y, drawArea.w, drawArea.h);
-    }
+    LOG_DEBUG(REPAINT_MODE, fullRepaint);
+    // the whole layout is drawn every time, a partial refresh only sends the dirty areas
+    display.fillScreen(GxEPD_WHITE);
+    drawStatusBar(data);
+    drawGauges(
+        data->degreesUnit,
+        data->gaugeTempCelsiusCenter,
+        data->gaugeHumidityCenter, 
+        currentTemp, 
+        data->currentHumidity
+    );
+    drawCurrentReadings(data, currentTemp, unitSymbol);
+    drawAllStats(data);
+    drawHistoryGraph(data, unitSymbol);
+    flush(fullRepaint, drawFlags);
+    epd.hibernate();
 
-    display.firstPage();
-    do {
-        drawStatusBar(data);
-        drawGauges(
-            data->degreesUnit,
-            data->gaugeTempCelsiusCenter,
-            data->gaugeHumidityCenter, 
-            currentTemp, 
-            data->currentHumidity
-        );
-        drawCurrentReadings(data, currentTemp, unitSymbol);
-        drawAllStats(data);
-        drawHistoryGraph(data, unitSymbol);
-    } while (display.nextPage());
-    display.hibernate();
-
-    Serial.print("Repaint full time: ");
-    Serial.print((micros() - timestampFullRepaint) / 1000.0f, 1);
-    Serial.println("ms");
+    LOG_INFO(REPAINT_TIME, micros() - timestampFullRepaint);
 }
 
 void DisplayController::drawGauges(
@@ -131,15 +142,15 @@ void DisplayController::drawGauges(
         display.print(buf);
     }
     // gauges
-    display.drawInvertedBitmap(2, 19, bmp_gauge_t_bg, 101, 16, GxEPD_BLACK);
-    display.drawInvertedBitmap(2, 37, bmp_gauge_h_bg, 101, 16, GxEPD_BLACK);
+    display.drawNative(nbmp_gauge_t_bg, 2, 19, GxEPD_BLACK);
+    display.drawNative(nbmp_gauge_h_bg, 2, 37, GxEPD_BLACK);
     // gauges - arrows
     // gauges - arrows - temperature
     display.fillRect(tempArrX, 20, 5, 9, GxEPD_WHITE);
-    display.drawInvertedBitmap(tempArrX, 20, bmp_arrow_thin_dn, 5, 9, GxEPD_BLACK);
+    display.drawNative(nbmp_arrow_thin_dn, tempArrX, 20, GxEPD_BLACK);
     // gauges - arrows - humidity
     display.fillRect(humArrX, 43, 5, 9, GxEPD_WHITE);
-    display.drawInvertedBitmap(humArrX, 43, bmp_arrow_thin_up, 5, 9, GxEPD_BLACK);
+    display.drawNative(nbmp_arrow_thin_up, humArrX, 43, GxEPD_BLACK);
     // gauges - arrows - patch overlaps
     display.fillRect(0, 19, 2, 16, GxEPD_WHITE); display.drawFastVLine(2, 19, 16, GxEPD_BLACK);
     display.fillRect(0, 37, 2, 16, GxEPD_WHITE); display.drawFastVLine(2, 37, 16, GxEPD_BLACK);
@@ -153,7 +164,7 @@ void DisplayController::drawStatusBar(DisplayRenderPayload* data) {
     display.setFont(&Font_04b03b);
     // sd card
     // sd card - icon
-    display.drawInvertedBitmap(67, 0, bmp_sd_card_icon, 4, 5, GxEPD_BLACK);
+    display.drawNative(nbmp_sd_card_icon, 67, 0, GxEPD_BLACK);
     // sd card - label
     if (data->sdCardVolumeBytes > 0) {
         formatSize(data->sdCardOccupiedBytes, occupiedBuf, sizeof(occupiedBuf));
@@ -176,7 +187,7 @@ void DisplayController::drawStatusBar(DisplayRenderPayload* data) {
     // battery - picture
     const uint8_t batX = 0;
     const uint8_t batY = 0;
-    display.drawInvertedBitmap(batX, batY, bmp_bat_full, 14, 5, GxEPD_BLACK);
+    display.drawNative(nbmp_bat_full, batX, batY, GxEPD_BLACK);
     int8_t bat_pixels_empty = (1.0 - data->batteryLevel) * 11;
     display.fillRect(batX+12-bat_pixels_empty, batY+1, bat_pixels_empty, 3, GxEPD_WHITE);
     if (bat_pixels_empty > 0) display.drawPixel(batX-1-bat_pixels_empty, batY+1, GxEPD_BLACK);
@@ -184,6 +195,16 @@ void DisplayController::drawStatusBar(DisplayRenderPayload* data) {
     display.setCursor(batX+16, batY+y04b);
     snprintf(buf, sizeof(buf), "%.0f%%", data->batteryLevel * (float)100);
     display.print(buf);
+    // battery - projected runtime
+    if (data->projectedRuntimeHours > 0) {
+        if (data->projectedRuntimeHours < 48) {
+            snprintf(buf, sizeof(buf), "~%luh", (unsigned long)data->projectedRuntimeHours);
+        } else {
+            snprintf(buf, sizeof(buf), "~%lud", (unsigned long)(data->projectedRuntimeHours / HOUR_PER_DAY));
+        }
+        display.setCursor(batX+36, batY+y04b);
+        display.print(buf);
+    }
 }
 
 void DisplayController::drawAllStats(DisplayRenderPayload* data) {
@@ -191,12 +212,14 @@ void DisplayController::drawAllStats(DisplayRenderPayload* data) {
     const uint8_t statX = 143, statY = 13;
     auto tempConversion = [&data](float input) -> float { return celsiusTo(input, data->degreesUnit); };
     auto humConversion = [](float input) -> float { return input; };
+    // a spread only scales, no offset
+    auto tempSpreadConversion = [&data](float input) -> float { return celsiusTo(input, data->degreesUnit) - celsiusTo(0, data->degreesUnit); };
     unsigned long timestamp = micros();
 
     // statistics
     display.drawRect(statX+3, statY+4, 104, 39, GxEPD_BLACK);
     display.fillRect(statX, statY, 16, 15, GxEPD_WHITE);
-    display.drawInvertedBitmap(statX, statY, bmp_stats_hint, 16, 15, GxEPD_BLACK);
+    display.drawNative(nbmp_stats_hint, statX, statY, GxEPD_BLACK);
     // statistics - grid lines
     display.drawFastHLine(statX+16, statY+14, 90, GxEPD_BLACK);
     display.drawFastHLine(statX+4, statY+28, 102, GxEPD_BLACK);
@@ -215,6 +238,26 @@ void DisplayController::drawAllStats(DisplayRenderPayload* data) {
     display.print(data->degreesUnit == CELSIUS ? 'C' : 'F');
     display.setCursor(statX+5, statY+33 + y04b);
     display.print(F("H"));
+#if STATS_GRID_MODE == STATS_GRID_EXPOSURE
+    // Tumbling periods (TumblingMetrics): the running day, week and month start over empty at
+    // each rollover. The median grid below shows sliding 24h / 7d / 30d windows instead, hence
+    // the different labels.
+    display.setCursor(statX+20, statY+7 + y04b);
+    display.print(F("day"));
+    display.setCursor(statX+54, statY+7 + y04b);
+    display.print(F("wk"));
+    display.setCursor(statX+86, statY+7 + y04b);
+    display.print(F("mo"));
+
+    display.setFont(&TomThumb);
+    drawExposure(statX+11+32*0, statY+15+14*0, data->exposureT1D, tempConversion, tempSpreadConversion);
+    drawExposure(statX+11+32*1, statY+15+14*0, data->exposureT1W, tempConversion, tempSpreadConversion);
+    drawExposure(statX+11+32*2, statY+15+14*0, data->exposureT1M, tempConversion, tempSpreadConversion);
+    drawExposure(statX+11+32*0, statY+15+14*1, data->exposureH1D, humConversion, humConversion);
+    drawExposure(statX+11+32*1, statY+15+14*1, data->exposureH1W, humConversion, humConversion);
+    drawExposure(statX+11+32*2, statY+15+14*1, data->exposureH1M, humConversion, humConversion);
+#else
+    // sliding windows over the history tiers, always a full 24h / 7d / 30d once filled
     display.setCursor(statX+22, statY+7 + y04b);
     display.print(F("24h"));
     display.setCursor(statX+54, statY+7 + y04b);
@@ -230,8 +273,8 @@ void DisplayController::drawAllStats(DisplayRenderPayload* data) {
     drawStats(statX+11+32*0, statY+15+14*1, data->statsH1D, humConversion);
     drawStats(statX+11+32*1, statY+15+14*1, data->statsH1W, humConversion);
     drawStats(statX+11+32*2, statY+15+14*1, data->statsH1M, humConversion);
-    Serial.print("Repaint - all stats: ");
-    Serial.println(micros() - timestamp);
+#endif
+    LOG_DEBUG(REPAINT_STATS_TIME, micros() - timestamp);
 }
 
 template<typename StatsConversion>
@@ -250,6 +293,26 @@ void DisplayController::drawStats(unsigned char x, unsigned char y, MeasurementS
     display.print(conversion(stats.min), 1);
 }
 
+// mean / std deviation on the left, % of the time out of the good band / in danger on the right
+template<typename StatsConversion, typename SpreadConversion>
+void DisplayController::drawExposure(unsigned char x, unsigned char y, ExposureStatistics<float> stats, StatsConversion conversion, SpreadConversion spreadConversion) {
+    if (std::isnan(stats.mean)) return;
+    const uint8_t adv = TomThumb.yAdvance;
+    display.setCursor(x + 1, y + adv);
+    display.print(conversion(stats.mean), 1);
+
+    display.setCursor(x + 1, y + adv + 6);
+    display.print(spreadConversion(stats.stddev), 1);
+
+    display.setCursor(x + 17, y + adv);
+    display.print((int) roundf(stats.outOfBandPercent));
+    display.print('%');
+
+    display.setCursor(x + 17, y + adv + 6);
+    display.print((int) roundf(stats.dangerPercent));
+    display.print('%');
+}
+
 void DisplayController::drawCurrentReadings(DisplayRenderPayload* data, const float currentTemp, const char unitSymbol) {
     int16_t tbx, tby; uint16_t tbw, tbh;
     char buf[5];
@@ -274,10 +337,13 @@ void DisplayController::drawCurrentReadings(DisplayRenderPayload* data, const fl
     // alerts
     switch (data->temperatureAlert) {
         case ALERT_DANGER:
-            display.drawInvertedBitmap(118, 11, bmp_danger, 9, 11, GxEPD_BLACK);
+            display.drawNative(nbmp_danger, 118, 11, GxEPD_BLACK);
             break;
         case ALERT_WARNING:
-            display.drawInvertedBitmap(117, 11, bmp_warning, 11, 11, GxEPD_BLACK);
+            display.drawNative(nbmp_warning, 117, 11, GxEPD_BLACK);
+            break;
+        case ALERT_TRENDING:
+            display.drawNative(data->temperatureTrendPerHour > 0 ? nbmp_arrow_bold_up : nbmp_arrow_bold_dn, 119, 13, GxEPD_BLACK);
             break;
         case ALERT_NONE:
         default:
@@ -285,10 +351,13 @@ void DisplayController::drawCurrentReadings(DisplayRenderPayload* data, const fl
     };
     switch (data->humidityAlert) {
         case ALERT_DANGER:
-            display.drawInvertedBitmap(118, 50, bmp_danger, 9, 11, GxEPD_BLACK);
+            display.drawNative(nbmp_danger, 118, 50, GxEPD_BLACK);
             break;
         case ALERT_WARNING:
-            display.drawInvertedBitmap(117, 50, bmp_warning, 11, 11, GxEPD_BLACK);
+            display.drawNative(nbmp_warning, 117, 50, GxEPD_BLACK);
+            break;
+        case ALERT_TRENDING:
+            display.drawNative(data->humidityTrendPerHour > 0 ? nbmp_arrow_bold_up : nbmp_arrow_bold_dn, 119, 52, GxEPD_BLACK);
             break;
         case ALERT_NONE:
         default:
@@ -302,7 +371,29 @@ void DisplayController::drawHistoryGraph(DisplayRenderPayload* data, const char
     unsigned long timestamp = micros();
     // graph - lines
     const unsigned char graph_stops_count = 6;
-    const unsigned char graph_stops[graph_stops_count] = {3, 51, 120, 156, 202, 232};
+    unsigned char graph_stops[graph_stops_count] = {3, 51, 120, 156, 202, 232};
+    const char* graph_stop_labels[graph_stops_count] = {"t-1Y", "t-1m", "t-1w", "t-1d", "t-1h", "t-0"};
+    const HistoryRange range = data->historyT.range;
+    if (range != HistoryRange::COMPOSITE) {
+        // constant time per pixel, stops sit at fixed ages (hours)
+        static const uint16_t stopHours[(uint8_t) HistoryRange::COUNT][graph_stops_count] = {
+            {},
+            {24, 18, 12, 6, 3, 0},
+            {168, 120, 72, 48, 24, 0},
+            {720, 504, 336, 168, 72, 0},
+        };
+        static const char* stopLabels[(uint8_t) HistoryRange::COUNT][graph_stops_count] = {
+            {},
+            {"t-1d", "t-18h", "t-12h", "t-6h", "t-3h", "t-0"},
+            {"t-1w", "t-5d", "t-3d", "t-2d", "t-1d", "t-0"},
+            {"t-1m", "t-3w", "t-2w", "t-1w", "t-3d", "t-0"},
+        };
+        const uint32_t pxSec = historyRangePxSec(range);
+        for (unsigned char i = 0; i < graph_stops_count; ++i) {
+            graph_stops[i] = CHART_LEN_PX + 3 - stopHours[(uint8_t) range][i] * MIN_PER_HOUR * SEC_PER_MIN / pxSec;
+            graph_stop_labels[i] = stopLabels[(uint8_t) range][i];
+        }
+    }
     // graph - lines - horizontal
     display.drawFastHLine(0, 87, 250, GxEPD_BLACK);
     display.drawFastHLine(0, 115, 250, GxEPD_BLACK);
@@ -333,15 +424,14 @@ void DisplayController::drawHistoryGraph(DisplayRenderPayload* data, const char
         }
     }
     // graph - icons
-    display.drawInvertedBitmap(237, 73, bmp_t_icon, 5, 8, GxEPD_BLACK);
+    display.drawNative(nbmp_t_icon, 237, 73, GxEPD_BLACK);
     display.setFont(&Font_04b03b);
     display.setCursor(243, 81);
     display.print(unitSymbol);
     display.drawCircle(244, 73, 1, GxEPD_BLACK);
-    display.drawInvertedBitmap(237, 101, bmp_h_icon, 10, 8, GxEPD_BLACK);
+    display.drawNative(nbmp_h_icon, 237, 101, GxEPD_BLACK);
     // graph - labels
     display.setFont(&Font_04b03b);
-    const char* graph_stop_labels[graph_stops_count] = {"t-1Y", "t-1m", "t-1w", "t-1d", "t-1h", "t-0"};
     for (unsigned char i = 0; i < graph_stops_count; ++i) {
         display.setCursor(graph_stops[i] - 3 - i*1.5, 117 + y04b);
         display.print(graph_stop_labels[i]);
@@ -372,17 +462,25 @@ void DisplayController::drawHistoryGraph(DisplayRenderPayload* data, const char
     display.setCursor(236, 118);
     display.print(buf);
     // graph - values
-    for (uint8_t i = 0; i < CHART_LEN_PX && !isnan(data->historyChartT[i]); i++) {
+    const uint16_t historyLen = data->historyT.size();
+    for (uint8_t i = 0; i < historyLen; i++) {
+        // gap in the history (device was off) - no bars, dotted base lines
+        if (std::isnan(data->historyT[i])) {
+            if (i % 2 == 0) {
+                display.drawPixel(CHART_LEN_PX - i + 3, 87, GxEPD_WHITE);
+                display.drawPixel(CHART_LEN_PX - i + 3, 115, GxEPD_WHITE);
+            }
+            continue;
+        }
         // temperature
-        uint8_t val = 20 * (data->historyChartT[i] - data->chartYAxisLowTempCelsiusBound) / (data->chartYAxisHighTempCelsiusBound - data->chartYAxisLowTempCelsiusBound);
+        uint8_t val = 20 * (data->historyT[i] - data->chartYAxisLowTempCelsiusBound) / (data->chartYAxisHighTempCelsiusBound - data->chartYAxisLowTempCelsiusBound);
         val = constrain(val, 0, 20);
         display.drawFastVLine(CHART_LEN_PX - i + 3, 87 - val, val, GxEPD_BLACK);
 
         // humidity
-        val = 20 * (data->historyChartH[i] - data->chartYAxisLowHumidityBound) / (data->chartYAxisHighHumidityBound - data->chartYAxisLowHumidityBound);
+        val = 20 * (data->historyH[i] - data->chartYAxisLowHumidityBound) / (data->chartYAxisHighHumidityBound - data->chartYAxisLowHumidityBound);
         val = constrain(val, 0, 20);
         display.drawFastVLine(CHART_LEN_PX - i + 3, 115 - val, val, GxEPD_BLACK);
     }
-    Serial.print("Repaint - graph values: ");
-    Serial.println(micros() - timestamp);
+    LOG_DEBUG(REPAINT_GRAPH_TIME, micros() - timestamp);
 }
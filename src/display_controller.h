@@ -7,7 +7,9 @@
 #include "time.h"
 #include "common_types.h"
 #include "utils.h"
-#include "bitmaps.h"
+#include "fast_lut_panel.h"
+#include "panel_canvas.h"
+#include "panel_assets.h"
 
 #include "fnt_04b03b.h"
 #include "tiniest_num42.h"
@@ -29,13 +31,25 @@ public:
   };
 
   DisplayController(bool initial);
-  void debug_print(char* txt);
+  // Brings the panel up ahead of the first draw, called from the render task.
+  void prepare();
+  void debug_print(const char* txt);
   void repaint(const DrawFlags drawFlags, DisplayRenderPayload* data);
 
 private:
-  GxEPD2_BW<GxEPD2_213_B74, GxEPD2_213_B74::HEIGHT> display;
+  FastLutPanel epd;
+  PanelCanvas display; // drawn into, then written to the panel RAM as is
 
   uint32_t repaintCounter;
+  bool powerOnInit; // the first init after power-up has to assume nothing about the panel state
+
+  // SPI + panel init, on the first draw of the wakeup only
+  void wake();
+
+  // Writes the canvas to both panel RAMs around the refresh, the same sequence GxEPD2_BW runs
+  // for a single page buffer: all of it, or the windows planRefreshWindows() lays over the areas
+  // of `drawFlags` (repaint_plan.h). Books each refresh with the energy meter.
+  void flush(bool full, const DrawFlags drawFlags);
 
   void drawBackground(DisplayRenderPayload* data);
 
@@ -50,6 +64,9 @@ private:
   template<typename StatsConversion>
   void drawStats(unsigned char x, unsigned char y, MeasurementStatistics<float> stats, StatsConversion conversion);
 
+  template<typename StatsConversion, typename SpreadConversion>
+  void drawExposure(unsigned char x, unsigned char y, ExposureStatistics<float> stats, StatsConversion conversion, SpreadConversion spreadConversion);
+
   void drawHistoryGraph(DisplayRenderPayload* data, const char unitSymbol);
 };
 
@@ -0,0 +1,56 @@
+#include "energy_meter.h"
+#include "log.h"
+
+#define US_PER_HOUR 3600000000.0f
+
+void EnergyMeter::reset() {
+  awakeUs = 0;
+  sleepUs = 0;
+  lightSleepUs = 0;
+  radioOnUs = 0;
+  fullRefreshUs = 0;
+  partialRefreshUs = 0;
+  fastRefreshUs = 0;
+  fullRefreshCount = 0;
+  partialRefreshCount = 0;
+  fastRefreshCount = 0;
+  buzzerOnMs = 0;
+  sensorConversions = 0;
+  lightSleepCount = 0;
+}
+
+float EnergyMeter::consumedMah() const {
+  // radio, panel and buzzer currents come on top of the awake baseline
+  float mah = awakeUs * CURRENT_AWAKE_MA / US_PER_HOUR;
+  mah += sleepUs * (CURRENT_SLEEP_UA / 1000.0f) / US_PER_HOUR;
+  mah += lightSleepUs * (CURRENT_LIGHT_SLEEP_UA / 1000.0f) / US_PER_HOUR;
+  mah += radioOnUs * CURRENT_RADIO_MA / US_PER_HOUR;
+  mah += (fullRefreshUs + partialRefreshUs + fastRefreshUs) * CURRENT_PANEL_REFRESH_MA / US_PER_HOUR;
+  mah += buzzerOnMs * 1000.0f * CURRENT_BUZZER_MA / US_PER_HOUR;
+  mah += sensorConversions * CHARGE_SENSOR_CONVERSION_UC / 3600000.0f; // uC -> mAh
+  return mah;
+}
+
+float EnergyMeter::averageMa() const {
+  const float elapsedHours = (awakeUs + sleepUs + lightSleepUs) / US_PER_HOUR;
+  return elapsedHours > 0 ? consumedMah() / elapsedHours : 0;
+}
+
+uint32_t EnergyMeter::projectedRuntimeHours(float batteryLevel) const {
+  const float elapsedHours = (awakeUs + sleepUs + lightSleepUs) / US_PER_HOUR;
+  const float average = averageMa();
+  if (elapsedHours < ENERGY_PROJECTION_MIN_HOURS || average <= 0) return 0;
+  return batteryLevel * BATTERY_CAPACITY_MAH / average;
+}
+
+void EnergyMeter::log() const {
+  LOG_INFO(ENERGY_TIME, (uint32_t)(awakeUs / MICROSECONDS_PER_MILLISECOND), (uint32_t)(sleepUs / MICROSECONDS_PER_SECOND), (uint32_t)(radioOnUs / MICROSECONDS_PER_MILLISECOND));
+  LOG_INFO(ENERGY_PANEL, fullRefreshCount, (uint32_t)(fullRefreshUs / MICROSECONDS_PER_MILLISECOND), partialRefreshCount, (uint32_t)(partialRefreshUs / MICROSECONDS_PER_MILLISECOND));
+  // awake time a fast refresh saves, by the averages of both kinds so far
+  const uint64_t partialAverageUs = partialRefreshCount > 0 ? partialRefreshUs / partialRefreshCount : 0;
+  const uint64_t fastAverageUs = fastRefreshCount > 0 ? fastRefreshUs / fastRefreshCount : 0;
+  const uint64_t savedUs = fastRefreshCount > 0 && partialAverageUs > fastAverageUs ? partialAverageUs - fastAverageUs : 0;
+  LOG_INFO(ENERGY_FAST_REFRESH, fastRefreshCount, (uint32_t)(fastRefreshUs / MICROSECONDS_PER_MILLISECOND), (uint32_t)(savedUs / MICROSECONDS_PER_MILLISECOND));
+  LOG_INFO(ENERGY_OTHER, buzzerOnMs, sensorConversions, consumedMah());
+  LOG_INFO(ENERGY_SLEEP, (uint32_t)(lightSleepUs / MICROSECONDS_PER_SECOND), lightSleepCount, averageMa());
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+ Cumulative per-activity counters kept in RTC memory, plus a simple current model
+ (CURRENT_* in settings.h) to turn them into consumed charge and a runtime projection.
+ Updating a counter is a single addition, so it stays on in production.
+*/
+class EnergyMeter {
+public:
+  EnergyMeter(bool initial) {
+    if (initial) reset();
+  }
+
+  void reset();
+
+  inline void addAwake(uint32_t us) { awakeUs += us; }
+  inline void addSleep(uint64_t us) { sleepUs += us; }
+  inline void addLightSleep(uint64_t us) {
+    lightSleepUs += us;
+    ++lightSleepCount;
+  }
+  inline void addRadio(uint32_t us) { radioOnUs += us; }
+  inline void addBuzzer(uint32_t ms) { buzzerOnMs += ms; }
+  inline void addSensorConversion() { ++sensorConversions; }
+  inline void addRefresh(bool full, uint32_t us) {
+    if (full) {
+      ++fullRefreshCount;
+      fullRefreshUs += us;
+    } else {
+      ++partialRefreshCount;
+      partialRefreshUs += us;
+    }
+  }
+  // Partial refresh with the short custom waveform, kept apart to compare against the OTP one.
+  inline void addFastRefresh(uint32_t us) {
+    ++fastRefreshCount;
+    fastRefreshUs += us;
+  }
+
+  // Charge used since the counters were reset, according to the current model.
+  float consumedMah() const;
+  // Average current since the counters were reset, the figure to compare sleep policies by.
+  float averageMa() const;
+  // Remaining runtime in hours at the average current so far, 0 while there is too little data.
+  uint32_t projectedRuntimeHours(float batteryLevel) const;
+  // Writes all counters to the log.
+  void log() const;
+
+private:
+  uint64_t awakeUs;
+  uint64_t sleepUs;
+  uint64_t lightSleepUs;
+  uint64_t radioOnUs;
+  uint64_t fullRefreshUs;
+  uint64_t partialRefreshUs;
+  uint64_t fastRefreshUs;
+  uint32_t fullRefreshCount;
+  uint32_t partialRefreshCount;
+  uint32_t fastRefreshCount;
+  uint32_t buzzerOnMs;
+  uint32_t sensorConversions;
+  uint32_t lightSleepCount;
+};
+
+extern EnergyMeter energyMeter;
@@ -0,0 +1,73 @@
+#include "fast_lut_panel.h"
+
+// SSD1680 commands (ref: GDEM0213B74 datasheet, command table)
+#define SSD1680_DISPLAY_UPDATE_CONTROL_2 0x22
+#define SSD1680_MASTER_ACTIVATION 0x20
+#define SSD1680_WRITE_LUT 0x32
+#define SSD1680_END_OPTION 0x3F
+#define SSD1680_GATE_VOLTAGE 0x03
+#define SSD1680_SOURCE_VOLTAGE 0x04
+#define SSD1680_VCOM 0x2C
+#define SSD1680_BORDER_WAVEFORM 0x3C
+
+// VBD = VCOM, the border value GxEPD2 writes for its partial updates
+#define SSD1680_BORDER_VCOM 0x80
+// clock + analog on, display in mode 1 with the register LUT (no OTP load), analog + clock off
+#define SSD1680_UPDATE_REGISTER_LUT 0xC7
+
+#define LUT_SIZE 153
+
+/*
+ VS: 5 LUTs (old/new pixel 00, 01, 10, 11, VCOM) x 12 groups, 2 bits per phase A..D
+ (00 = VSS, 01 = VSH1, 10 = VSL, 11 = VSH2). TP: 12 groups x (A, B, SRAB, C, D, SRCD, RP),
+ in frames. Then the frame rate of each group pair and the gate/source timing.
+
+ One 10 frame drive phase and two 1 frame settle phases, instead of the few hundred
+ milliseconds of the OTP partial waveform.
+*/
+static const uint8_t fastLut[LUT_SIZE] PROGMEM = {
+  0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // LUT0, 00: black -> black
+  0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // LUT1, 01: black -> white
+  0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // LUT2, 10: white -> black
+  0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // LUT3, 11: white -> white
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // LUT4: VCOM
+  0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // group 0: drive
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // group 1: settle
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // group 2: settle
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x22, 0x22, 0x22, 0x22, 0x22, 0x22, // FR
+  0x00, 0x00, 0x00, // XON
+};
+
+// end option, VGH, VSH1, VSH2, VSL, VCOM, the levels the LUT above was tuned with
+static const uint8_t fastLutVoltages[] PROGMEM = { 0x22, 0x17, 0x41, 0x00, 0x32, 0x36 };
+
+void FastLutPanel::refreshFast() {
+  if (_initial_refresh) return refresh(false);
+  _writeCommand(SSD1680_WRITE_LUT);
+  _writeDataPGM(fastLut, LUT_SIZE);
+  _writeCommand(SSD1680_END_OPTION);
+  _writeData(fastLutVoltages[0]);
+  _writeCommand(SSD1680_GATE_VOLTAGE);
+  _writeData(fastLutVoltages[1]);
+  _writeCommand(SSD1680_SOURCE_VOLTAGE);
+  _writeDataPGM(fastLutVoltages + 2, 3);
+  _writeCommand(SSD1680_VCOM);
+  _writeData(fastLutVoltages[5]);
+  _writeCommand(SSD1680_BORDER_WAVEFORM);
+  _writeData(SSD1680_BORDER_VCOM);
+
+  _writeCommand(SSD1680_DISPLAY_UPDATE_CONTROL_2);
+  _writeData(SSD1680_UPDATE_REGISTER_LUT);
+  _writeCommand(SSD1680_MASTER_ACTIVATION);
+  _waitWhileBusy("refreshFast", fast_refresh_time);
+  _power_is_on = false; // the update sequence switched the analog part off
+}
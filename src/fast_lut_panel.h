@@ -0,0 +1,27 @@
+#pragma once
+
+#include <GxEPD2_BW.h>
+#include <cstdint>
+
+/*
+ GxEPD2_213_B74 with a second partial refresh that runs a short waveform loaded into the
+ SSD1680 LUT register instead of the one from the panel OTP.
+
+ A partial update drives each pixel by its (old RAM, new RAM) pair, so unchanged pixels stay
+ put and only the few that flip need the drive phases - the OTP waveform spends most of its
+ time on cleaning passes a handful of changed digits does not need. The ghosting the short
+ waveform leaves behind is cleared by the periodic full refresh.
+
+ The standard refreshes reload the OTP waveform themselves (display update control 2 with
+ "load LUT" set), so nothing has to be restored after a fast one.
+*/
+class FastLutPanel : public GxEPD2_213_B74 {
+public:
+  static const uint16_t fast_refresh_time = 150; // ms, busy timeout hint like the driver's own
+
+  FastLutPanel(int16_t cs, int16_t dc, int16_t rst, int16_t busy) : GxEPD2_213_B74(cs, dc, rst, busy) {}
+
+  // Refreshes from the RAM written with writeImage*(), like refresh(x, y, w, h). The first
+  // refresh after power-up is a full one, as in the driver.
+  void refreshFast();
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ Temperature + relative humidity sensor that converts in the background: startConversion()
+ returns immediately and readConversion() fails until the result is there, so several sensors
+ can convert at the same time (see SensorRegistry).
+*/
+class HumiditySensor {
+public:
+  virtual ~HumiditySensor() {}
+  // Configures the sensor, returns false if it does not respond.
+  virtual bool begin() = 0;
+  virtual bool startConversion() = 0;
+  // Worst case time from startConversion() until the result is ready.
+  virtual uint32_t conversionTimeUs() const = 0;
+  // Returns false while the sensor is still converting, or on a bus/checksum error.
+  virtual bool readConversion(float* temperature, float* humidity) = 0;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <Wire.h>
+
+// Minimal I2C transport used by the sensor drivers, so the protocol code does not depend on
+// TwoWire directly and can run against a fake bus.
+class I2CBus {
+public:
+  virtual ~I2CBus() {}
+  // Writes `len` bytes in one transaction, returns false when the device NACKs.
+  virtual bool write(uint8_t address, const uint8_t* data, size_t len) = 0;
+  // Reads exactly `len` bytes, returns false when the device NACKs (e.g. still converting).
+  virtual bool read(uint8_t address, uint8_t* data, size_t len) = 0;
+};
+
+class WireBus : public I2CBus {
+public:
+  WireBus(TwoWire& wire) : wire(wire) {}
+
+  bool write(uint8_t address, const uint8_t* data, size_t len) override {
+    wire.beginTransmission(address);
+    wire.write(data, len);
+    return wire.endTransmission() == 0;
+  }
+
+  bool read(uint8_t address, uint8_t* data, size_t len) override {
+    if (wire.requestFrom(address, len) != len) return false;
+    for (size_t i = 0; i < len; ++i) data[i] = wire.read();
+    return true;
+  }
+
+private:
+  TwoWire& wire;
+};
@@ -0,0 +1,67 @@
+#include "log.h"
+#include "esp_attr.h"
+#include <freertos/FreeRTOS.h>
+
+static RTC_DATA_ATTR uint32_t logRing[LOG_BUFFER_WORDS];
+static RTC_DATA_ATTR uint16_t logHead = 0; // next word to write
+static RTC_DATA_ATTR uint16_t logUsed = 0; // words currently stored
+static RTC_DATA_ATTR uint32_t logDroppedWords = 0;
+static bool flushRequested = false;
+static portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED; // the render task logs too
+
+static inline uint8_t headerArgc(uint32_t header) {
+  return (header >> 18) & 0x07;
+}
+
+void logAppend(uint8_t level, LogMessage id, const uint32_t* args, uint8_t argc) {
+  const uint16_t need = 1 + argc;
+  portENTER_CRITICAL(&logMux);
+  // make room by dropping whole records from the tail
+  while (LOG_BUFFER_WORDS - logUsed < need) {
+    const uint16_t tail = (logHead + LOG_BUFFER_WORDS - logUsed) % LOG_BUFFER_WORDS;
+    const uint16_t recordLen = 1 + headerArgc(logRing[tail]);
+    logUsed -= recordLen;
+    logDroppedWords += recordLen;
+  }
+
+  const uint32_t header = ((uint32_t)id << 24) | ((uint32_t)(level & 0x07) << 21) | ((uint32_t)(argc & 0x07) << 18) | (millis() & 0x3FFFF);
+  logRing[logHead] = header;
+  logHead = (logHead + 1) % LOG_BUFFER_WORDS;
+  for (uint8_t i = 0; i < argc; ++i) {
+    logRing[logHead] = args[i];
+    logHead = (logHead + 1) % LOG_BUFFER_WORDS;
+  }
+  logUsed += need;
+  portEXIT_CRITICAL(&logMux);
+}
+
+void logRequestFlush() {
+  flushRequested = true;
+}
+
+bool logFlushRequested() {
+  return flushRequested;
+}
+
+void logFlush() {
+  if (logDroppedWords > 0) {
+    const uint32_t dropped = logDroppedWords;
+    logDroppedWords = 0;
+    logRecord(LOG_LEVEL_WARN, LogMessage::LOG_DROPPED, dropped);
+  }
+
+  char word[10];
+  Serial.begin(LOG_SERIAL_BAUD);
+  Serial.print(F("#LOG:"));
+  uint16_t tail = (logHead + LOG_BUFFER_WORDS - logUsed) % LOG_BUFFER_WORDS;
+  for (uint16_t i = 0; i < logUsed; ++i) {
+    snprintf(word, sizeof(word), "%08lx", (unsigned long)logRing[tail]);
+    Serial.print(word);
+    tail = (tail + 1) % LOG_BUFFER_WORDS;
+  }
+  Serial.println();
+  Serial.flush();
+
+  logUsed = 0;
+  flushRequested = false;
+}
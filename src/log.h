@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include <cstring>
+
+#include "log_messages.h"
+#include "settings.h"
+
+/*
+ Deferred binary log.
+
+ Records are appended to a ring buffer in RTC memory instead of being printed, so a normal
+ wakeup never touches the UART. Each record is one header word followed by its arguments:
+
+   header: [31:24] message id | [23:21] level | [20:18] argument count | [17:0] ms since boot
+   args:   one 32-bit word each, floats are stored as their IEEE-754 bits
+
+ When the ring is full the oldest records are dropped. The buffer is flushed over serial
+ (as hex text, see tools/log_decode.py) on demand or when an error was logged.
+ Levels above LOG_LEVEL compile to nothing.
+*/
+
+#define LOG_MAX_ARGS 7
+
+void logAppend(uint8_t level, LogMessage id, const uint32_t* args, uint8_t argc);
+void logRequestFlush();
+bool logFlushRequested();
+void logFlush();
+
+inline uint32_t logArg(float value) {
+  uint32_t word;
+  memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+inline uint32_t logArg(double value) {
+  return logArg((float)value);
+}
+
+template <typename T>
+inline uint32_t logArg(T value) {
+  return (uint32_t)value;
+}
+
+template <typename... Args>
+inline void logRecord(uint8_t level, LogMessage id, Args... args) {
+  static_assert(sizeof...(args) <= LOG_MAX_ARGS, "too many log arguments");
+  // leading 0 keeps the array non-empty for messages without arguments
+  const uint32_t words[] = { 0, logArg(args)... };
+  logAppend(level, id, words + 1, sizeof...(args));
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(id, ...) do { logRecord(LOG_LEVEL_ERROR, LogMessage::id, ##__VA_ARGS__); logRequestFlush(); } while (0)
+#else
+#define LOG_ERROR(id, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(id, ...) logRecord(LOG_LEVEL_WARN, LogMessage::id, ##__VA_ARGS__)
+#else
+#define LOG_WARN(id, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(id, ...) logRecord(LOG_LEVEL_INFO, LogMessage::id, ##__VA_ARGS__)
+#else
+#define LOG_INFO(id, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(id, ...) logRecord(LOG_LEVEL_DEBUG, LogMessage::id, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(id, ...) do {} while (0)
+#endif
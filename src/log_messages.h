@@ -0,0 +1,57 @@
+#pragma once
+
+// Log message catalogue. The record stores only the index of the message in this list,
+// the format string itself never leaves the flash - tools/log_decode.py parses this file
+// to turn the binary records back into text, so append new messages at the end and
+// keep the format on one line. Supported conversions: %u %d %i %x %X %f (with flags/precision).
+#define LOG_MESSAGES(X) \
+  X(WAKEUP,                "Wakeup #%u, click = %u") \
+  X(INTERRUPT_SETUP_FAIL,  "Failed to set button wakeup trigger: code %i") \
+  X(RTC_NOT_FOUND,         "Couldn't find RTC") \
+  X(RTC_LOST_POWER,        "RTC lost power, let's set the time!") \
+  X(RTC_TIME,              "RTC time: %04u/%02u/%02u %02u:%02u:%02u") \
+  X(RTC_TEMPERATURE,       "RTC temperature: %.2f C") \
+  X(TIME_SYNC_FAIL,        "Failed to get time") \
+  X(SENSOR_READ,           "Sensor reading: %.2f C, %.2f %%") \
+  X(SENSOR_FAIL,           "Sensor failure!") \
+  X(SENSOR_SKIP,           "Sensor - skip") \
+  X(REPAINT,               "Repainting, update flags = 0x%x") \
+  X(REPAINT_SKIP,          "Repaint - skip") \
+  X(REPAINT_MODE,          "Doing repaint, full = %u") \
+  X(REPAINT_TIME,          "Repaint full time: %u us") \
+  X(REPAINT_STATS_TIME,    "Repaint - all stats: %u us") \
+  X(REPAINT_GRAPH_TIME,    "Repaint - graph values: %u us") \
+  X(ALARM,                 "Making alarm sound, alerts t/h/bat = %u/%u/%u") \
+  X(ALARM_SKIP,            "Alarm sound - skip") \
+  X(SLEEP,                 "Going to bed.. (total wakeup time %u us), sleeping for %u us, peripherals up 0x%x") \
+  X(SLEEP_FAIL,            "Eh? Should not happen!") \
+  X(LOG_DROPPED,           "%u log words dropped since last flush") \
+  X(PHASE_SENSOR_START,    "Phase sensor start: %u..%u us") \
+  X(PHASE_RTC,             "Phase RTC: %u..%u us") \
+  X(PHASE_BATTERY_PAYLOAD, "Phase battery + payload: %u..%u us") \
+  X(PHASE_SENSOR_CONVERSION, "Phase sensor conversion: %u..%u us (waited from %u us)") \
+  X(PHASE_RENDER,          "Phase render: %u..%u us") \
+  X(SENSOR_INTERVAL,       "Next sensor read in %u s") \
+  X(TIME_SYNC,             "Time sync done = %u, fast path = %u") \
+  X(TELEMETRY_UPLOAD,      "Telemetry batch #%u (%u readings) upload status %d") \
+  X(ENERGY_TIME,           "Energy: awake %u ms, asleep %u s, radio on %u ms") \
+  X(ENERGY_PANEL,          "Energy: %u full refreshes (%u ms), %u partial refreshes (%u ms)") \
+  X(ENERGY_OTHER,          "Energy: buzzer on %u ms, %u sensor conversions, %.2f mAh consumed") \
+  X(CONFIG_LOAD,           "Runtime config loaded from NVS = %u") \
+  X(CONFIG_APPLIED,        "Runtime config updated over serial") \
+  X(WAKE_STUB_SKIPPED,     "Wake stub put %u wakeups back to sleep, next work in %u s") \
+  X(STATE_DUMP,            "State dump sent, %u bytes") \
+  X(STATE_DUMP_OVERFLOW,   "State dump does not fit: %u bytes") \
+  X(SENSOR_READ_EACH,      "Sensor #%u reading: %.2f C, %.2f %%") \
+  X(SENSOR_PARTIAL,        "Sensors up 0x%x, started 0x%x, read 0x%x") \
+  X(SLEEP_LIGHT,           "Light sleep (awake %u us), sleeping for %u us, break-even %u us") \
+  X(SLEEP_BREAK_EVEN,      "Cold wakeup takes %u us, light sleep break-even %u ms stored") \
+  X(ENERGY_SLEEP,          "Energy: light sleep %u s in %u naps, average %.3f mA") \
+  X(REPAINT_FAST_LUT,      "Fast LUT refresh of %u px") \
+  X(ENERGY_FAST_REFRESH,   "Energy: %u fast refreshes (%u ms), %u ms saved each over a partial one")
+
+enum class LogMessage : uint8_t {
+#define LOG_MESSAGE_ENUM(name, format) name,
+  LOG_MESSAGES(LOG_MESSAGE_ENUM)
+#undef LOG_MESSAGE_ENUM
+};
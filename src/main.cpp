@@ -1,18 +1,36 @@
 #include <Arduino.h>
+#include <algorithm>
 #include <cstdint>
 #include <esp32-hal-timer.h>
-#include <Adafruit_Si7021.h>
-#include <WiFi.h>
+#include <esp_timer.h>
+#include <Wire.h>
 #include "esp_attr.h"
-#include <MorseCodeMachine.h>
 
 #include "time.h"
 #include "display_controller.h"
+#include "repaint_plan.h"
 #include "common_types.h"
 #include "esp32-hal.h"
-#include "credentials.h"
 #include "settings.h"
 #include "stats_collector.h"
+#include "adaptive_sampler.h"
+#include "log.h"
+#include "morse_sequencer.h"
+#include "time_sync.h"
+#include "telemetry.h"
+#include "energy_meter.h"
+#include "si7021.h"
+#include "sht3x.h"
+#include "dht_sensor.h"
+#include "sensor_registry.h"
+#include "alerts.h"
+#include "runtime_config.h"
+#include "peripherals.h"
+#include "wake_stub.h"
+#include "render_pipeline.h"
+#include "state_dump.h"
+#include "sleep_governor.h"
+#include "driver/rtc_io.h"
 #include "RTClib.h"
 
 // RUNTIME STATE
@@ -21,16 +39,46 @@ RTC_DATA_ATTR bool repaintRequested = true;
 RTC_DATA_ATTR bool timeSynced = false;
 RTC_DATA_ATTR struct tm timeinfo;
 RTC_DATA_ATTR uint32_t wakeupCounter = 0;
-RTC_DATA_ATTR uint64_t lastAlarmAtSec = 0;
-RTC_DATA_ATTR uint64_t lastSensorReadoutAtSec = 0;
-
-static Adafruit_Si7021 sensor = Adafruit_Si7021();
+RTC_DATA_ATTR time_t lastAlarmAtSec = 0; // system clock
+RTC_DATA_ATTR WifiCache wifiCache = {};
+RTC_DATA_ATTR time_t lastSensorReadoutAtSec = 0; // system clock, keeps counting in deep sleep
+RTC_DATA_ATTR AlertLevel temperatureAlert = ALERT_NONE; // last raised levels, hysteresis is relative to them
+RTC_DATA_ATTR AlertLevel humidityAlert = ALERT_NONE;
+RTC_DATA_ATTR HistoryRange historyRange = HistoryRange::COMPOSITE; // cycled by the button
+RTC_DATA_ATTR RuntimeConfig config; // loaded from NVS on cold boot
+
+static WireBus i2c(Wire);
+static Si7021 sensor(i2c, SI7021_ADDRESS, Si7021Resolution::SENSOR_RESOLUTION);
+#if SENSOR_SHT3X_ADDRESS
+#if SENSOR_SHT3X_BUS == 1
+static WireBus i2c1(Wire1);
+static Sht3x sht3x(i2c1, SENSOR_SHT3X_ADDRESS);
+#else
+static Sht3x sht3x(i2c, SENSOR_SHT3X_ADDRESS);
+#endif
+#endif
+#if SENSOR_DHT_PIN >= 0
+static DhtSensor dht(SENSOR_DHT_PIN, SENSOR_DHT_TYPE);
+#endif
+static SensorRegistry sensors;
+static uint8_t sensorsStarted = 0;
 static RTC_DATA_ATTR DisplayController display(initial);
 static RTC_DATA_ATTR StatsCollector<uint16_t> statsCollector(initial);
+static RTC_DATA_ATTR AdaptiveSampler<uint16_t> sensorSampler(initial);
+static RTC_DATA_ATTR TelemetryQueue telemetry(initial);
+RTC_DATA_ATTR EnergyMeter energyMeter(initial);
+static RTC_DATA_ATTR SleepGovernor sleepGovernor(initial);
 static RTC_DS3231 rtc;
+Peripherals peripherals;
+void prepareRender();
+void renderJob(const RenderJob& job);
+static RenderPipeline renderPipeline(prepareRender, renderJob);
 
 
 bool wasClick = false;
+unsigned long wakeupTime = 0;
+bool warmWakeup = false; // this wakeup came out of light sleep, nothing was rebooted
+bool lightSleepDone = false; // loop() runs the next wakeup
 DisplayRenderPayload displayPayload;
 
 char buf[128];
@@ -49,16 +97,69 @@ inline float batteryAdcToFullness(uint16_t adcValue) {
     return (float)(adcValue - BATT_EMPTY) / (BATT_FULL - BATT_EMPTY);
 }
 
-inline AlertLevel calcHumidityAlert(float humidity) {
-  if (humidity >= 62.0 && humidity <= 73.0) return ALERT_NONE;
-  if (humidity >= 60.0 && humidity <= 75.0) return ALERT_WARNING;
-  return ALERT_DANGER;
+inline AlertLevel calcHumidityAlert(float humidity, float trendPerHour, AlertLevel previous) {
+  return calcAlert(humidity, trendPerHour / (MIN_PER_HOUR * SEC_PER_MIN), config.humidityBands, previous, config.trendAlertHorizonSec);
+}
+
+inline AlertLevel calcTemperatureAlert(float tempCelsius, float trendPerHour, AlertLevel previous) {
+  return calcAlert(tempCelsius, trendPerHour / (MIN_PER_HOUR * SEC_PER_MIN), config.temperatureBands, previous, config.trendAlertHorizonSec);
+}
+
+// ### RENDER - runs on the render task while the pipeline is up, in place otherwise
+void prepareRender() {
+  display.prepare();
 }
 
-inline AlertLevel calcTemperatureAlert(float tempCelsius) {
-  if (tempCelsius >= 19.0 && tempCelsius <= 22.0) return ALERT_NONE;
-  if (tempCelsius >= 17.0 && tempCelsius <= 24.0) return ALERT_WARNING;
-  return ALERT_DANGER;
+void renderJob(const RenderJob& job) {
+  if (job.kind == RenderJob::Kind::MESSAGE) {
+    display.debug_print(job.text);
+    return;
+  }
+
+  float t, h;
+  statsCollector.currentReadingMedian(&t, &h);
+
+  displayPayload.currentTemperatureCelsius = t;
+  displayPayload.temperatureTrendPerHour = statsCollector.trendTempPerHour();
+  displayPayload.currentHumidity = h;
+  displayPayload.humidityTrendPerHour = statsCollector.trendHumidityPerHour();
+
+  displayPayload.statsT1D = statsCollector.statsTemp1D();
+  displayPayload.statsT1W = statsCollector.statsTemp1W();
+  displayPayload.statsT1M = statsCollector.statsTemp1M();
+  displayPayload.statsH1D = statsCollector.statsHumidity1D();
+  displayPayload.statsH1W = statsCollector.statsHumidity1W();
+  displayPayload.statsH1M = statsCollector.statsHumidity1M();
+  displayPayload.exposureT1D = statsCollector.exposureTemp1D();
+  displayPayload.exposureT1W = statsCollector.exposureTemp1W();
+  displayPayload.exposureT1M = statsCollector.exposureTemp1M();
+  displayPayload.exposureH1D = statsCollector.exposureHumidity1D();
+  displayPayload.exposureH1W = statsCollector.exposureHumidity1W();
+  displayPayload.exposureH1M = statsCollector.exposureHumidity1M();
+
+  displayPayload.historyT = statsCollector.historyViewT(historyRange);
+  displayPayload.historyH = statsCollector.historyViewH(historyRange);
+
+  // todo: try lowering frequency here to save power
+  display.repaint(static_cast<DisplayController::DrawFlags>(job.drawFlags), &displayPayload);
+}
+
+void logRenderDone(const RenderDone& done) {
+  if (done.kind == RenderJob::Kind::REPAINT) {
+    LOG_DEBUG(PHASE_RENDER, done.startedAtUs - wakeupTime, done.finishedAtUs - wakeupTime);
+  }
+}
+
+// Waits for the render task to finish and gives the panel back to this core.
+void finishRender() {
+  renderPipeline.finish(logRenderDone);
+}
+
+void showMessage(const char* msg) {
+  RenderJob job = {};
+  job.kind = RenderJob::Kind::MESSAGE;
+  strncpy(job.text, msg, sizeof(job.text) - 1);
+  renderPipeline.submit(job);
 }
 
 inline bool setupInterrupts() {
@@ -76,90 +177,163 @@ inline bool setupInterrupts() {
       snprintf(buf, sizeof(buf), "Failed to set button wakeup trigger: code %i", code);
       break;
   };
-  display.debug_print(buf);
+  LOG_ERROR(INTERRUPT_SETUP_FAIL, code);
+  showMessage(buf);
   return false;
 }
 
+bool needI2c() {
+  return peripherals.need(Peripherals::I2C, [] { return Wire.begin(); });
+}
+
+bool needSensor() {
+  return needI2c() && peripherals.need(Peripherals::SENSOR, [] {
+    sensors.add(&sensor);
+#if SENSOR_SHT3X_ADDRESS
+#if SENSOR_SHT3X_BUS == 1
+    Wire1.begin(I2C1_SDA_PIN, I2C1_SCL_PIN);
+#endif
+    sensors.add(&sht3x);
+#endif
+#if SENSOR_DHT_PIN >= 0
+    sensors.add(&dht);
+#endif
+    return sensors.begin() != 0;
+  });
+}
+
+bool needRtc() {
+  return needI2c() && peripherals.need(Peripherals::RTC, [] { return rtc.begin(); });
+}
+
 bool syncTime() {
-  WiFi.persistent(false);
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  uint8_t attempts = WIFI_CONNECT_ATTEMPTS;
-  while (WiFi.status() != WL_CONNECTED) {
-    attempts -= 1;
-    if (attempts == 0) {
-      return false;
-    }
-    yield();
-    delay(WIFI_CONNECT_ATTEMPT_INTERVAL_MS - 40);
-    if (BLINK_LED) {
-      digitalWrite(LED_BUILTIN, HIGH);
-      delay(40);
-      digitalWrite(LED_BUILTIN, LOW);
-    }
+  EspTimeSyncNetwork network;
+  TimeSync sync(network, wifiCache);
+  const time_t clockBefore = time(nullptr);
+  const unsigned long radioOnAt = micros();
+  sync.start(millis());
+  while (!sync.finished()) {
+    delay(WIFI_POLL_INTERVAL_MS);
+    sync.step(millis());
   }
-  configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER_0, NTP_SERVER_1, NTP_SERVER_2);
-  delay(500);
+  energyMeter.addRadio(micros() - radioOnAt);
+  LOG_INFO(TIME_SYNC, sync.state() == TimeSync::State::DONE, sync.usedFastPath());
+  if (sync.state() != TimeSync::State::DONE) {
+    return false;
+  }
+  // whatever the clock moved beyond the time the sync took is the step
+  statsCollector.clockStepped(time(nullptr) - clockBefore - (time_t) ((micros() - radioOnAt) / 1000000));
   getLocalTime(&timeinfo);
-  WiFi.disconnect(true);
-  WiFi.mode(WIFI_OFF);
   return true;
 }
 
-void delayMorse() {
-  delay(BUZZ_LENGTH_MS);
+void makeAlertSound(const char msg[]) {
+  uint8_t units[MORSE_MAX_STEPS];
+  const uint8_t count = compileMorse(msg, units, MORSE_MAX_STEPS);
+  uint32_t toneUnits = 0;
+  for (uint8_t i = 0; i < count; i += 2) toneUnits += units[i];
+  energyMeter.addBuzzer(toneUnits * BUZZ_LENGTH_MS);
+  gpio_hold_dis(BUZZER_PIN);
+  playMorse(units, count, BUZZ_LENGTH_MS, BUZZ_PITCH_HZ);
+  digitalWrite(BUZZER_PIN, LOW);
+  gpio_hold_en(BUZZER_PIN);
 }
 
-void dotMorse() {
-  tone(BUZZER_PIN, BUZZ_PITCH_HZ);
-  delayMorse();
-  noTone(BUZZER_PIN);
+// Seconds until the next wakeup that has to run the app: a sensor reading or the alarm.
+// Telemetry uploads ride on sensor wakeups, repaints follow readings or button presses.
+time_t secondsUntilWork() {
+  const time_t now = time(nullptr);
+  const time_t sensorDueAt = lastSensorReadoutAtSec + (time_t) sensorSampler.intervalSec();
+  const time_t alarmDueAt = lastAlarmAtSec + (time_t) config.alarmIntervalSec;
+  return std::max((time_t) 0, std::min(sensorDueAt, alarmDueAt) - now);
 }
 
-void dashMorse() {
-  tone(BUZZER_PIN, BUZZ_PITCH_HZ);
-  delayMorse();
-  delayMorse();
-  delayMorse();
-  noTone(BUZZER_PIN);
+// true when the button is still down `ms` after wakeup, gives up as soon as it is released
+bool buttonHeld(uint32_t ms) {
+  while (micros() - wakeupTime < ms * MICROSECONDS_PER_MILLISECOND) {
+    if (digitalRead(ONBOARD_BUTTON_PIN) != LOW) return false;
+    delay(10);
+  }
+  return true;
 }
 
-void makeAlertSound(const char msg[]) {
-  gpio_hold_dis(BUZZER_PIN);
-  sendMorse(msg, delayMorse, dotMorse, dashMorse);
-  gpio_hold_en(BUZZER_PIN);
+void writeStatePayload(BlobWriter& w) {
+  w.u32(wakeupCounter);
+  w.u32(time(nullptr));
+  w.u8(temperatureAlert);
+  w.u8(humidityAlert);
+  statsCollector.dump(w);
+}
+
+void sendStateDump() {
+  stateDumpSend(writeStatePayload);
+}
+
+// Sleeps through short gaps in RAM (returns afterwards, loop() runs the next wakeup), reboots
+// out of deep sleep otherwise, see SleepGovernor.
+void lightSleep(const unsigned long wakeupTimeMicroseconds, uint64_t sleepUs) {
+  LOG_INFO(SLEEP_LIGHT, micros() - wakeupTimeMicroseconds, sleepUs, (uint32_t) sleepGovernor.breakEvenUs());
+  energyMeter.addAwake(micros() - wakeupTimeMicroseconds);
+  if (logFlushRequested()) {
+    logFlush();
+  }
+  // the ext0 button wakeup set up by setupInterrupts() works in light sleep too
+  esp_sleep_enable_timer_wakeup(sleepUs);
+  const int64_t sleptAt = esp_timer_get_time();
+  esp_light_sleep_start();
+  energyMeter.addLightSleep(esp_timer_get_time() - sleptAt);
+  rtc_gpio_deinit(ONBOARD_BUTTON_PIN); // ext0 left the pad on the RTC mux, digitalRead needs it back
+  warmWakeup = true;
+  lightSleepDone = true;
 }
 
 void gracefulSleep(const unsigned long wakeupTimeMicroseconds) {
-  Serial.println("..setting buzzer pin low");
+  finishRender();
   digitalWrite(BUZZER_PIN, LOW);
   gpio_hold_en(BUZZER_PIN);
-  gpio_deep_sleep_hold_en(); // make sure the buzzer pin is down during deep sleep
-  Serial.println("..computing sleep time");
+  if (!warmWakeup) {
+    sleepGovernor.recordColdWake(wakeupTime, peripherals.bringUpUs());
+  }
   auto sleepInterval = MICROSECONDS_PER_MILLISECOND * WAKEUP_INTERVAL_MS;
+  // something still pending, or work that failed, wants the app back on the next regular wakeup
+  const uint64_t gapUs = SleepGovernor::gapUs(secondsUntilWork(), repaintRequested || initial, sleepInterval);
+  if (sleepGovernor.preferLightSleep(gapUs)) {
+    lightSleep(wakeupTimeMicroseconds, gapUs);
+    return;
+  }
+  gpio_deep_sleep_hold_en(); // make sure the buzzer pin is down during deep sleep
   // subtract time spent turned on to keep interval and not delay between wakeups
   auto wakeupAfterMicroseconds = constrain(sleepInterval - wakeupTimeMicroseconds, MICROSECONDS_PER_MILLISECOND * 100, sleepInterval);
-  Serial.println("(now really sleep)\n\n\n\n");
-  Serial.flush();
+  LOG_INFO(SLEEP, micros() - wakeupTimeMicroseconds, wakeupAfterMicroseconds, peripherals.upMask());
+  energyMeter.addAwake(micros() - wakeupTimeMicroseconds);
+  energyMeter.addSleep(wakeupAfterMicroseconds);
+  if (repaintRequested || initial) {
+    wakeStubDisarm(); // something is still pending, let the next wakeup run the app
+  } else {
+    wakeStubArm((uint64_t) secondsUntilWork() * MICROSECONDS_PER_SECOND, sleepInterval);
+  }
+  if (logFlushRequested()) {
+    logFlush();
+  }
   delay(1); // without this the program is reset by watchdog during sleep for some reason - couldn't figure out why
   esp_deep_sleep(wakeupAfterMicroseconds); 
-  Serial.println("Eh? Should not happen!");
+  LOG_ERROR(SLEEP_FAIL);
 }
 
-void setup() {
+// One wakeup: read, collect, repaint, alarm, then sleep. Runs from setup() after a reboot out of
+// deep sleep and from loop() after a light sleep.
+void runWakeup() {
   pinMode(ONBOARD_BUTTON_PIN, INPUT_PULLUP);
   pinMode(LED_BUILTIN, OUTPUT);
   pinMode(BUZZER_PIN, OUTPUT);
 
-  unsigned long wakeupTime = micros();
+  wakeupTime = micros();
 
-  Serial.begin(115200);
-  Serial.print(F("Wakeup!!!!!! #"));
-  Serial.println(++wakeupCounter);
-  Serial.print(F("compiled: "));
-  Serial.print(__DATE__);
-  Serial.print(F(" "));
-  Serial.println(__TIME__);
+  if (initial) {
+    const bool fromNvs = configLoad(&config);
+    LOG_INFO(CONFIG_LOAD, fromNvs);
+    sleepGovernor.load();
+  }
 
   wasClick = false;
   if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT0) {
@@ -169,10 +343,25 @@ void setup() {
         digitalWrite(LED_BUILTIN, LOW);  delay(50);
       }
   }
-  Serial.print(F("Was click: "));
-  Serial.println(wasClick);
-  if (wasClick) {
+  LOG_INFO(WAKEUP, ++wakeupCounter, wasClick);
+  const uint32_t stubSkipped = wakeStubTakeSkipped();
+  if (stubSkipped > 0) {
+    // the stub runs for well under a millisecond, count its wakeups as sleep
+    energyMeter.addSleep((uint64_t) stubSkipped * MICROSECONDS_PER_MILLISECOND * WAKEUP_INTERVAL_MS);
+    LOG_DEBUG(WAKE_STUB_SKIPPED, stubSkipped, secondsUntilWork());
+  }
+  bool historyRangeChanged = false;
+  bool dumpRequested = false;
+  if (wasClick && buttonHeld(STATE_DUMP_LONG_PRESS_MS)) {
+    dumpRequested = true;
+  } else if (wasClick) {
     repaintRequested = true;
+    historyRange = static_cast<HistoryRange>(((uint8_t) historyRange + 1) % (uint8_t) HistoryRange::COUNT);
+    historyRangeChanged = true;
+    if (LOG_FLUSH_ON_CLICK) {
+      energyMeter.log();
+      logRequestFlush();
+    }
   }
   // Blink once for wakeup
   if (BLINK_LED) {
@@ -182,21 +371,58 @@ void setup() {
   }
 
   if (!setupInterrupts()) return;
-  Serial.println(F("Interrupts set."));
 
-  // ### TIME
-  if (!rtc.begin()) {
-    Serial.println("Couldn't find RTC");
-    Serial.flush();
+  // ### SENSOR - start
+  // The due checks run on the system clock (kept by the RTC timer across deep sleep), so the
+  // conversion can be kicked off before the DS3231 is read and overlap with everything below,
+  // and a wakeup with nothing due brings up no peripheral at all.
+  UpdateFlags updateFlags = UpdateFlags::NONE;
+  const time_t sensorCheckAtSec = time(nullptr);
+  // the clock and lastSensorReadoutAtSec both start near 0 on a cold boot, read right away anyway
+  const bool sensorDue = initial || sensorCheckAtSec - lastSensorReadoutAtSec >= (time_t) sensorSampler.intervalSec();
+  bool sensorConverting = false;
+
+  // A reading or a button press most likely ends in a repaint: bring the panel up on the other
+  // core now, it overlaps with the conversion and the RTC read below.
+  if (sensorDue || repaintRequested) {
+    renderPipeline.start();
   }
-  if (rtc.lostPower()) {
-    Serial.println("RTC lost power, let's set the time!");
+
+  unsigned long phaseStart = micros();
+  if (sensorDue) {
+    // every sensor converts at the same time, collected together below
+    sensorsStarted = needSensor() ? sensors.startAll() : 0;
+    sensorConverting = sensorsStarted != 0;
+    for (uint8_t i = 0; i < sensors.count(); ++i) {
+      if (sensorsStarted & (1 << i)) energyMeter.addSensorConversion();
+    }
+    if (!sensorConverting) {
+      LOG_ERROR(SENSOR_FAIL);
+      snprintf(buf, sizeof(buf), "Sensor no begin :(");
+      showMessage(buf);
+    }
+  } else {
+    LOG_DEBUG(SENSOR_SKIP);
+  }
+  const unsigned long conversionStart = micros();
+  LOG_DEBUG(PHASE_SENSOR_START, phaseStart - wakeupTime, conversionStart - wakeupTime);
+
+  // ### TIME - the wall clock is only needed to timestamp a reading or to draw the clock
+  const bool needsWallClock = sensorConverting || repaintRequested;
+  DateTime dt_now;
+  phaseStart = micros();
+  if (needsWallClock && !needRtc()) {
+    LOG_ERROR(RTC_NOT_FOUND);
+  }
+  if (needsWallClock && rtc.lostPower()) {
+    LOG_WARN(RTC_LOST_POWER);
     if (!timeSynced) {
       timeSynced = syncTime();
     }
     if(!getLocalTime(&timeinfo)) {
+      LOG_ERROR(TIME_SYNC_FAIL);
       snprintf(buf, sizeof(buf), "Failed to get time :(");
-      display.debug_print(buf);
+      showMessage(buf);
       return;
     }
 
@@ -207,101 +433,119 @@ void setup() {
     // January 21, 2014 at 3am you would call:
     // rtc.adjust(DateTime(2014, 1, 21, 3, 0, 0));
   }
-  DateTime dt_now = rtc.now();
-  Serial.print("\nRTC Time: ");
-  Serial.print(dt_now.year(), DEC);
-  Serial.print('/');
-  Serial.print(dt_now.month(), DEC);
-  Serial.print('/');
-  Serial.print(dt_now.day(), DEC);
-  Serial.print(' ');
-  Serial.print(dt_now.hour(), DEC);
-  Serial.print(':');
-  Serial.print(dt_now.minute(), DEC);
-  Serial.print(':');
-  Serial.print(dt_now.second(), DEC);
-  Serial.println();
-  Serial.print("RTC Temperature: ");
-  Serial.print(rtc.getTemperature());
-  Serial.println(" C\n");
-
-  // ### SENSOR
+  if (needsWallClock) {
+    dt_now = rtc.now();
+    LOG_DEBUG(RTC_TIME, dt_now.year(), dt_now.month(), dt_now.day(), dt_now.hour(), dt_now.minute(), dt_now.second());
+    LOG_DEBUG(RTC_TEMPERATURE, rtc.getTemperature());
+    LOG_DEBUG(PHASE_RTC, phaseStart - wakeupTime, micros() - wakeupTime);
+  }
 
-  UpdateFlags updateFlags = UpdateFlags::NONE;
-  DateTime lastSensorReadoutAt = DateTime(SECONDS_FROM_1970_TO_2000 + lastSensorReadoutAtSec);
-  if ((dt_now - lastSensorReadoutAt).totalseconds() >= SENSOR_READ_INTERVAL_SEC) {
-    if (sensor.begin()) {
-      Serial.println("Reading sensor...");
-      lastSensorReadoutAtSec = dt_now.secondstime();
-      sensor.heater(false); // preserve battery
-      updateFlags = statsCollector.collect(sensor.readTemperature(), sensor.readHumidity());
+  // ### BATTERY + PAYLOAD - everything that does not depend on the new reading
+  phaseStart = micros();
+  displayPayload.batteryLevel = batteryAdcToFullness(analogRead(BATTERY_ADC_PIN));
+  displayPayload.degreesUnit = config.degreesUnit;
+  displayPayload.timeinfo = dt_now;
+  LOG_DEBUG(PHASE_BATTERY_PAYLOAD, phaseStart - wakeupTime, micros() - wakeupTime);
+
+  // ### SENSOR - collect
+  if (sensorConverting) {
+    phaseStart = micros();
+    float temperature, humidity;
+    SensorReading readings[SENSOR_REGISTRY_MAX];
+    const uint8_t good = sensors.collectAll(readings);
+    for (uint8_t i = 0; i < sensors.count(); ++i) {
+      if (good & (1 << i)) LOG_DEBUG(SENSOR_READ_EACH, i, readings[i].temperature, readings[i].humidity);
+    }
+    if (good != (1 << sensors.count()) - 1) {
+      LOG_WARN(SENSOR_PARTIAL, sensors.up(), sensorsStarted, good);
+    }
+    if (SensorRegistry::fuse(readings, good, &temperature, &humidity)) {
+      LOG_DEBUG(PHASE_SENSOR_CONVERSION, conversionStart - wakeupTime, micros() - wakeupTime, phaseStart - wakeupTime);
+      lastSensorReadoutAtSec = sensorCheckAtSec;
+      LOG_INFO(SENSOR_READ, temperature, humidity);
+      updateFlags = statsCollector.collect(temperature, humidity);
+
+      float t, h;
+      statsCollector.currentReadingMedian(&t, &h);
+      const AlertLevel newTemperatureAlert = calcTemperatureAlert(t, statsCollector.trendTempPerHour(), temperatureAlert);
+      const AlertLevel newHumidityAlert = calcHumidityAlert(h, statsCollector.trendHumidityPerHour(), humidityAlert);
+      if (newTemperatureAlert != temperatureAlert || newHumidityAlert != humidityAlert) {
+        updateFlags |= UpdateFlags::CURRENT_READING;
+      }
+      temperatureAlert = newTemperatureAlert;
+      humidityAlert = newHumidityAlert;
+      sensorSampler.update(temperature, humidity);
+      telemetry.append(dt_now.unixtime(), pack<int16_t>(temperature), pack<uint16_t>(humidity));
+      LOG_DEBUG(SENSOR_INTERVAL, sensorSampler.intervalSec());
     } else {
-      Serial.println("Sensor failure!");
-      snprintf(buf, sizeof(buf), "Sensor no begin :(");
-      display.debug_print(buf);
+      LOG_ERROR(SENSOR_FAIL);
+      snprintf(buf, sizeof(buf), "Sensor no reading :(");
+      showMessage(buf);
     }
-  } else {
-    Serial.println("Sensor - skip");
   }
 
   if (repaintRequested || (uint16_t) updateFlags) {
-    Serial.println("Repainting");
-    float t, h;
-    statsCollector.currentReadingMedian(&t, &h);
-
-    displayPayload.degreesUnit = CELSIUS;
-    displayPayload.timeinfo = dt_now;
-    displayPayload.currentTemperatureCelsius = t;
-    displayPayload.temperatureAlert = calcTemperatureAlert(displayPayload.currentTemperatureCelsius);
-    displayPayload.currentHumidity = h;
-    displayPayload.humidityAlert = calcHumidityAlert(displayPayload.currentHumidity);
-    displayPayload.batteryLevel = batteryAdcToFullness(analogRead(BATTERY_ADC_PIN));
-
-    displayPayload.statsT1D = statsCollector.statsTemp1D();
-    displayPayload.statsT1W = statsCollector.statsTemp1W();
-    displayPayload.statsT1M = statsCollector.statsTemp1M();
-    displayPayload.statsH1D = statsCollector.statsHumidity1D();
-    displayPayload.statsH1W = statsCollector.statsHumidity1W();
-    displayPayload.statsH1M = statsCollector.statsHumidity1M();
-
-    statsCollector.getHistoryChartDataT(displayPayload.historyChartT);
-    statsCollector.getHistoryChartDataH(displayPayload.historyChartH);
-
-    DisplayController::DrawFlags flags = DisplayController::DrawFlags::SD_CARD | DisplayController::DrawFlags::BATTERY | DisplayController::DrawFlags::TIME;
-    if (isFlagSet(updateFlags, UpdateFlags::CURRENT_READING)) flags |= DisplayController::DrawFlags::CURRENT_READINGS | DisplayController::DrawFlags::GAUGES;
-    if (isFlagSet(updateFlags, UpdateFlags::STATS_DAY | UpdateFlags::STATS_WEEK | UpdateFlags::STATS_MONTH)) flags |= DisplayController::DrawFlags::STATISTICS;
-    if (isFlagSet(updateFlags, UpdateFlags::HISTORY_HOUR | UpdateFlags::HISTORY_DAY | UpdateFlags::HISTORY_WEEK | UpdateFlags::HISTORY_MONTH | UpdateFlags::HISTORY_YEAR)) flags |= DisplayController::DrawFlags::HISTORY_GRAPH;
-
-    // todo: try lowering frequency here to save power
-    display.repaint(flags, &displayPayload);
+    LOG_INFO(REPAINT, (uint16_t) updateFlags);
+    // everything this core keeps changing is copied now, the render task builds the rest
+    displayPayload.temperatureAlert = temperatureAlert;
+    displayPayload.humidityAlert = humidityAlert;
+    displayPayload.projectedRuntimeHours = energyMeter.projectedRuntimeHours(displayPayload.batteryLevel);
+    DisplayController::DrawFlags flags = drawFlagsFor(updateFlags);
+    if (historyRangeChanged) {
+      // a bare view switch only needs the graph area, one partial refresh
+      flags = updateFlags == UpdateFlags::NONE ? DisplayController::DrawFlags::HISTORY_GRAPH : flags | DisplayController::DrawFlags::HISTORY_GRAPH;
+    }
+    RenderJob job = {};
+    job.kind = RenderJob::Kind::REPAINT;
+    job.drawFlags = (uint16_t) flags;
+    renderPipeline.submit(job);
     repaintRequested = false;
   } else {
-    Serial.println("Repaint - skip");
+    LOG_DEBUG(REPAINT_SKIP);
   }
 
-  DateTime lastAlarmAt = DateTime(SECONDS_FROM_1970_TO_2000 + lastAlarmAtSec);
-  if ((dt_now - lastAlarmAt).totalseconds() >= ALARM_INTERVAL_SEC) {
-    Serial.println("Making alarm sound");
-    lastAlarmAtSec = dt_now.secondstime();
-    if (displayPayload.humidityAlert == ALERT_DANGER) {
-      makeAlertSound("HUM");
+  const time_t alarmCheckAtSec = time(nullptr);
+  if (initial || alarmCheckAtSec - lastAlarmAtSec >= (time_t) config.alarmIntervalSec) {
+    LOG_INFO(ALARM, temperatureAlert, humidityAlert, displayPayload.batteryLevel <= config.alertBatteryLow);
+    lastAlarmAtSec = alarmCheckAtSec;
+    // all alerts in one sequence, separated by word gaps
+    char alertMsg[16] = "";
+    if (humidityAlert == ALERT_DANGER) {
+      strcat(alertMsg, "HUM ");
+    }
+    if (temperatureAlert == ALERT_DANGER) {
+      strcat(alertMsg, "TMP ");
     }
-    if (displayPayload.temperatureAlert == ALERT_DANGER) {
-      makeAlertSound("TMP");
+    if (displayPayload.batteryLevel <= config.alertBatteryLow) {
+      strcat(alertMsg, "BAT ");
     }
-    if (displayPayload.batteryLevel <= ALERT_BAT_LOW) {
-      makeAlertSound("BAT");
+    if (alertMsg[0] != '\0') {
+      finishRender(); // playMorse light-sleeps, which would stall the render core
     }
+    makeAlertSound(alertMsg);
   } else {
-    Serial.println("Alarm sound - skip");
+    LOG_DEBUG(ALARM_SKIP);
   }
 
-  // statsCollector.printDebug();
+  // ### TELEMETRY - readings only arrive with the wall clock read, so only those wakeups check
+  // (after a light sleep the RTC is still up, but dt_now is only set when it was read above)
+  if (needsWallClock && telemetry.uploadDue(dt_now.unixtime())) {
+    uploadTelemetry(telemetry, dt_now.unixtime());
+  }
+
+  if (dumpRequested) {
+    sendStateDump();
+  }
+
+  // ### CONFIG - listen for a new runtime config while someone is around to send it
+  if (initial || wasClick) {
+    if (configSerialWindow(&config, CONFIG_SERIAL_WINDOW_MS, sendStateDump)) {
+      LOG_INFO(CONFIG_APPLIED);
+      wifiCache.valid = false; // might be another network now
+      repaintRequested = true;
+    }
+  }
 
-  Serial.print("Going to bed.. (total wakeup time ");
-  Serial.print(micros() - wakeupTime);
-  Serial.println("us) z-z-z-z\n");
-  // Serial.flush();
   initial = false;
 
   // blink before sleep
@@ -312,10 +556,19 @@ void setup() {
     digitalWrite(LED_BUILTIN, LOW);
   }
 
-  // will reset from setup() after wakeup
+  // a deep sleep resets into setup(), a light sleep returns into loop()
   gracefulSleep(wakeupTime);
 }
 
+void setup() {
+  runWakeup();
+}
+
 void loop() {
-  gracefulSleep(0);
+  if (lightSleepDone) {
+    lightSleepDone = false;
+    runWakeup();
+  } else {
+    gracefulSleep(wakeupTime); // runWakeup() bailed out early
+  }
 }
@@ -0,0 +1,57 @@
+#include "morse_sequencer.h"
+
+#include <Arduino.h>
+#include "driver/ledc.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "settings.h"
+
+#define MORSE_LEDC_MODE LEDC_LOW_SPEED_MODE
+#define MORSE_LEDC_TIMER LEDC_TIMER_0
+#define MORSE_LEDC_CHANNEL LEDC_CHANNEL_0
+#define MORSE_LEDC_RESOLUTION LEDC_TIMER_10_BIT
+#define MORSE_LEDC_DUTY_ON (1 << (MORSE_LEDC_RESOLUTION - 1)) // 50%
+
+static void sleepUntil(int64_t deadlineUs) {
+  // the button wakeup stays armed, so keep going back to sleep until the edge is really due
+  int64_t now = esp_timer_get_time();
+  while (now < deadlineUs) {
+    esp_sleep_enable_timer_wakeup(deadlineUs - now);
+    esp_light_sleep_start();
+    now = esp_timer_get_time();
+  }
+}
+
+void playMorse(const uint8_t* units, uint8_t count, uint16_t unitMs, uint32_t pitchHz) {
+  if (count == 0) return;
+
+  ledc_timer_config_t timer = {};
+  timer.speed_mode = MORSE_LEDC_MODE;
+  timer.duty_resolution = MORSE_LEDC_RESOLUTION;
+  timer.timer_num = MORSE_LEDC_TIMER;
+  timer.freq_hz = pitchHz;
+  timer.clk_cfg = LEDC_USE_RTC8M_CLK; // APB clock stops in light sleep, RTC8M does not
+  ledc_timer_config(&timer);
+
+  ledc_channel_config_t channel = {};
+  channel.gpio_num = BUZZER_PIN;
+  channel.speed_mode = MORSE_LEDC_MODE;
+  channel.channel = MORSE_LEDC_CHANNEL;
+  channel.intr_type = LEDC_INTR_DISABLE;
+  channel.timer_sel = MORSE_LEDC_TIMER;
+  channel.duty = 0;
+  channel.hpoint = 0;
+  ledc_channel_config(&channel);
+
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC8M, ESP_PD_OPTION_ON);
+  int64_t edgeAt = esp_timer_get_time();
+  for (uint8_t i = 0; i < count; ++i) {
+    ledc_set_duty(MORSE_LEDC_MODE, MORSE_LEDC_CHANNEL, i % 2 == 0 ? MORSE_LEDC_DUTY_ON : 0);
+    ledc_update_duty(MORSE_LEDC_MODE, MORSE_LEDC_CHANNEL);
+    edgeAt += (int64_t)units[i] * unitMs * MICROSECONDS_PER_MILLISECOND;
+    sleepUntil(edgeAt);
+  }
+  ledc_stop(MORSE_LEDC_MODE, MORSE_LEDC_CHANNEL, 0);
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC8M, ESP_PD_OPTION_AUTO);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+#include "morse_table.h"
+
+// Plays a table compiled by compileMorse() on BUZZER_PIN. The tone is generated by LEDC from
+// the RTC8M clock so it keeps running while the CPU waits in light sleep for the next edge.
+void playMorse(const uint8_t* units, uint8_t count, uint16_t unitMs, uint32_t pitchHz);
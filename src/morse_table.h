@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+
+#define MORSE_MAX_STEPS 96
+
+static const char* const morseLetters[26] = {
+  ".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---", "-.-", ".-..", "--",
+  "-.", "---", ".--.", "--.-", ".-.", "...", "-", "..-", "...-", ".--", "-..-", "-.--", "--..",
+};
+
+static const char* const morseDigits[10] = {
+  "-----", ".----", "..---", "...--", "....-", ".....", "-....", "--...", "---..", "----.",
+};
+
+static inline const char* morseCode(char c) {
+  c = toupper(c);
+  if (c >= 'A' && c <= 'Z') return morseLetters[c - 'A'];
+  if (c >= '0' && c <= '9') return morseDigits[c - '0'];
+  return nullptr;
+}
+
+/*
+ Morse alarm compiled into a timing table: units[0] is a tone, units[1] a pause, units[2] a
+ tone and so on, each in dot lengths (dot 1, dash 3, gap between symbols 1, between letters 3,
+ between words 7). Unknown characters are skipped. Returns the number of entries written,
+ always odd (starts and ends with a tone) or 0 for nothing to play.
+
+ No dependencies, so the table can be checked on the host; playMorse() (morse_sequencer.h)
+ plays it.
+*/
+static inline uint8_t compileMorse(const char* msg, uint8_t* units, uint8_t maxSteps) {
+  uint8_t count = 0;
+  bool wordGap = false;
+  for (const char* c = msg; *c; ++c) {
+    if (*c == ' ') {
+      wordGap = count > 0;
+      continue;
+    }
+    const char* code = morseCode(*c);
+    if (code == nullptr) continue;
+    // every symbol needs a pause before it (except the very first) and a tone
+    for (const char* symbol = code; *symbol; ++symbol) {
+      if (count + (count > 0 ? 2 : 1) > maxSteps) return count;
+      if (count > 0) {
+        units[count++] = symbol != code ? 1 : (wordGap ? 7 : 3);
+      }
+      units[count++] = *symbol == '-' ? 3 : 1;
+    }
+    wordGap = false;
+  }
+  return count;
+}
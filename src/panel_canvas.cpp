@@ -0,0 +1,138 @@
+#include "panel_canvas.h"
+#include <algorithm>
+#include <cstring>
+
+// Rotation 1 as GxEPD2_BW applies it: logical (x, y) is bit VISIBLE_WIDTH - 1 - y of line x.
+
+static inline void apply(uint8_t& b, uint8_t mask, uint16_t color) {
+  if (color == GxEPD_BLACK) {
+    b &= ~mask;
+  } else {
+    b |= mask;
+  }
+}
+
+PanelCanvas::PanelCanvas(const NativeFont* const* fonts, uint8_t fontCount)
+: Adafruit_GFX(VISIBLE_WIDTH, NATIVE_HEIGHT), fonts(fonts), fontCount(fontCount) {
+  setRotation(1);
+}
+
+void PanelCanvas::nativeWindow(int16_t x, int16_t y, int16_t w, int16_t h, int16_t* nx, int16_t* ny, int16_t* nw, int16_t* nh) {
+  const int16_t from = std::max(VISIBLE_WIDTH - y - h, 0) & ~7;
+  const int16_t to = std::min((VISIBLE_WIDTH - y + 7) & ~7, (int)NATIVE_WIDTH);
+  *nx = from;
+  *nw = std::max(to - from, 0);
+  *ny = std::max(x, (int16_t)0);
+  *nh = std::max(std::min(x + w, (int)NATIVE_HEIGHT) - *ny, 0);
+}
+
+void PanelCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || x >= _width || y < 0 || y >= _height) return;
+  const int16_t bit = VISIBLE_WIDTH - 1 - y;
+  apply(buf[x * LINE_BYTES + bit / 8], 0x80 >> (bit & 7), color);
+}
+
+void PanelCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (x < 0 || x >= _width) return;
+  const int16_t top = std::max(y, (int16_t)0);
+  const int16_t bottom = std::min(y + h, (int)_height);
+  if (top >= bottom) return;
+  fillRun(x, VISIBLE_WIDTH - bottom, VISIBLE_WIDTH - top, color);
+}
+
+void PanelCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (y < 0 || y >= _height) return;
+  const int16_t left = std::max(x, (int16_t)0);
+  const int16_t right = std::min(x + w, (int)_width);
+  const int16_t bit = VISIBLE_WIDTH - 1 - y;
+  const uint8_t mask = 0x80 >> (bit & 7);
+  uint8_t* p = buf + left * LINE_BYTES + bit / 8;
+  for (int16_t line = left; line < right; ++line, p += LINE_BYTES) {
+    apply(*p, mask, color);
+  }
+}
+
+void PanelCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  const int16_t left = std::max(x, (int16_t)0);
+  const int16_t right = std::min(x + w, (int)_width);
+  const int16_t top = std::max(y, (int16_t)0);
+  const int16_t bottom = std::min(y + h, (int)_height);
+  if (top >= bottom) return;
+  for (int16_t line = left; line < right; ++line) {
+    fillRun(line, VISIBLE_WIDTH - bottom, VISIBLE_WIDTH - top, color);
+  }
+}
+
+void PanelCanvas::fillScreen(uint16_t color) {
+  memset(buf, color == GxEPD_BLACK ? 0x00 : 0xFF, sizeof(buf));
+}
+
+void PanelCanvas::fillRun(int16_t line, int16_t from, int16_t to, uint16_t color) {
+  uint8_t* p = buf + line * LINE_BYTES;
+  const int16_t first = from / 8;
+  const int16_t last = (to - 1) / 8;
+  const uint8_t head = 0xFF >> (from & 7);
+  const uint8_t tail = 0xFF << (7 - ((to - 1) & 7));
+  if (first == last) {
+    apply(p[first], head & tail, color);
+    return;
+  }
+  apply(p[first], head, color);
+  memset(p + first + 1, color == GxEPD_BLACK ? 0x00 : 0xFF, last - first - 1);
+  apply(p[last], tail, color);
+}
+
+void PanelCanvas::drawNative(const NativeBitmap& bitmap, int16_t x, int16_t y, uint16_t color) {
+  blit(bitmap.rows, bitmap.width, bitmap.height, x, y, color);
+}
+
+void PanelCanvas::blit(const uint8_t* rows, uint8_t width, uint8_t height, int16_t x, int16_t y, uint16_t color) {
+  static const int16_t lastByte = (VISIBLE_WIDTH - 1) / 8;
+  static const uint8_t lastMask = (uint8_t)(0xFF << (7 - (VISIBLE_WIDTH - 1) % 8));
+  const uint8_t rowBytes = (height + 7) / 8;
+  const int16_t start = VISIBLE_WIDTH - y - height; // bit of the row's first pixel
+  for (uint8_t column = 0; column < width; ++column, rows += rowBytes) {
+    const int16_t line = x + column;
+    if (line < 0 || line >= _width) continue;
+    uint8_t* p = buf + line * LINE_BYTES;
+    for (uint8_t i = 0; i < rowBytes; ++i) {
+      if (rows[i] == 0) continue;
+      const int16_t at = start + i * 8;
+      const int16_t byte = at >= 0 ? at / 8 : (at - 7) / 8;
+      const uint8_t shift = at - byte * 8;
+      // the row straddles two buffer bytes unless it is byte aligned, clip both to the visible part
+      const uint8_t parts[2] = { (uint8_t)(rows[i] >> shift), (uint8_t)(shift ? rows[i] << (8 - shift) : 0) };
+      for (uint8_t k = 0; k < 2; ++k) {
+        const int16_t to = byte + k;
+        if (parts[k] == 0 || to < 0 || to > lastByte) continue;
+        apply(p[to], to == lastByte ? parts[k] & lastMask : parts[k], color);
+      }
+    }
+  }
+}
+
+const NativeFont* PanelCanvas::nativeFont() const {
+  for (uint8_t i = 0; i < fontCount; ++i) {
+    if (fonts[i]->font == gfxFont) return fonts[i];
+  }
+  return nullptr;
+}
+
+size_t PanelCanvas::write(uint8_t c) {
+  const NativeFont* font = gfxFont != nullptr && textsize_x == 1 && textsize_y == 1 && !wrap ? nativeFont() : nullptr;
+  if (font == nullptr) {
+    return Adafruit_GFX::write(c);
+  }
+  // same cursor handling as Adafruit_GFX::write() for custom fonts
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += gfxFont->yAdvance;
+  } else if (c != '\r' && c >= gfxFont->first && c <= gfxFont->last) {
+    const GFXglyph& glyph = gfxFont->glyph[c - gfxFont->first];
+    if (glyph.width > 0 && glyph.height > 0) {
+      blit(font->bitmap + font->offsets[c - gfxFont->first], glyph.width, glyph.height, cursor_x + glyph.xOffset, cursor_y + glyph.yOffset, textcolor);
+    }
+    cursor_x += glyph.xAdvance;
+  }
+  return 1;
+}
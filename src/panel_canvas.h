@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <GxEPD2_BW.h>
+#include <cstdint>
+
+// Bitmap pre-rotated into the panel-native layout by tools/panel_assets.py: one row per
+// logical column, each row the column's pixels bottom to top, MSB first, 1 = ink.
+struct NativeBitmap {
+  uint8_t width; // logical size
+  uint8_t height;
+  const uint8_t* rows;
+};
+
+// Glyphs of a GFX font in the native layout, metrics stay in the source font.
+struct NativeFont {
+  const GFXfont* font;
+  const uint8_t* bitmap;
+  const uint16_t* offsets; // per glyph, into `bitmap`
+};
+
+/*
+ Frame buffer in the panel RAM layout, drawn in the landscape orientation of the display.
+
+ Same buffer and pixel mapping GxEPD2_BW has with setRotation(1), so the panel driver takes it
+ as is, but without its per-pixel path: a logical column is a run of bits in one buffer line,
+ so vertical lines, rectangles, native bitmaps and native font glyphs are written a byte at a
+ time. Everything else still goes through drawPixel(), which only swaps the coordinates.
+*/
+class PanelCanvas : public Adafruit_GFX {
+public:
+  static const uint16_t NATIVE_WIDTH = GxEPD2_213_B74::WIDTH; // buffer line, in bits
+  static const uint16_t VISIBLE_WIDTH = GxEPD2_213_B74::WIDTH_VISIBLE;
+  static const uint16_t NATIVE_HEIGHT = GxEPD2_213_B74::HEIGHT;
+  static const uint16_t LINE_BYTES = NATIVE_WIDTH / 8;
+
+  PanelCanvas(const NativeFont* const* fonts, uint8_t fontCount);
+
+  const uint8_t* buffer() const { return buf; }
+
+  // Native rectangle (x on byte boundaries) covering a logical one, for partial refreshes.
+  static void nativeWindow(int16_t x, int16_t y, int16_t w, int16_t h, int16_t* nx, int16_t* ny, int16_t* nw, int16_t* nh);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  // Glyphs of the native fonts are blitted, other fonts fall back to the GFX per-pixel path.
+  size_t write(uint8_t c) override;
+
+  // Draws the ink of `bitmap` in `color` with its top left corner at x, y, like
+  // drawInvertedBitmap() of the original landscape bitmap.
+  void drawNative(const NativeBitmap& bitmap, int16_t x, int16_t y, uint16_t color);
+
+private:
+  uint8_t buf[LINE_BYTES * NATIVE_HEIGHT];
+  const NativeFont* const* fonts;
+  uint8_t fontCount;
+
+  const NativeFont* nativeFont() const;
+  void blit(const uint8_t* rows, uint8_t width, uint8_t height, int16_t x, int16_t y, uint16_t color);
+  // bits [from, to) of buffer line `line`
+  void fillRun(int16_t line, int16_t from, int16_t to, uint16_t color);
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "common_types.h"
+#include "settings.h"
+
+/*
+ Time-weighted running metrics of one channel over a period, updated in O(1) per reading:
+ Welford mean/variance (weights are the seconds a reading stands for) and seconds spent in
+ each alert band. Two periods merge in O(1) too (Chan et al.), which is how days roll up
+ into weeks and months without looking at history again.
+*/
+struct PeriodMetrics {
+  float weightSec;
+  float mean;
+  float m2;
+  uint32_t bandSec[3]; // ALERT_NONE, ALERT_WARNING, ALERT_DANGER
+
+  void clear() {
+    weightSec = 0;
+    mean = 0;
+    m2 = 0;
+    bandSec[0] = bandSec[1] = bandSec[2] = 0;
+  }
+
+  void add(float value, AlertLevel band, uint32_t seconds) {
+    if (seconds == 0) return;
+    weightSec += seconds;
+    const float delta = value - mean;
+    mean += delta * seconds / weightSec;
+    m2 += seconds * delta * (value - mean);
+    bandSec[bandIndex(band)] += seconds;
+  }
+
+  void merge(const PeriodMetrics& other) {
+    if (other.weightSec == 0) return;
+    const float total = weightSec + other.weightSec;
+    const float delta = other.mean - mean;
+    m2 += other.m2 + delta * delta * weightSec * other.weightSec / total;
+    mean += delta * other.weightSec / total;
+    weightSec = total;
+    for (uint8_t i = 0; i < 3; ++i) bandSec[i] += other.bandSec[i];
+  }
+
+  ExposureStatistics<float> statistics() const {
+    ExposureStatistics<float> stats = { NAN, NAN, 0, 0 };
+    if (weightSec == 0) return stats;
+    stats.mean = mean;
+    stats.stddev = sqrtf(m2 / weightSec);
+    const uint32_t total = bandSec[0] + bandSec[1] + bandSec[2];
+    stats.outOfBandPercent = 100.0f * (bandSec[1] + bandSec[2]) / total;
+    stats.dangerPercent = 100.0f * bandSec[2] / total;
+    return stats;
+  }
+
+private:
+  static inline uint8_t bandIndex(AlertLevel band) {
+    return band == ALERT_DANGER ? 2 : band == ALERT_WARNING ? 1 : 0;
+  }
+};
+
+/*
+ Tumbling day / week / month periods of PeriodMetrics. Periods are counted in collected
+ seconds, not calendar days: the day closes after 24h worth of readings and is merged into
+ the week and the month, which close after 7 and DAY_PER_MONTH days. The week and month
+ read as their closed days merged with the running day, so right after a rollover they only
+ hold part of a day. Unlike the 24h / 7d / 30d tier statistics these are not sliding windows.
+*/
+class TumblingMetrics {
+public:
+  void clear() {
+    day.clear();
+    week.clear();
+    month.clear();
+    daySec = 0;
+    weekDays = 0;
+    monthDays = 0;
+  }
+
+  void add(float value, AlertLevel band, uint32_t seconds) {
+    // a long gap can close several days, each gets its share of the reading
+    for (uint8_t i = 0; seconds > 0 && i <= DAY_PER_MONTH; ++i) {
+      const uint32_t part = std::min(seconds, daySeconds - daySec);
+      day.add(value, band, part);
+      daySec += part;
+      seconds -= part;
+      if (daySec == daySeconds) closeDay();
+    }
+  }
+
+  ExposureStatistics<float> dayStatistics() const {
+    return day.statistics();
+  }
+
+  ExposureStatistics<float> weekStatistics() const {
+    PeriodMetrics merged = week;
+    merged.merge(day);
+    return merged.statistics();
+  }
+
+  ExposureStatistics<float> monthStatistics() const {
+    PeriodMetrics merged = month;
+    merged.merge(day);
+    return merged.statistics();
+  }
+
+private:
+  static const uint32_t daySeconds = HOUR_PER_DAY * MIN_PER_HOUR * SEC_PER_MIN;
+
+  PeriodMetrics day;
+  PeriodMetrics week;  // closed days of the running week
+  PeriodMetrics month; // closed days of the running month
+  uint32_t daySec;
+  uint8_t weekDays;
+  uint8_t monthDays;
+
+  // The day that completes a week or month ends it, the next day starts a new one (and the
+  // week never reads as more than 7 days).
+  void closeDay() {
+    if (++weekDays >= 7) {
+      week.clear();
+      weekDays = 0;
+    } else {
+      week.merge(day);
+    }
+    if (++monthDays >= DAY_PER_MONTH) {
+      month.clear();
+      monthDays = 0;
+    } else {
+      month.merge(day);
+    }
+    day.clear();
+    daySec = 0;
+  }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <cstdint>
+
+/*
+ Tracks which peripherals were brought up since boot. Most wakeups only check the clock and
+ go back to sleep, so nothing is initialized before the first code path that needs it calls
+ need(), which runs the bring-up once and caches its result until the next deep sleep (a light
+ sleep keeps them up). The mask of what came up is logged before going to sleep, the time spent
+ in bring-ups feeds the SleepGovernor. Safe to use from the IO and the render task, as long as
+ each peripheral is only ever needed from one of them.
+*/
+class Peripherals {
+public:
+  enum Id : uint8_t {
+    I2C    = 1 << 0, // 1
+    RTC    = 1 << 1, // 2
+    SENSOR = 1 << 2, // 4
+    PANEL  = 1 << 3, // 8
+  };
+
+  template <typename BringUp>
+  bool need(Id id, BringUp bringUp) {
+    if (!(attempted.fetch_or(id) & id)) {
+      const unsigned long startedAt = micros();
+      if (bringUp()) ready.fetch_or(id);
+      bringUpTime.fetch_add(micros() - startedAt);
+    }
+    return ready.load() & id;
+  }
+
+  bool isUp(Id id) const {
+    return ready.load() & id;
+  }
+
+  uint8_t upMask() const {
+    return ready.load();
+  }
+
+  uint32_t bringUpUs() const {
+    return bringUpTime.load();
+  }
+
+private:
+  std::atomic<uint8_t> attempted{0};
+  std::atomic<uint8_t> ready{0};
+  std::atomic<uint32_t> bringUpTime{0};
+};
+
+extern Peripherals peripherals;
@@ -0,0 +1,70 @@
+#include "render_pipeline.h"
+
+#include <Arduino.h>
+
+bool RenderPipeline::start() {
+  if (running()) return true;
+  ioTask = xTaskGetCurrentTaskHandle();
+  if (xTaskCreatePinnedToCore(run, "render", RENDER_TASK_STACK_BYTES, this, 1, &renderTask, RENDER_TASK_CORE) != pdPASS) {
+    renderTask = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void RenderPipeline::submit(const RenderJob& job) {
+  if (!running()) {
+    // nothing to overlap with, render in place
+    if (job.kind != RenderJob::Kind::STOP) handle(job);
+    return;
+  }
+  while (!jobs.push(job)) {
+    vTaskDelay(1);
+  }
+  xTaskNotifyGive(renderTask);
+}
+
+void RenderPipeline::finish(OnDone onDone) {
+  if (!running()) return;
+  RenderJob stop = {};
+  stop.kind = RenderJob::Kind::STOP;
+  submit(stop);
+
+  RenderDone record;
+  bool stopped = false;
+  while (!stopped) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (done.pop(&record)) {
+      if (record.kind == RenderJob::Kind::STOP) {
+        stopped = true;
+      } else {
+        onDone(record);
+      }
+    }
+  }
+  renderTask = nullptr;
+}
+
+void RenderPipeline::run(void* self) {
+  RenderPipeline* pipeline = static_cast<RenderPipeline*>(self);
+  pipeline->prepare();
+
+  RenderJob job;
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (pipeline->jobs.pop(&job)) {
+      RenderDone record = { job.kind, micros(), 0 };
+      if (job.kind != RenderJob::Kind::STOP) {
+        pipeline->handle(job);
+      }
+      record.finishedAtUs = micros();
+      while (!pipeline->done.push(record)) {
+        vTaskDelay(1);
+      }
+      xTaskNotifyGive(pipeline->ioTask);
+      if (job.kind == RenderJob::Kind::STOP) {
+        vTaskDelete(nullptr);
+      }
+    }
+  }
+}
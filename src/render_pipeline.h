@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "spsc_queue.h"
+
+#define RENDER_JOB_TEXT_LEN 128
+#define RENDER_TASK_STACK_BYTES 8192
+#define RENDER_TASK_CORE 0 // setup()/loop() run on core 1
+
+struct RenderJob {
+  enum class Kind : uint8_t {
+    REPAINT, // build the payload and repaint the `drawFlags` (DisplayController::DrawFlags) areas
+    MESSAGE, // debug_print(text)
+    STOP,
+  };
+
+  Kind kind;
+  uint16_t drawFlags;
+  char text[RENDER_JOB_TEXT_LEN];
+};
+
+struct RenderDone {
+  RenderJob::Kind kind;
+  unsigned long startedAtUs;
+  unsigned long finishedAtUs;
+};
+
+/*
+ Runs everything that touches the panel in its own task on the other core, so panel bring-up,
+ payload building and the refresh overlap with sensor, RTC, Wi-Fi and buzzer work in setup().
+ Jobs go in and completions come back through lock-free SPSC queues, a task notification wakes
+ the waiting side. Once started, the render task owns the panel until finish().
+*/
+class RenderPipeline {
+public:
+  typedef void (*Prepare)();
+  typedef void (*Handler)(const RenderJob& job);
+  typedef void (*OnDone)(const RenderDone& done);
+
+  // The render task runs `prepare` once and then `handle` for every submitted job.
+  RenderPipeline(Prepare prepare, Handler handle) : prepare(prepare), handle(handle) {}
+
+  bool start();
+  bool running() const { return renderTask != nullptr; }
+
+  void submit(const RenderJob& job);
+  // Waits for the submitted jobs, stops the task and reports every finished job to `onDone`.
+  void finish(OnDone onDone);
+
+private:
+  SpscQueue<RenderJob, 4> jobs;
+  SpscQueue<RenderDone, 4> done;
+  TaskHandle_t renderTask = nullptr;
+  TaskHandle_t ioTask = nullptr;
+  Prepare prepare;
+  Handler handle;
+
+  static void run(void* self);
+};
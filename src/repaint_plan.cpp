@@ -0,0 +1,89 @@
+#include "repaint_plan.h"
+#include <algorithm>
+#include "panel_canvas.h"
+#include "settings.h"
+
+typedef DisplayController::DrawFlags DrawFlags;
+
+static const struct {
+  DrawFlags flag;
+  DirtyArea area;
+} layoutAreas[DIRTY_AREAS_MAX] = {
+  { DrawFlags::SD_CARD, { 67, 0, 72, 5 } },
+  { DrawFlags::BATTERY, { 0, 0, 64, 5 } },
+  { DrawFlags::TIME, { 170, 0, 78, 5 } },
+  { DrawFlags::GAUGES, { 0, 13, 105, 51 } },
+  { DrawFlags::CURRENT_READINGS, { 106, 11, 34, 56 } },
+  { DrawFlags::STATISTICS, { 143, 13, 107, 43 } },
+  { DrawFlags::HISTORY_GRAPH, { 0, 64, 255, 58 } },
+};
+
+DrawFlags drawFlagsFor(UpdateFlags updateFlags) {
+  DrawFlags flags = DrawFlags::SD_CARD | DrawFlags::BATTERY | DrawFlags::TIME;
+  if (isFlagSet(updateFlags, UpdateFlags::CURRENT_READING)) flags |= DrawFlags::CURRENT_READINGS | DrawFlags::GAUGES;
+  if (isFlagSet(updateFlags, UpdateFlags::STATS_DAY | UpdateFlags::STATS_WEEK | UpdateFlags::STATS_MONTH)) flags |= DrawFlags::STATISTICS;
+  if (isFlagSet(updateFlags, UpdateFlags::HISTORY_HOUR | UpdateFlags::HISTORY_DAY | UpdateFlags::HISTORY_WEEK | UpdateFlags::HISTORY_MONTH | UpdateFlags::HISTORY_YEAR)) flags |= DrawFlags::HISTORY_GRAPH;
+  return flags;
+}
+
+uint8_t dirtyAreasFor(DrawFlags flags, DirtyArea* out) {
+  uint8_t count = 0;
+  for (const auto& layout : layoutAreas) {
+    if (isFlagSet(flags, layout.flag)) out[count++] = layout.area;
+  }
+  return count;
+}
+
+static uint32_t pixels(const RefreshWindow& window) {
+  return (uint32_t) window.w * window.h;
+}
+
+static RefreshWindow unite(const RefreshWindow& a, const RefreshWindow& b) {
+  const int16_t x = std::min(a.x, b.x), y = std::min(a.y, b.y);
+  return RefreshWindow { x, y, (int16_t) (std::max(a.x + a.w, b.x + b.w) - x), (int16_t) (std::max(a.y + a.h, b.y + b.h) - y), a.fast };
+}
+
+static bool contains(const RefreshWindow& outer, const RefreshWindow& inner) {
+  return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+}
+
+uint8_t planRefreshWindows(const DirtyArea* areas, uint8_t count, RefreshWindow* out) {
+  uint8_t fastCount = 0;
+  RefreshWindow standard = { 0, 0, 0, 0, false };
+  for (uint8_t i = 0; i < count; ++i) {
+    RefreshWindow window = { 0, 0, 0, 0, true };
+    PanelCanvas::nativeWindow(areas[i].x, areas[i].y, areas[i].w, areas[i].h, &window.x, &window.y, &window.w, &window.h);
+    if (window.w == 0 || window.h == 0) continue;
+    if (pixels(window) > FAST_LUT_MAX_AREA_PX) {
+      window.fast = false;
+      standard = standard.w == 0 ? window : unite(standard, window);
+      continue;
+    }
+    bool joined = false;
+    for (uint8_t j = 0; j < fastCount && !joined; ++j) {
+      const RefreshWindow both = unite(out[j], window);
+      if (pixels(both) <= FAST_LUT_MAX_AREA_PX) {
+        out[j] = both;
+        joined = true;
+      }
+    }
+    if (!joined) out[fastCount++] = window;
+  }
+  uint8_t planned = 0;
+  for (uint8_t j = 0; j < fastCount; ++j) {
+    if (standard.w == 0 || !contains(standard, out[j])) out[planned++] = out[j];
+  }
+  if (standard.w != 0) out[planned++] = standard;
+  return planned;
+}
+
+void flushWindow(FastLutPanel& epd, const uint8_t* buffer, const RefreshWindow& window) {
+  const int16_t width = PanelCanvas::NATIVE_WIDTH, height = PanelCanvas::NATIVE_HEIGHT;
+  epd.writeImagePart(buffer, window.x, window.y, width, height, window.x, window.y, window.w, window.h);
+  if (window.fast) {
+    epd.refreshFast();
+  } else {
+    epd.refresh(window.x, window.y, window.w, window.h);
+  }
+  epd.writeImagePartAgain(buffer, window.x, window.y, width, height, window.x, window.y, window.w, window.h);
+}
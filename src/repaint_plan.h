@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include "display_controller.h"
+#include "fast_lut_panel.h"
+#include "stats_collector.h"
+
+/*
+ What a partial repaint refreshes, and with which waveform.
+
+ Each layout area the draw flags name is decided on its own: areas of up to FAST_LUT_MAX_AREA_PX
+ panel pixels get their own window with the fast waveform, neighbours sharing one as long as it
+ stays that small. The larger areas share one window with the OTP waveform, which also takes the
+ small ones that lie inside it. A single bounding box would almost always be large, the status
+ bar alone spans the full width.
+*/
+
+// Logical rectangle of the layout.
+struct DirtyArea {
+  int16_t x, y, w, h;
+};
+
+// Native panel window, as PanelCanvas::nativeWindow() gives it.
+struct RefreshWindow {
+  int16_t x, y, w, h;
+  bool fast;
+};
+
+#define DIRTY_AREAS_MAX 7
+
+// The areas a sensor or statistics update changes; the status bar (time, battery, SD card) always.
+DisplayController::DrawFlags drawFlagsFor(UpdateFlags updateFlags);
+
+// The areas `flags` draw into, at most DIRTY_AREAS_MAX. Returns how many were written to `out`.
+uint8_t dirtyAreasFor(DisplayController::DrawFlags flags, DirtyArea* out);
+
+// Windows covering `areas`, the fast ones first, at most `count`. Returns how many were written to `out`.
+uint8_t planRefreshWindows(const DirtyArea* areas, uint8_t count, RefreshWindow* out);
+
+// Writes the window of `buffer` to both panel RAMs around its refresh, the same sequence
+// GxEPD2_BW runs for a single page buffer.
+void flushWindow(FastLutPanel& epd, const uint8_t* buffer, const RefreshWindow& window);
+
+// Flushes the windows in order, `refreshed(window, us)` after each.
+template <typename F>
+void flushWindows(FastLutPanel& epd, const uint8_t* buffer, const RefreshWindow* windows, uint8_t count, F refreshed) {
+  for (uint8_t i = 0; i < count; ++i) {
+    const unsigned long startedUs = micros();
+    flushWindow(epd, buffer, windows[i]);
+    refreshed(windows[i], (uint32_t) (micros() - startedUs));
+  }
+}
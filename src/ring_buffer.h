@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ Fixed capacity ring of S values that overwrites the oldest one when full.
+
+ The contents are at most two contiguous runs of the backing array: first() from the oldest
+ value up to the end of the array, then second() from the start of the array. Traversals walk
+ the two spans as plain linear loops instead of wrapping an index on every element.
+
+ Index 0 is the oldest value.
+*/
+template <typename T, long S>
+class RingBuffer {
+public:
+  struct Span {
+    const T* data;
+    uint16_t length;
+  };
+
+  RingBuffer() {
+    clear();
+  }
+
+  // For RTC memory: the constructor runs again on every deep sleep wakeup, `initialized`
+  // returns true when the contents survived and must be kept.
+  RingBuffer(bool (*initialized)(void)) {
+    if (!initialized()) {
+      clear();
+    }
+  }
+
+  void clear() {
+    head = 0;
+    count = 0;
+  }
+
+  uint16_t size() const { return count; }
+  constexpr uint16_t maxSize() const { return S; }
+  bool isEmpty() const { return count == 0; }
+  bool isFull() const { return count == S; }
+
+  T operator[](uint16_t index) const {
+    const uint16_t at = head + index;
+    return buf[at < S ? at : at - S];
+  }
+
+  T oldest() const { return buf[head]; }
+  T newest() const { return (*this)[count - 1]; }
+
+  Span first() const {
+    const uint16_t length = head + count <= S ? count : S - head;
+    return Span { buf + head, length };
+  }
+
+  Span second() const {
+    const uint16_t length = head + count <= S ? 0 : head + count - S;
+    return Span { buf, length };
+  }
+
+  void pushOverwrite(const T& value) {
+    pushOverwrite(value, [](const T&) {});
+  }
+
+  // `onEvict` sees the value being overwritten, before the push, so running aggregates can
+  // take it out.
+  template <typename OnEvict>
+  void pushOverwrite(const T& value, OnEvict onEvict) {
+    uint16_t at = head + count;
+    if (at >= S) at -= S;
+    if (count == S) {
+      onEvict(buf[head]);
+      head = head + 1 < S ? head + 1 : 0;
+    } else {
+      ++count;
+    }
+    buf[at] = value;
+  }
+
+  // Bulk push, same result as pushing the values one by one, oldest first.
+  template <typename OnEvict>
+  void pushOverwrite(const T* values, uint16_t n, OnEvict onEvict) {
+    for (uint16_t i = 0; i < n; ++i) pushOverwrite(values[i], onEvict);
+  }
+
+  void pushOverwrite(const T* values, uint16_t n) {
+    pushOverwrite(values, n, [](const T&) {});
+  }
+
+  // Pushes `n` copies of `value`, at most S writes however large `n` is.
+  void pushRepeated(const T& value, uint32_t n) {
+    if (n < S) {
+      for (uint32_t i = 0; i < n; ++i) pushOverwrite(value);
+      return;
+    }
+    for (long i = 0; i < S; ++i) buf[i] = value;
+    head = 0;
+    count = S;
+  }
+
+  // Copies up to `max` of the oldest values into `out`, returns how many.
+  uint16_t copyTo(T* out, uint16_t max) const {
+    const Span a = first();
+    const Span b = second();
+    const uint16_t fromA = a.length < max ? a.length : max;
+    const uint16_t fromB = b.length < max - fromA ? b.length : max - fromA;
+    memcpy(out, a.data, fromA * sizeof(T));
+    memcpy(out + fromA, b.data, fromB * sizeof(T));
+    return fromA + fromB;
+  }
+
+  // Calls f(value) for every value, oldest first.
+  template <typename F>
+  void forEach(F f) const {
+    const Span a = first();
+    for (uint16_t i = 0; i < a.length; ++i) f(a.data[i]);
+    const Span b = second();
+    for (uint16_t i = 0; i < b.length; ++i) f(b.data[i]);
+  }
+
+private:
+  T buf[S];
+  uint16_t head; // oldest value
+  uint16_t count;
+};
@@ -0,0 +1,106 @@
+#include "runtime_config.h"
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#define CONFIG_NVS_NAMESPACE "config"
+#define CONFIG_NVS_KEY "blob"
+#define CONFIG_SERIAL_LINE_LEN (8 + 2 * CONFIG_MAX_BYTES)
+
+namespace {
+
+void printBlobHex(const RuntimeConfig& config) {
+  uint8_t blob[CONFIG_MAX_BYTES];
+  const size_t len = configSerialize(config, blob, sizeof(blob));
+  char byte[3];
+  Serial.print(F("#CFG:"));
+  for (size_t i = 0; i < len; ++i) {
+    snprintf(byte, sizeof(byte), "%02x", blob[i]);
+    Serial.print(byte);
+  }
+  Serial.println();
+}
+
+void handleLine(const char* line, RuntimeConfig* config, bool* applied, void (*onDumpRequest)()) {
+  uint8_t blob[CONFIG_MAX_BYTES];
+  size_t len = 0;
+  ConfigStatus status = ConfigStatus::OK;
+  switch (configParseLine(line, blob, sizeof(blob), &len, &status)) {
+    case ConfigCommand::NONE:
+      return;
+    case ConfigCommand::DUMP:
+      if (onDumpRequest) onDumpRequest();
+      return;
+    case ConfigCommand::QUERY:
+      printBlobHex(*config);
+      return;
+    case ConfigCommand::STORE:
+      break;
+  }
+  if (status == ConfigStatus::OK) {
+    status = configStore(blob, len, config);
+  }
+
+  if (status == ConfigStatus::OK) {
+    *applied = true;
+    Serial.println(F("#CFG:OK"));
+  } else {
+    Serial.print(F("#CFG:ERR "));
+    Serial.println((uint8_t) status);
+  }
+}
+
+}
+
+bool configLoad(RuntimeConfig* config) {
+  configDefaults(config);
+  Preferences prefs;
+  if (!prefs.begin(CONFIG_NVS_NAMESPACE, true)) return false;
+  uint8_t blob[CONFIG_MAX_BYTES];
+  const size_t len = prefs.getBytesLength(CONFIG_NVS_KEY);
+  const bool read = len > 0 && len <= sizeof(blob) && prefs.getBytes(CONFIG_NVS_KEY, blob, len) == len;
+  prefs.end();
+  return read && configParse(blob, len, config) == ConfigStatus::OK;
+}
+
+ConfigStatus configStore(const uint8_t* data, size_t len, RuntimeConfig* config) {
+  RuntimeConfig parsed;
+  const ConfigStatus status = configParse(data, len, &parsed);
+  if (status != ConfigStatus::OK) return status;
+
+  Preferences prefs;
+  if (!prefs.begin(CONFIG_NVS_NAMESPACE, false)) return ConfigStatus::STORAGE_FAIL;
+  const bool written = prefs.putBytes(CONFIG_NVS_KEY, data, len) == len;
+  prefs.end();
+  if (!written) return ConfigStatus::STORAGE_FAIL;
+  *config = parsed;
+  return ConfigStatus::OK;
+}
+
+bool configSerialWindow(RuntimeConfig* config, uint32_t windowMs, void (*onDumpRequest)()) {
+  static char line[CONFIG_SERIAL_LINE_LEN];
+  size_t lineLen = 0;
+  bool applied = false;
+
+  Serial.begin(LOG_SERIAL_BAUD);
+  Serial.println(F("#CFG:READY"));
+  uint32_t deadline = millis() + windowMs;
+  while ((int32_t)(deadline - millis()) > 0) {
+    if (!Serial.available()) {
+      delay(1);
+      continue;
+    }
+    const int c = Serial.read();
+    deadline = millis() + windowMs;
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (lineLen < sizeof(line) - 1) line[lineLen++] = c;
+      continue;
+    }
+    line[lineLen] = '\0';
+    lineLen = 0;
+    handleLine(line, config, &applied, onDumpRequest);
+  }
+  Serial.flush();
+  return applied;
+}
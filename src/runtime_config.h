@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "common_types.h"
+#include "alerts.h"
+#include "settings.h"
+
+#define CONFIG_MAGIC 0x4643 // "CF"
+#define CONFIG_FORMAT_VERSION 1
+#define CONFIG_HEADER_BYTES 6
+#define CONFIG_MAX_BYTES 512
+#define CONFIG_SSID_LEN 33 // including the terminator
+#define CONFIG_PASSWORD_LEN 65
+#define CONFIG_NTP_SERVER_LEN 40
+#define CONFIG_NTP_SERVERS 3
+
+/*
+ Settings that can change without reflashing. Parsed once at cold boot from the blob in NVS
+ (compile-time defaults from settings.h / credentials.h when there is none or it does not
+ validate) into RTC memory, so deep sleep wakeups never touch the flash.
+
+ Blob format, all integers little endian:
+   header:  magic u16 | format version u8 | reserved u8 | payload length u16
+   payload: sensor interval u16 | max sensor interval u16 | alarm interval u32 | trend horizon u32
+            humidity bands 5 x f32 | temperature bands 5 x f32 | battery low f32 | degrees unit u8
+            gmt offset i32 | daylight offset i32
+            wifi ssid, wifi password, 3 ntp servers: length u8 + bytes each
+   trailer: crc32 (zlib) of header + payload
+
+ A newer minor revision may append fields, so a payload longer than this version knows is
+ accepted and the rest ignored. tools/config_tool.py writes and reads the same format.
+*/
+struct RuntimeConfig {
+  uint16_t sensorReadIntervalSec;
+  uint16_t sensorMaxIntervalSec;
+  uint32_t alarmIntervalSec;
+  uint32_t trendAlertHorizonSec;
+  AlertBands humidityBands;
+  AlertBands temperatureBands;
+  float alertBatteryLow;
+  DegreesUnit degreesUnit;
+  int32_t gmtOffsetSec;
+  int32_t daylightOffsetSec;
+  char wifiSsid[CONFIG_SSID_LEN];
+  char wifiPassword[CONFIG_PASSWORD_LEN];
+  char ntpServers[CONFIG_NTP_SERVERS][CONFIG_NTP_SERVER_LEN];
+};
+
+enum class ConfigStatus : uint8_t {
+  OK,
+  TOO_SHORT,
+  BAD_MAGIC,
+  BAD_VERSION,
+  BAD_CRC,
+  BAD_VALUE,
+  STORAGE_FAIL,
+};
+
+void configDefaults(RuntimeConfig* config);
+bool configValid(const RuntimeConfig& config);
+// `out` is only written when the whole blob parses and validates.
+ConfigStatus configParse(const uint8_t* data, size_t len, RuntimeConfig* out);
+// Returns the blob length, 0 when it does not fit into `capacity`.
+size_t configSerialize(const RuntimeConfig& config, uint8_t* out, size_t capacity);
+uint32_t configCrc32(const uint8_t* data, size_t len);
+
+enum class ConfigCommand : uint8_t {
+  NONE, // not a config window line
+  QUERY,
+  STORE,
+  DUMP,
+};
+
+// Parses a line of the serial config window (below). For STORE the decoded blob is in
+// `blob` / `len`, unless `status` is BAD_VALUE for an odd length, over-long or non hex line.
+ConfigCommand configParseLine(const char* line, uint8_t* blob, size_t capacity, size_t* len, ConfigStatus* status);
+
+// NVS side. configLoad falls back to the defaults and returns false when there is no valid blob.
+bool configLoad(RuntimeConfig* config);
+ConfigStatus configStore(const uint8_t* data, size_t len, RuntimeConfig* config);
+
+/*
+ Serial config window, opened on cold boot and on button wakeup. Announces itself with
+ "#CFG:READY" and for `windowMs` (extended while a line is coming in) answers:
+   "#CFG?"          -> "#CFG:<hex blob>" with the active config
+   "#CFG:<hex blob>" -> stores and applies it, "#CFG:OK" or "#CFG:ERR <status>"
+   "#DUMP?"         -> calls `onDumpRequest` (state dump, see state_dump.h)
+ Returns true when a new config was applied.
+*/
+bool configSerialWindow(RuntimeConfig* config, uint32_t windowMs, void (*onDumpRequest)() = nullptr);
+
+extern RuntimeConfig config;
@@ -0,0 +1,163 @@
+#include "runtime_config.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "blob_io.h"
+#include "credentials.h"
+
+// The blob format and the serial line syntax, kept free of Arduino and NVS so it builds on
+// the host (test/test_runtime_config). Storage and the serial window are in runtime_config.cpp.
+
+namespace {
+
+bool bandsValid(const AlertBands& b) {
+  if (!std::isfinite(b.dangerLow) || !std::isfinite(b.dangerHigh) || !std::isfinite(b.hysteresis)) return false;
+  return b.dangerLow <= b.warningLow && b.warningLow < b.warningHigh && b.warningHigh <= b.dangerHigh
+    && b.hysteresis >= 0 && b.hysteresis * 2 < b.warningHigh - b.warningLow;
+}
+
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+}
+
+void configDefaults(RuntimeConfig* config) {
+  static const AlertBands humidityBands = HUMIDITY_BANDS;
+  static const AlertBands temperatureBands = TEMPERATURE_BANDS;
+  memset(config, 0, sizeof(*config));
+  config->sensorReadIntervalSec = SENSOR_READ_INTERVAL_SEC;
+  config->sensorMaxIntervalSec = ADAPTIVE_SENSOR_MAX_INTERVAL_SEC;
+  config->alarmIntervalSec = ALARM_INTERVAL_SEC;
+  config->trendAlertHorizonSec = TREND_ALERT_HORIZON_SEC;
+  config->humidityBands = humidityBands;
+  config->temperatureBands = temperatureBands;
+  config->alertBatteryLow = ALERT_BAT_LOW;
+  config->degreesUnit = CELSIUS;
+  config->gmtOffsetSec = GMT_OFFSET_SEC;
+  config->daylightOffsetSec = DAYLIGHT_OFFSET_SEC;
+  strncpy(config->wifiSsid, WIFI_SSID, sizeof(config->wifiSsid) - 1);
+  strncpy(config->wifiPassword, WIFI_PASSWORD, sizeof(config->wifiPassword) - 1);
+  strncpy(config->ntpServers[0], NTP_SERVER_0, CONFIG_NTP_SERVER_LEN - 1);
+  strncpy(config->ntpServers[1], NTP_SERVER_1, CONFIG_NTP_SERVER_LEN - 1);
+  strncpy(config->ntpServers[2], NTP_SERVER_2, CONFIG_NTP_SERVER_LEN - 1);
+}
+
+bool configValid(const RuntimeConfig& config) {
+  // the reads buffer is sized for SENSOR_READ_INTERVAL_SEC, so it is the shortest interval
+  // and the day tier step (30min) is the longest one that keeps it fed
+  if (config.sensorReadIntervalSec < SENSOR_READ_INTERVAL_SEC || config.sensorMaxIntervalSec > 30 * SEC_PER_MIN) return false;
+  if (config.sensorMaxIntervalSec < config.sensorReadIntervalSec) return false;
+  if (config.alarmIntervalSec < SEC_PER_MIN) return false;
+  if (config.trendAlertHorizonSec > HOUR_PER_DAY * MIN_PER_HOUR * SEC_PER_MIN) return false;
+  if (!bandsValid(config.humidityBands) || !bandsValid(config.temperatureBands)) return false;
+  if (!(config.alertBatteryLow >= 0 && config.alertBatteryLow <= 1)) return false;
+  if (config.degreesUnit != CELSIUS && config.degreesUnit != FARENHEIT) return false;
+  const int32_t maxOffset = 14 * MIN_PER_HOUR * SEC_PER_MIN;
+  if (abs(config.gmtOffsetSec) > maxOffset || abs(config.daylightOffsetSec) > maxOffset) return false;
+  if (config.wifiSsid[0] == '\0' || config.ntpServers[0][0] == '\0') return false;
+  return true;
+}
+
+size_t configSerialize(const RuntimeConfig& config, uint8_t* out, size_t capacity) {
+  BlobWriter w(out, capacity);
+  w.u16(CONFIG_MAGIC);
+  w.u8(CONFIG_FORMAT_VERSION);
+  w.u8(0);
+  w.u16(0); // payload length, patched below
+
+  w.u16(config.sensorReadIntervalSec);
+  w.u16(config.sensorMaxIntervalSec);
+  w.u32(config.alarmIntervalSec);
+  w.u32(config.trendAlertHorizonSec);
+  w.bands(config.humidityBands);
+  w.bands(config.temperatureBands);
+  w.f32(config.alertBatteryLow);
+  w.u8(config.degreesUnit);
+  w.u32(config.gmtOffsetSec);
+  w.u32(config.daylightOffsetSec);
+  w.str(config.wifiSsid);
+  w.str(config.wifiPassword);
+  for (uint8_t i = 0; i < CONFIG_NTP_SERVERS; ++i) w.str(config.ntpServers[i]);
+
+  const size_t payloadLen = w.size() - CONFIG_HEADER_BYTES;
+  if (w.size() + 4 > capacity) return 0;
+  w.at(4)[0] = payloadLen;
+  w.at(4)[1] = payloadLen >> 8;
+  w.u32(configCrc32(out, w.size()));
+  return w.size();
+}
+
+ConfigStatus configParse(const uint8_t* data, size_t len, RuntimeConfig* out) {
+  if (len < CONFIG_HEADER_BYTES + 4) return ConfigStatus::TOO_SHORT;
+  BlobReader header(data, CONFIG_HEADER_BYTES);
+  if (header.u16() != CONFIG_MAGIC) return ConfigStatus::BAD_MAGIC;
+  if (header.u8() != CONFIG_FORMAT_VERSION) return ConfigStatus::BAD_VERSION;
+  header.u8();
+  const uint16_t payloadLen = header.u16();
+  if (len < (size_t) CONFIG_HEADER_BYTES + payloadLen + 4) return ConfigStatus::TOO_SHORT;
+
+  const size_t crcAt = CONFIG_HEADER_BYTES + payloadLen;
+  BlobReader trailer(data + crcAt, 4);
+  if (trailer.u32() != configCrc32(data, crcAt)) return ConfigStatus::BAD_CRC;
+
+  RuntimeConfig config;
+  memset(&config, 0, sizeof(config));
+  BlobReader r(data + CONFIG_HEADER_BYTES, payloadLen);
+  config.sensorReadIntervalSec = r.u16();
+  config.sensorMaxIntervalSec = r.u16();
+  config.alarmIntervalSec = r.u32();
+  config.trendAlertHorizonSec = r.u32();
+  config.humidityBands = r.bands();
+  config.temperatureBands = r.bands();
+  config.alertBatteryLow = r.f32();
+  const uint8_t unit = r.u8();
+  config.degreesUnit = (DegreesUnit) unit;
+  config.gmtOffsetSec = (int32_t) r.u32();
+  config.daylightOffsetSec = (int32_t) r.u32();
+  bool stringsFit = r.str(config.wifiSsid, sizeof(config.wifiSsid))
+    && r.str(config.wifiPassword, sizeof(config.wifiPassword));
+  for (uint8_t i = 0; i < CONFIG_NTP_SERVERS; ++i) {
+    stringsFit = stringsFit && r.str(config.ntpServers[i], CONFIG_NTP_SERVER_LEN);
+  }
+  if (r.overflow) return ConfigStatus::TOO_SHORT;
+  if (!stringsFit || unit > FARENHEIT || !configValid(config)) return ConfigStatus::BAD_VALUE;
+
+  *out = config;
+  return ConfigStatus::OK;
+}
+
+uint32_t configCrc32(const uint8_t* data, size_t len) {
+  return blobCrc32(data, len);
+}
+
+ConfigCommand configParseLine(const char* line, uint8_t* blob, size_t capacity, size_t* len, ConfigStatus* status) {
+  if (strcmp(line, "#DUMP?") == 0) return ConfigCommand::DUMP;
+  if (strcmp(line, "#CFG?") == 0) return ConfigCommand::QUERY;
+  if (strncmp(line, "#CFG:", 5) != 0) return ConfigCommand::NONE;
+
+  const char* hex = line + 5;
+  const size_t hexLen = strlen(hex);
+  *len = 0;
+  *status = ConfigStatus::OK;
+  // an odd digit count or a non hex digit is a malformed line, not a short blob
+  if (hexLen % 2 != 0 || hexLen / 2 > capacity) {
+    *status = ConfigStatus::BAD_VALUE;
+    return ConfigCommand::STORE;
+  }
+  for (size_t i = 0; i < hexLen / 2; ++i) {
+    const int hi = hexDigit(hex[2 * i]);
+    const int lo = hexDigit(hex[2 * i + 1]);
+    if (hi < 0 || lo < 0) {
+      *status = ConfigStatus::BAD_VALUE;
+      return ConfigCommand::STORE;
+    }
+    blob[i] = (hi << 4) | lo;
+  }
+  *len = hexLen / 2;
+  return ConfigCommand::STORE;
+}
@@ -0,0 +1,73 @@
+#include "sensor_registry.h"
+#include <Arduino.h>
+
+bool SensorRegistry::add(HumiditySensor* sensor) {
+  if (sensorCount >= SENSOR_REGISTRY_MAX) return false;
+  sensors[sensorCount++] = sensor;
+  return true;
+}
+
+uint8_t SensorRegistry::begin() {
+  upMask = 0;
+  for (uint8_t i = 0; i < sensorCount; ++i) {
+    if (sensors[i]->begin()) upMask |= 1 << i;
+  }
+  return upMask;
+}
+
+uint8_t SensorRegistry::startAll() {
+  startedMask = 0;
+  startedAt = micros();
+  for (uint8_t i = 0; i < sensorCount; ++i) {
+    if ((upMask & (1 << i)) && sensors[i]->startConversion()) startedMask |= 1 << i;
+  }
+  return startedMask;
+}
+
+uint8_t SensorRegistry::collectAll(SensorReading* readings) {
+  uint8_t pending = startedMask;
+  uint8_t good = 0;
+  while (pending) {
+    const unsigned long elapsed = micros() - startedAt;
+    for (uint8_t i = 0; i < sensorCount; ++i) {
+      const uint8_t bit = 1 << i;
+      if (!(pending & bit)) continue;
+      if (sensors[i]->readConversion(&readings[i].temperature, &readings[i].humidity)) {
+        good |= bit;
+        pending &= ~bit;
+      } else if (elapsed > sensors[i]->conversionTimeUs() * 2) {
+        pending &= ~bit;
+      }
+    }
+    if (pending) delayMicroseconds(SENSOR_POLL_INTERVAL_US);
+  }
+  startedMask = 0;
+  return good;
+}
+
+static float medianOf(float* values, uint8_t n) {
+  // insertion sort, n <= SENSOR_REGISTRY_MAX
+  for (uint8_t i = 1; i < n; ++i) {
+    const float v = values[i];
+    uint8_t j = i;
+    for (; j > 0 && values[j - 1] > v; --j) values[j] = values[j - 1];
+    values[j] = v;
+  }
+  return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+bool SensorRegistry::fuse(const SensorReading* readings, uint8_t mask, float* temperature, float* humidity) {
+  float t[SENSOR_REGISTRY_MAX];
+  float h[SENSOR_REGISTRY_MAX];
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < SENSOR_REGISTRY_MAX; ++i) {
+    if (!(mask & (1 << i))) continue;
+    t[n] = readings[i].temperature;
+    h[n] = readings[i].humidity;
+    ++n;
+  }
+  if (n == 0) return false;
+  *temperature = medianOf(t, n);
+  *humidity = medianOf(h, n);
+  return true;
+}
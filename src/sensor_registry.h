@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include "humidity_sensor.h"
+
+#define SENSOR_REGISTRY_MAX 4
+#define SENSOR_POLL_INTERVAL_US 500
+
+struct SensorReading {
+  float temperature;
+  float humidity;
+};
+
+/*
+ Drives several sensors as one: every conversion is started before any result is collected,
+ so N sensors take about one conversion time instead of N. Sensors are referred to by their
+ registration index, results come back as bit masks over those indexes.
+*/
+class SensorRegistry {
+public:
+  // Returns false when the registry is full.
+  bool add(HumiditySensor* sensor);
+  uint8_t count() const { return sensorCount; }
+
+  // begin() on every sensor, returns the mask of the ones that responded. Only those are used.
+  uint8_t begin();
+  uint8_t up() const { return upMask; }
+  // Starts a conversion on every sensor that is up, returns the mask of the started ones.
+  uint8_t startAll();
+  // Polls the started sensors until each one answered or ran past twice its conversion time.
+  // Fills `readings` (indexed like the sensors) and returns the mask of good readings.
+  uint8_t collectAll(SensorReading* readings);
+
+  // Median of the good readings per channel, the mean of the middle two for an even count.
+  // From three good readings on a single bad sensor can not drag the result; with two there
+  // is no majority and it is their plain mean. False when there is no good reading.
+  static bool fuse(const SensorReading* readings, uint8_t mask, float* temperature, float* humidity);
+
+private:
+  HumiditySensor* sensors[SENSOR_REGISTRY_MAX];
+  uint8_t sensorCount = 0;
+  uint8_t upMask = 0;
+  uint8_t startedMask = 0;
+  unsigned long startedAt = 0;
+};
@@ -0,0 +1,48 @@
+#include "sht3x.h"
+#include <Arduino.h>
+
+#define SHT3X_CMD_SINGLE_SHOT_HIGH 0x2400 // high repeatability, clock stretching disabled
+#define SHT3X_CMD_CLEAR_STATUS 0x3041
+#define SHT3X_CONVERSION_US 15500 // max, high repeatability
+
+bool Sht3x::command(uint16_t cmd) {
+  const uint8_t data[2] = { (uint8_t)(cmd >> 8), (uint8_t)cmd };
+  return bus.write(address, data, sizeof(data));
+}
+
+bool Sht3x::begin() {
+  return command(SHT3X_CMD_CLEAR_STATUS);
+}
+
+bool Sht3x::startConversion() {
+  return command(SHT3X_CMD_SINGLE_SHOT_HIGH);
+}
+
+uint32_t Sht3x::conversionTimeUs() const {
+  return SHT3X_CONVERSION_US;
+}
+
+bool Sht3x::readConversion(float* temperature, float* humidity) {
+  // T msb, T lsb, T crc, RH msb, RH lsb, RH crc
+  uint8_t data[6];
+  if (!bus.read(address, data, sizeof(data))) return false;
+  if (crc8(data, 2) != data[2] || crc8(data + 3, 2) != data[5]) return false;
+
+  const uint16_t tCode = (data[0] << 8) | data[1];
+  const uint16_t rhCode = (data[3] << 8) | data[4];
+  *temperature = 175.0f * tCode / 65535.0f - 45.0f;
+  *humidity = constrain(100.0f * rhCode / 65535.0f, 0.0f, 100.0f);
+  return true;
+}
+
+uint8_t Sht3x::crc8(const uint8_t* data, uint8_t len) {
+  // x^8 + x^5 + x^4 + 1, initialized with 0xFF
+  uint8_t crc = 0xFF;
+  for (uint8_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+    }
+  }
+  return crc;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include "humidity_sensor.h"
+#include "i2c_bus.h"
+
+#define SHT3X_ADDRESS 0x44 // 0x45 with ADDR pulled high
+
+/*
+ SHT30/31/35 driver, single shot high repeatability measurements without clock stretching
+ (ref: Sensirion SHT3x-DIS datasheet, table 9). The sensor NACKs reads until the conversion
+ is done, like the Si7021 in no-hold mode, so the bus is free while it converts.
+*/
+class Sht3x : public HumiditySensor {
+public:
+  Sht3x(I2CBus& bus, uint8_t address = SHT3X_ADDRESS) : bus(bus), address(address) {}
+
+  // Clears the status register, returns false if the sensor does not respond.
+  bool begin() override;
+  bool startConversion() override;
+  uint32_t conversionTimeUs() const override;
+  bool readConversion(float* temperature, float* humidity) override;
+
+  static uint8_t crc8(const uint8_t* data, uint8_t len);
+
+private:
+  I2CBus& bus;
+  uint8_t address;
+
+  bool command(uint16_t cmd);
+};
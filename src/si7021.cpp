@@ -0,0 +1,86 @@
+#include "si7021.h"
+#include <Arduino.h>
+
+#define SI7021_CMD_MEASURE_RH_NO_HOLD 0xF5
+#define SI7021_CMD_READ_PREV_TEMP 0xE0
+#define SI7021_CMD_WRITE_USER_REG 0xE6
+#define SI7021_CMD_READ_USER_REG 0xE7
+#define SI7021_USER_REG_RES_MASK 0x81
+#define SI7021_USER_REG_HEATER 0x04
+#define SI7021_POLL_INTERVAL_US 500
+
+bool Si7021::command(uint8_t cmd) {
+  return bus.write(address, &cmd, 1);
+}
+
+bool Si7021::begin(Si7021Resolution res) {
+  uint8_t reg;
+  if (!command(SI7021_CMD_READ_USER_REG) || !bus.read(address, &reg, 1)) {
+    return false;
+  }
+  // keep the reserved bits as read, only touch resolution and heater
+  const uint8_t wanted = (reg & ~(SI7021_USER_REG_RES_MASK | SI7021_USER_REG_HEATER)) | (uint8_t)res;
+  if (wanted != reg) {
+    const uint8_t write[2] = { SI7021_CMD_WRITE_USER_REG, wanted };
+    if (!bus.write(address, write, sizeof(write))) return false;
+  }
+  resolution = res;
+  return true;
+}
+
+bool Si7021::startConversion() {
+  conversionStartedAt = micros();
+  return command(SI7021_CMD_MEASURE_RH_NO_HOLD);
+}
+
+uint32_t Si7021::conversionTimeUs() const {
+  // max RH conversion time + max temperature conversion time, ref/Si7021-A20.pdf table 2
+  switch (resolution) {
+    case Si7021Resolution::RH8_T12:  return 3100 + 3800;
+    case Si7021Resolution::RH10_T13: return 4500 + 6200;
+    case Si7021Resolution::RH11_T11: return 7000 + 2400;
+    case Si7021Resolution::RH12_T14:
+    default:                         return 12000 + 10800;
+  }
+}
+
+bool Si7021::readConversion(float* temperature, float* humidity) {
+  uint8_t rh[3];
+  // the sensor NACKs its address until the conversion is done
+  if (!bus.read(address, rh, sizeof(rh))) return false;
+  if (crc8(rh, 2) != rh[2]) return false;
+
+  uint8_t t[2];
+  if (!command(SI7021_CMD_READ_PREV_TEMP) || !bus.read(address, t, sizeof(t))) return false;
+
+  const uint16_t rhCode = (rh[0] << 8) | rh[1];
+  const uint16_t tCode = (t[0] << 8) | t[1];
+  *humidity = constrain(125.0f * rhCode / 65536.0f - 6.0f, 0.0f, 100.0f);
+  *temperature = 175.72f * tCode / 65536.0f - 46.85f;
+  return true;
+}
+
+bool Si7021::awaitConversion(float* temperature, float* humidity) {
+  const uint32_t timeout = conversionTimeUs() * 2;
+  while (!readConversion(temperature, humidity)) {
+    if (micros() - conversionStartedAt > timeout) return false;
+    delayMicroseconds(SI7021_POLL_INTERVAL_US);
+  }
+  return true;
+}
+
+bool Si7021::measure(float* temperature, float* humidity) {
+  return startConversion() && awaitConversion(temperature, humidity);
+}
+
+uint8_t Si7021::crc8(const uint8_t* data, uint8_t len) {
+  // x^8 + x^5 + x^4 + 1, initialized with 0x00
+  uint8_t crc = 0x00;
+  for (uint8_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+    }
+  }
+  return crc;
+}
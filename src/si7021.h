@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include "humidity_sensor.h"
+#include "i2c_bus.h"
+
+#define SI7021_ADDRESS 0x40
+
+// User register 1 resolution bits (D7, D0), see ref/Si7021-A20.pdf, table 15
+enum class Si7021Resolution : uint8_t {
+  RH12_T14 = 0x00,
+  RH8_T12  = 0x01,
+  RH10_T13 = 0x80,
+  RH11_T11 = 0x81,
+};
+
+/*
+ Si7021 driver that acquires both channels with a single conversion.
+
+ Every relative humidity conversion also measures temperature (for the RH compensation), and
+ the result can be fetched with "read temperature value from previous RH measurement" (0xE0)
+ without converting again. Conversions are started in no-hold master mode, so the bus is free
+ while the sensor converts and the caller decides whether to block or do something else.
+*/
+class Si7021 : public HumiditySensor {
+public:
+  Si7021(I2CBus& bus, uint8_t address = SI7021_ADDRESS, Si7021Resolution resolution = Si7021Resolution::RH12_T14)
+    : bus(bus), address(address), resolution(resolution) {}
+
+  // Sets the resolution and turns the heater off, returns false if the sensor does not respond.
+  bool begin(Si7021Resolution resolution);
+  // begin() with the resolution given to the constructor.
+  bool begin() override { return begin(resolution); }
+  // Starts an RH (+ temperature) conversion and returns immediately.
+  bool startConversion() override;
+  // Worst case time from startConversion() until the result is ready.
+  uint32_t conversionTimeUs() const override;
+  // Reads the RH result and the temperature measured along with it. Returns false while the
+  // sensor is still converting, or on a bus/checksum error.
+  bool readConversion(float* temperature, float* humidity) override;
+  // Waits for the conversion started by startConversion() and reads it, returns false on timeout.
+  bool awaitConversion(float* temperature, float* humidity);
+  // Blocking startConversion() + awaitConversion().
+  bool measure(float* temperature, float* humidity);
+
+  static uint8_t crc8(const uint8_t* data, uint8_t len);
+
+private:
+  I2CBus& bus;
+  uint8_t address;
+  Si7021Resolution resolution;
+  unsigned long conversionStartedAt = 0;
+
+  bool command(uint8_t cmd);
+};
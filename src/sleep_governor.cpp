@@ -0,0 +1,45 @@
+#include "sleep_governor.h"
+
+#include <Preferences.h>
+#include "log.h"
+
+#define SLEEP_NVS_NAMESPACE "sleep"
+#define SLEEP_NVS_KEY "coldwake"
+#define SLEEP_COLD_WAKE_WEIGHT 8 // 1/8 of each new sample goes into the average
+#define SLEEP_STORE_DRIFT_PERCENT 20
+
+void SleepGovernor::recordColdWake(uint32_t startupUs, uint32_t bringUpUs) {
+  const uint32_t sample = startupUs + bringUpUs + SLEEP_ROM_BOOT_US;
+  if (samples == 0) {
+    coldWakeUs = sample;
+  } else {
+    coldWakeUs += ((int32_t) sample - (int32_t) coldWakeUs) / SLEEP_COLD_WAKE_WEIGHT;
+  }
+  if (samples < UINT16_MAX) ++samples;
+
+  const uint32_t drift = coldWakeUs > storedColdWakeUs ? coldWakeUs - storedColdWakeUs : storedColdWakeUs - coldWakeUs;
+  if (samples >= SLEEP_COLD_WAKE_WEIGHT && drift * 100 > storedColdWakeUs * SLEEP_STORE_DRIFT_PERCENT) {
+    store();
+  }
+}
+
+void SleepGovernor::load() {
+  Preferences prefs;
+  if (!prefs.begin(SLEEP_NVS_NAMESPACE, true)) return;
+  const uint32_t stored = prefs.getUInt(SLEEP_NVS_KEY, 0);
+  prefs.end();
+  if (stored > 0) {
+    coldWakeUs = stored;
+    storedColdWakeUs = stored;
+    samples = 1; // averaging continues from the stored value
+  }
+}
+
+void SleepGovernor::store() {
+  Preferences prefs;
+  if (!prefs.begin(SLEEP_NVS_NAMESPACE, false)) return;
+  prefs.putUInt(SLEEP_NVS_KEY, coldWakeUs);
+  prefs.end();
+  storedColdWakeUs = coldWakeUs;
+  LOG_INFO(SLEEP_BREAK_EVEN, coldWakeUs, (uint32_t) (breakEvenUs() / MICROSECONDS_PER_MILLISECOND));
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+ Picks light or deep sleep for the gap until the next work.
+
+ Deep sleep draws less, but every wakeup from it reboots: ROM + bootloader, static
+ constructors, and bringing up again whatever peripherals the wakeup needs. Light sleep keeps
+ RAM, peripheral state and the display object, at a higher sleep current. Light sleep wins
+ while
+   gap * (light sleep current - deep sleep current) < cold wake time * awake current
+ The cold wake time is measured on every wakeup that came out of deep sleep (app startup
+ before setup() + peripheral bring-up, plus SLEEP_ROM_BOOT_US the firmware can not see) and
+ averaged. The learned value goes to NVS so a power cycle does not start from the default.
+*/
+class SleepGovernor {
+public:
+  SleepGovernor(bool initial) {
+    if (initial) {
+      coldWakeUs = SLEEP_COLD_WAKE_DEFAULT_US;
+      storedColdWakeUs = 0;
+      samples = 0;
+    }
+  }
+
+  // Takes over the value learned before the last power cycle, call once NVS is up (cold boot).
+  void load();
+
+  // `startupUs` is micros() when setup() started, `bringUpUs` the time spent bringing up peripherals.
+  void recordColdWake(uint32_t startupUs, uint32_t bringUpUs);
+
+  uint32_t coldWakeTimeUs() const {
+    return coldWakeUs;
+  }
+
+  // Gaps shorter than this cost less charge in light sleep.
+  uint64_t breakEvenUs() const {
+    return (uint64_t) coldWakeUs * (CURRENT_AWAKE_MA * 1000.0f) / (CURRENT_LIGHT_SLEEP_UA - CURRENT_SLEEP_UA);
+  }
+
+  bool preferLightSleep(uint64_t gapUs) const {
+    return SLEEP_LIGHT_ENABLED && gapUs < breakEvenUs();
+  }
+
+  // Gap to plan the sleep for, `untilWorkSec` after the wakeup ran. Work still due then means
+  // it failed (no sensor, no reading, no time), and so does anything `pending`: both retry on
+  // the regular wakeup interval instead of waking again right away.
+  static uint64_t gapUs(int64_t untilWorkSec, bool pending, uint64_t wakeupIntervalUs) {
+    if (pending || untilWorkSec <= 0) return wakeupIntervalUs;
+    return (uint64_t) untilWorkSec * MICROSECONDS_PER_SECOND;
+  }
+
+private:
+  uint32_t coldWakeUs;
+  uint32_t storedColdWakeUs; // what NVS holds, to write only when it moved noticeably
+  uint16_t samples;
+
+  void store();
+};
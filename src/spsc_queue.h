@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/*
+ Lock-free single producer / single consumer queue of fixed capacity. One task pushes, one
+ other task pops; each index is only written by its own side and published with release
+ semantics, so the item copy is visible before the index that announces it. Neither side
+ blocks, waiting is left to the caller (task notifications in RenderPipeline).
+*/
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "capacity has to be a power of two");
+
+public:
+  // Producer side. False when the queue is full.
+  bool push(const T& item) {
+    const size_t write = writeIndex.load(std::memory_order_relaxed);
+    if (write - readIndex.load(std::memory_order_acquire) == N) return false;
+    items[write & (N - 1)] = item;
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. False when the queue is empty.
+  bool pop(T* item) {
+    const size_t read = readIndex.load(std::memory_order_relaxed);
+    if (writeIndex.load(std::memory_order_acquire) == read) return false;
+    *item = items[read & (N - 1)];
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return writeIndex.load(std::memory_order_acquire) == readIndex.load(std::memory_order_acquire);
+  }
+
+private:
+  T items[N];
+  std::atomic<size_t> writeIndex{0};
+  std::atomic<size_t> readIndex{0};
+};
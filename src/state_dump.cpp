@@ -0,0 +1,56 @@
+#include "state_dump.h"
+
+#include <Arduino.h>
+#include "log.h"
+
+size_t cobsEncode(const uint8_t* data, size_t len, uint8_t* out) {
+  size_t codeAt = 0; // where the length code of the current block goes
+  size_t pos = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; ++i) {
+    if (data[i] != 0) {
+      out[pos++] = data[i];
+      ++code;
+    }
+    if (data[i] == 0 || code == 0xFF) {
+      out[codeAt] = code;
+      codeAt = pos++;
+      code = 1;
+    }
+  }
+  out[codeAt] = code;
+  return pos;
+}
+
+bool stateDumpSend(void (*writePayload)(BlobWriter& w)) {
+  static uint8_t frame[STATE_DUMP_MAX_BYTES];
+  static uint8_t encoded[STATE_DUMP_MAX_BYTES + STATE_DUMP_MAX_BYTES / 254 + 1];
+
+  BlobWriter w(frame, sizeof(frame));
+  w.u16(STATE_DUMP_MAGIC);
+  w.u8(STATE_DUMP_FORMAT_VERSION);
+  w.u8(0);
+  w.u16(0); // payload length, patched below
+  writePayload(w);
+  const size_t payloadLen = w.size() - STATE_DUMP_HEADER_BYTES;
+  w.u32(0);
+  if (w.overflow()) {
+    LOG_ERROR(STATE_DUMP_OVERFLOW, w.size());
+    return false;
+  }
+  const size_t frameLen = w.size();
+  frame[4] = payloadLen;
+  frame[5] = payloadLen >> 8;
+  const uint32_t crc = blobCrc32(frame, frameLen - 4);
+  for (uint8_t i = 0; i < 4; ++i) frame[frameLen - 4 + i] = crc >> (8 * i);
+
+  const size_t encodedLen = cobsEncode(frame, frameLen, encoded);
+  Serial.begin(LOG_SERIAL_BAUD);
+  Serial.print(F("#DUMP:"));
+  Serial.write(encoded, encodedLen);
+  Serial.write((uint8_t) 0);
+  Serial.println();
+  Serial.flush();
+  LOG_INFO(STATE_DUMP, frameLen);
+  return true;
+}
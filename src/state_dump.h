@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "blob_io.h"
+
+#define STATE_DUMP_MAGIC 0x5344 // "SD"
+#define STATE_DUMP_FORMAT_VERSION 1
+#define STATE_DUMP_HEADER_BYTES 6
+#define STATE_DUMP_MAX_BYTES 1536
+
+/*
+ Binary snapshot of everything the device has collected, requested with "#DUMP?" in the serial
+ window or by holding the button on wakeup. About 1.2kb for a full year of history, ~0.1s on
+ the wire at 115200 baud. tools/state_dump.py reads and decodes it.
+
+ Frame, all integers little endian:
+   header:  magic u16 | format version u8 | reserved u8 | payload length u16
+   payload: wakeup counter u32 | unix time u32 | temperature alert u8 | humidity alert u8
+            compact type signed u8 | last collected at u32 | 5 x seconds since tier push u32
+            12 buffers (current T/H, hour T/H .. year T/H): capacity u8 | count u8 | count x u16, oldest first
+            temperature current u16 | 1d, 1w, 1m x (average, median, max, min) u16
+            humidity current u16 | 1d, 1w, 1m x (average, median, max, min) u16
+            temperature exposure 1d, 1w, 1m x (mean, stddev, out of band %, danger %) f32
+            humidity exposure 1d, 1w, 1m x (mean, stddev, out of band %, danger %) f32
+   trailer: crc32 (zlib) of header + payload
+
+ On the wire the frame is COBS encoded, so it contains no zero bytes, and sent as
+ "#DUMP:" <encoded frame> 0x00 "\n" - the zero ends the frame, text lines around it stay intact.
+*/
+
+// Encodes `len` bytes into `out` which must hold len + len / 254 + 1 bytes, returns the encoded length.
+size_t cobsEncode(const uint8_t* data, size_t len, uint8_t* out);
+
+// Frames what `writePayload` writes and sends it over serial. False when it did not fit.
+bool stateDumpSend(void (*writePayload)(BlobWriter& w));
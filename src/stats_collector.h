@@ -1,14 +1,21 @@
 #pragma once
 
 #include <Arduino.h>
-#include <RingBuf.h>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <AceSorting.h>
 
 #include "HardwareSerial.h"
 #include "common_types.h"
 #include "esp32-hal.h"
 #include "settings.h"
+#include "trend_window.h"
+#include "period_metrics.h"
+#include "alerts.h"
+#include "runtime_config.h"
+#include "blob_io.h"
+#include "ring_buffer.h"
 
 
 enum class UpdateFlags : uint16_t {
@@ -59,6 +66,23 @@ static inline float unpack(compact_t value) {
   return (float) value / 100.0;
 }
 
+// Fills tier slots that have no readings, e.g. while the device was off. Never a real value,
+// it would be 655.35 (327.67 signed) degrees or percent.
+template <typename compact_t>
+static inline constexpr compact_t historyGap() {
+  return std::numeric_limits<compact_t>::max();
+}
+
+// Drops the gap markers from `values` in place, returns how many values are left.
+template <typename compact_t>
+static inline uint16_t withoutGaps(compact_t* values, uint16_t count) {
+  uint16_t kept = 0;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (values[i] != historyGap<compact_t>()) values[kept++] = values[i];
+  }
+  return kept;
+}
+
 template <typename compact_t>
 static inline MeasurementStatistics<float> unpack(MeasurementStatistics<compact_t> value) {
   return MeasurementStatistics<float> {
@@ -69,22 +93,20 @@ static inline MeasurementStatistics<float> unpack(MeasurementStatistics<compact_
   };
 }
 
-template<typename T, long S>
-MeasurementStatistics<T> calculateStatistics(RingBuf<T, S>& buffer, long onlyOldestNEntries = S) {
+template<typename T>
+MeasurementStatistics<T> calculateStatistics(T* values, uint16_t count) {
     MeasurementStatistics<T> stats = {0, 0, 0, 0};
-    if (buffer.isEmpty()) {
+    if (count == 0) {
         return stats;
     }
 
-    uint16_t bufferSize = std::min(static_cast<uint16_t>(buffer.size()), static_cast<uint16_t>(onlyOldestNEntries));
-    T tempArray[bufferSize];  // Adjusted size for median calculation
     long sum = 0;
-    T maxValue = buffer[0];
-    T minValue = buffer[0];
+    T maxValue = values[0];
+    T minValue = values[0];
 
-    // Iterating through the buffer to calculate sum, max, and min
-    for (uint16_t i = 0; i < bufferSize; ++i) {
-        T currentValue = buffer[i];
+    // Iterating through the values to calculate sum, max, and min
+    for (uint16_t i = 0; i < count; ++i) {
+        T currentValue = values[i];
         sum += currentValue;
         if (currentValue > maxValue) {
             maxValue = currentValue;
@@ -92,30 +114,46 @@ MeasurementStatistics<T> calculateStatistics(RingBuf<T, S>& buffer, long onlyOld
         if (currentValue < minValue) {
             minValue = currentValue;
         }
-        tempArray[i] = currentValue;  // Copying data for median calculation
     }
 
     // Set avg, max and min
-    stats.average = sum / bufferSize;
+    stats.average = sum / count;
     stats.max = maxValue;
     stats.min = minValue;
 
-    // Calculate median
-    ace_sorting::shellSortKnuth(tempArray, bufferSize);
-    uint16_t middle = bufferSize / 2;
-    if (bufferSize % 2 != 0) {
-        stats.median = tempArray[middle];
+    // Calculate median, sorts `values` in place
+    ace_sorting::shellSortKnuth(values, count);
+    uint16_t middle = count / 2;
+    if (count % 2 != 0) {
+        stats.median = values[middle];
     } else {
-        stats.median = (tempArray[middle - 1] + tempArray[middle]) / 2;
+        stats.median = (values[middle - 1] + values[middle]) / 2;
     }
     return stats;
 }
 
+template<typename T, long S>
+MeasurementStatistics<T> calculateStatistics(RingBuffer<T, S>& buffer, long onlyOldestNEntries = S) {
+    T tempArray[S];  // copied for the median, two memcpy of the contiguous spans
+    const uint16_t count = buffer.copyTo(tempArray, std::min(static_cast<long>(buffer.size()), onlyOldestNEntries));
+    return calculateStatistics(tempArray, count);
+}
+
+struct TimedReading {
+  time_t at; // unix time, same clock as collect() uses
+  float temperature;
+  float humidity;
+};
+
 template <typename compact_t>
 class StatsCollector {
 public:
   StatsCollector(bool initial) : state([]() -> bool { return esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_UNDEFINED; }) {
     if (initial) {
+      state.trendT.clear();
+      state.trendH.clear();
+      state.metricsT.clear();
+      state.metricsH.clear();
       // prepare to push as soon as the previous buffer is full
       state.timeSinceLastHourBufPush = hourBufPushInterval - 1;
       state.timeSinceLastDayBufPush = dayBufPushInterval - 1;
@@ -125,46 +163,182 @@ public:
     }
   }
 
-  void printDebug() {
-    auto time = micros();
+  // Writes the whole state in the state dump layout, see state_dump.h
+  void dump(BlobWriter& w) {
+    w.u8(std::is_signed<compact_t>::value);
+    w.u32(state.lastCollectedAtUnixTimeSec);
+    w.u32(state.timeSinceLastHourBufPush);
+    w.u32(state.timeSinceLastDayBufPush);
+    w.u32(state.timeSinceLastWeekBufPush);
+    w.u32(state.timeSinceLastMonthBufPush);
+    w.u32(state.timeSinceLastYearBufPush);
+    dump(w, state.currentReadingBufT);
+    dump(w, state.currentReadingBufH);
+    dump(w, state.hourBufT);
+    dump(w, state.hourBufH);
+    dump(w, state.dayBufT);
+    dump(w, state.dayBufH);
+    dump(w, state.weekBufT);
+    dump(w, state.weekBufH);
+    dump(w, state.monthBufT);
+    dump(w, state.monthBufH);
+    dump(w, state.yearBufT);
+    dump(w, state.yearBufH);
+    w.u16(state.statsTempCurrent);
+    dump(w, state.statsTemp1D);
+    dump(w, state.statsTemp1W);
+    dump(w, state.statsTemp1M);
+    w.u16(state.statsHumidityCurrent);
+    dump(w, state.statsHumidity1D);
+    dump(w, state.statsHumidity1W);
+    dump(w, state.statsHumidity1M);
+    dump(w, exposureTemp1D());
+    dump(w, exposureTemp1W());
+    dump(w, exposureTemp1M());
+    dump(w, exposureHumidity1D());
+    dump(w, exposureHumidity1W());
+    dump(w, exposureHumidity1M());
+  }
 
-    Serial.println("====== Stats Collector Debug Info ======");
-    Serial.print("lastCollectedAtUnixTimeSec: "); Serial.println(state.lastCollectedAtUnixTimeSec);
-    printDebug<CURRENT_READING_MEDIAN_FILTER_SIZE>("currentReadingBufT", state.currentReadingBufT);
-    printDebug<CURRENT_READING_MEDIAN_FILTER_SIZE>("currentReadingBufH", state.currentReadingBufH);
-    printDebug<PX_PER_1H>("hourBufT", state.hourBufT);
-    printDebug<PX_PER_1H>("hourBufH", state.hourBufH);
-    printDebug<PX_PER_23H>("dayBufT", state.dayBufT);
-    printDebug<PX_PER_23H>("dayBufH", state.dayBufH);
-    printDebug<PX_PER_6D> ("weekBufT", state.weekBufT);
-    printDebug<PX_PER_6D> ("weekBufH", state.weekBufH);
-    printDebug<PX_PER_23D>("monthBufT", state.monthBufT);
-    printDebug<PX_PER_23D>("monthBufH", state.monthBufH);
-    printDebug<PX_PER_11M>("yearBufT", state.yearBufT);
-    printDebug<PX_PER_11M>("yearBufH", state.yearBufH);
+  UpdateFlags collect(float temperature, float humidity) {
+    return collect(temperature, humidity, time(nullptr));
+  }
 
-    time = micros() - time;
-    Serial.print("StatsCollector::printDebug took "); Serial.print(time); Serial.println(" microseconds.");
-    Serial.println("==== End Stats Collector Debug Info ====");
+  UpdateFlags collect(float temperature, float humidity, time_t now) {
+    return finishIngest(ingest(temperature, humidity, now));
   }
 
-  UpdateFlags collect(float temperature, float humidity) {
-    state.currentReadingBufT.pushOverwrite(pack<compact_t>(temperature));
-    state.currentReadingBufH.pushOverwrite(pack<compact_t>(humidity));
+  // Replays timestamped readings (oldest first), e.g. to rebuild the tiers from archived raw
+  // readings. Ends in the same state as calling collect() for each of them, but the period
+  // statistics - the expensive part, six sorts per hour tier push - are only computed when a
+  // later reading is about to change their inputs, and once at the end. Returns the union of
+  // the flags the single calls would have returned.
+  UpdateFlags collectBatch(const TimedReading* readings, size_t count) {
+    UpdateFlags updateFlags = UpdateFlags::NONE;
+    for (size_t i = 0; i < count; ++i) {
+      updateFlags |= ingest(readings[i].temperature, readings[i].humidity, readings[i].at);
+    }
+    return finishIngest(updateFlags);
+  }
+
+  // The wall clock was set (time sync) and jumped by `stepSec`. Moves the last reading onto the
+  // new clock, so the next one is weighted by the time that really passed: a forward jump is
+  // not a gap in the history, a backward one not negative time.
+  void clockStepped(time_t stepSec) {
+    if (state.lastCollectedAtUnixTimeSec != 0) {
+      state.lastCollectedAtUnixTimeSec += stepSec;
+    }
+  }
+
+  void currentReadingMedian(float* temp, float* humidity) {
+    *temp = unpack(state.statsTempCurrent);
+    *humidity = unpack(state.statsHumidityCurrent);
+  }
+
+  // Slope of the least-squares line over the hour tier, in units per hour, NAN until the tier
+  // has TREND_MIN_POINTS entries.
+  float trendTempPerHour() {
+    return trendPerHour(state.trendT);
+  }
+
+  float trendHumidityPerHour() {
+    return trendPerHour(state.trendH);
+  }
+
+  MeasurementStatistics<float> statsTemp1D() {
+    return unpack(state.statsTemp1D);
+  }
+
+  MeasurementStatistics<float> statsTemp1W() {
+    return unpack(state.statsTemp1W);
+  }
+
+  MeasurementStatistics<float> statsTemp1M() {
+    return unpack(state.statsTemp1M);
+  }
+
+  MeasurementStatistics<float> statsHumidity1D() {
+    return unpack(state.statsHumidity1D);
+  }
+
+  MeasurementStatistics<float> statsHumidity1W() {
+    return unpack(state.statsHumidity1W);
+  }
+
+  MeasurementStatistics<float> statsHumidity1M() {
+    return unpack(state.statsHumidity1M);
+  }
+
+  ExposureStatistics<float> exposureTemp1D() {
+    return state.metricsT.dayStatistics();
+  }
+
+  ExposureStatistics<float> exposureTemp1W() {
+    return state.metricsT.weekStatistics();
+  }
+
+  ExposureStatistics<float> exposureTemp1M() {
+    return state.metricsT.monthStatistics();
+  }
+
+  ExposureStatistics<float> exposureHumidity1D() {
+    return state.metricsH.dayStatistics();
+  }
+
+  ExposureStatistics<float> exposureHumidity1W() {
+    return state.metricsH.weekStatistics();
+  }
+
+  ExposureStatistics<float> exposureHumidity1M() {
+    return state.metricsH.monthStatistics();
+  }
+
+  HistoryView historyViewT(HistoryRange range = HistoryRange::COMPOSITE) {
+    return HistoryView { this, historyAtT, historySize(range), range };
+  }
+
+  HistoryView historyViewH(HistoryRange range = HistoryRange::COMPOSITE) {
+    return HistoryView { this, historyAtH, historySize(range), range };
+  }
+
+private:
+  UpdateFlags ingest(float temperature, float humidity, time_t now) {
+    // the very first reading has nothing to be weighted against, and a clock that went back
+    // without clockStepped() says nothing about the time in between
+    time_t elapsedTimeSec = now - state.lastCollectedAtUnixTimeSec;
+    if (state.lastCollectedAtUnixTimeSec == 0 || elapsedTimeSec <= 0) {
+      elapsedTimeSec = SENSOR_READ_INTERVAL_SEC;
+    }
+    state.lastCollectedAtUnixTimeSec = now;
+
+    // readings can come at a variable rate (see AdaptiveSampler), weight each one by the number
+    // of base intervals it stands for so the median filter and the hour tier stay time-weighted
+    const long weight = constrain((elapsedTimeSec + SENSOR_READ_INTERVAL_SEC / 2) / SENSOR_READ_INTERVAL_SEC, 1, CURRENT_READING_MEDIAN_FILTER_SIZE);
+    UpdateFlags updateFlags = UpdateFlags::NONE;
+    // after a long gap (device off, RTC lost power) the reading only stands for one interval,
+    // the tiers skip the rest of the time instead of stretching the last values over it
+    if (elapsedTimeSec > HISTORY_GAP_SEC) {
+      updateFlags |= skipGap(elapsedTimeSec - SENSOR_READ_INTERVAL_SEC);
+      elapsedTimeSec = SENSOR_READ_INTERVAL_SEC;
+    }
+    for (long i = 0; i < weight; ++i) {
+      state.currentReadingBufT.pushOverwrite(pack<compact_t>(temperature));
+      state.currentReadingBufH.pushOverwrite(pack<compact_t>(humidity));
+    }
+    // time-weighted metrics see every reading, over the time it stands for
+    const AlertBands& tb = config.temperatureBands;
+    const AlertBands& hb = config.humidityBands;
+    state.metricsT.add(temperature, bandLevel(temperature, tb.dangerLow, tb.warningLow, tb.warningHigh, tb.dangerHigh), elapsedTimeSec);
+    state.metricsH.add(humidity, bandLevel(humidity, hb.dangerLow, hb.warningLow, hb.warningHigh, hb.dangerHigh), elapsedTimeSec);
+
     auto prevTemp = state.statsTempCurrent;
     auto prevHumidity = state.statsHumidityCurrent;
     state.statsTempCurrent = state.currentReadingBufT[state.currentReadingBufT.size() - 1];
     state.statsHumidityCurrent = state.currentReadingBufH[state.currentReadingBufH.size() - 1];
-    UpdateFlags updateFlags = UpdateFlags::NONE;
     if (state.statsTempCurrent != prevTemp || state.statsHumidityCurrent != prevHumidity) {
       updateFlags |= UpdateFlags::CURRENT_READING;
     }
 
-    time_t now;
-    time(&now);
-    time_t elapsedTimeSec = now - state.lastCollectedAtUnixTimeSec;
-    state.lastCollectedAtUnixTimeSec = now;
-
     // push readings only if the previous buffers are full
     state.timeSinceLastHourBufPush += elapsedTimeSec * state.currentReadingBufT.isFull();
     state.timeSinceLastDayBufPush += elapsedTimeSec * state.hourBufT.isFull();
@@ -172,138 +346,149 @@ public:
     state.timeSinceLastMonthBufPush += elapsedTimeSec * state.weekBufT.isFull();
     state.timeSinceLastYearBufPush += elapsedTimeSec * state.monthBufT.isFull();
 
+    // a widened read interval can span several hour slots, fill each of them
     if (state.timeSinceLastHourBufPush >= hourBufPushInterval) {
-      state.timeSinceLastHourBufPush -= hourBufPushInterval;
-      state.hourBufT.pushOverwrite(calculateStatistics<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE>(state.currentReadingBufT).median);
-      state.hourBufH.pushOverwrite(calculateStatistics<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE>(state.currentReadingBufH).median);
+      const compact_t hourT = calculateStatistics<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE>(state.currentReadingBufT).median;
+      const compact_t hourH = calculateStatistics<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE>(state.currentReadingBufH).median;
+      for (uint8_t i = 0; i < PX_PER_1H && state.timeSinceLastHourBufPush >= hourBufPushInterval; ++i) {
+        state.timeSinceLastHourBufPush -= hourBufPushInterval;
+        // the trend restarts after a gap, once it is full it mirrors the whole hour tier again
+        const bool full = state.trendT.size() == PX_PER_1H;
+        state.trendT.push(hourT, full, full ? state.hourBufT.oldest() : 0);
+        state.trendH.push(hourH, full, full ? state.hourBufH.oldest() : 0);
+        state.hourBufT.pushOverwrite(hourT);
+        state.hourBufH.pushOverwrite(hourH);
+      }
+      state.timeSinceLastHourBufPush = std::min(state.timeSinceLastHourBufPush, (time_t)hourBufPushInterval - 1);
       updateFlags |= UpdateFlags::HISTORY_HOUR;
     }
 
+    // a batch defers the period statistics, they have to be taken before a later reading moves
+    // the lower tiers under them
+    if (statsPending && !isFlagSet(updateFlags, UpdateFlags::HISTORY_HOUR) && (state.timeSinceLastDayBufPush >= dayBufPushInterval
+        || state.timeSinceLastWeekBufPush >= weekBufPushInterval || state.timeSinceLastMonthBufPush >= monthBufPushInterval)) {
+      updateFlags |= updatePeriodStats();
+    }
+
     if (state.timeSinceLastDayBufPush >= dayBufPushInterval) {
       state.timeSinceLastDayBufPush -= dayBufPushInterval;
-      state.dayBufT.pushOverwrite(calculateStatistics<compact_t, PX_PER_1H>(state.hourBufT, 30/2).median);
-      state.dayBufH.pushOverwrite(calculateStatistics<compact_t, PX_PER_1H>(state.hourBufH, 30/2).median);
+      state.dayBufT.pushOverwrite(tierMedian(state.hourBufT, 30/2));
+      state.dayBufH.pushOverwrite(tierMedian(state.hourBufH, 30/2));
       updateFlags |= UpdateFlags::HISTORY_DAY;
     }
 
     if (state.timeSinceLastWeekBufPush >= weekBufPushInterval) {
       state.timeSinceLastWeekBufPush -= weekBufPushInterval;
-      state.weekBufT.pushOverwrite(calculateStatistics<compact_t, PX_PER_23H>(state.dayBufT, 4*60/30).median);
-      state.weekBufH.pushOverwrite(calculateStatistics<compact_t, PX_PER_23H>(state.dayBufH, 4*60/30).median);
+      state.weekBufT.pushOverwrite(tierMedian(state.dayBufT, 4*60/30));
+      state.weekBufH.pushOverwrite(tierMedian(state.dayBufH, 4*60/30));
       updateFlags |= UpdateFlags::HISTORY_WEEK;
     }
 
     if (state.timeSinceLastMonthBufPush >= monthBufPushInterval) {
       state.timeSinceLastMonthBufPush -= monthBufPushInterval;
-      state.monthBufT.pushOverwrite(calculateStatistics<compact_t, PX_PER_6D>(state.weekBufT, 8/4).median);
-      state.monthBufH.pushOverwrite(calculateStatistics<compact_t, PX_PER_6D>(state.weekBufH, 8/4).median);
+      state.monthBufT.pushOverwrite(tierMedian(state.weekBufT, 8/4));
+      state.monthBufH.pushOverwrite(tierMedian(state.weekBufH, 8/4));
       updateFlags |= UpdateFlags::HISTORY_MONTH;
     }
 
     if (state.timeSinceLastYearBufPush >= yearBufPushInterval) {
       state.timeSinceLastYearBufPush -= yearBufPushInterval;
-      state.yearBufT.pushOverwrite(calculateStatistics<compact_t, PX_PER_23D>(state.monthBufT, 7*24/8).median);
-      state.yearBufH.pushOverwrite(calculateStatistics<compact_t, PX_PER_23D>(state.monthBufH, 7*24/8).median);
+      state.yearBufT.pushOverwrite(tierMedian(state.monthBufT, 7*24/8));
+      state.yearBufH.pushOverwrite(tierMedian(state.monthBufH, 7*24/8));
       updateFlags |= UpdateFlags::HISTORY_YEAR;
     }
 
-    // update d/w/m statistics every hour
-    if (isFlagSet(updateFlags, UpdateFlags::HISTORY_HOUR)) {
-      auto hourT = calculateStatistics<compact_t, PX_PER_1H>(state.hourBufT).median;
-      auto hourH = calculateStatistics<compact_t, PX_PER_1H>(state.hourBufH).median;
-      
-      RingBuf<compact_t, PX_PER_23H+1> fullDay;
-      fullDay.pushOverwrite(hourT);
-      for (int i = 0; i < state.dayBufT.size(); ++i) { fullDay.pushOverwrite(state.dayBufT[i]); }
-      state.statsTemp1D = calculateStatistics<compact_t, PX_PER_23H+1>(fullDay);
-      fullDay.clear();
-      fullDay.pushOverwrite(hourH);
-      for (int i = 0; i < state.dayBufH.size(); ++i) { fullDay.pushOverwrite(state.dayBufH[i]); }
-      state.statsHumidity1D = calculateStatistics<compact_t, PX_PER_23H+1>(fullDay);
-      updateFlags |= UpdateFlags::STATS_DAY;
-
-      RingBuf<compact_t, PX_PER_6D+1> fullWeek;
-      fullWeek.pushOverwrite(state.statsTemp1D.median);
-      for (int i = 0; i < state.weekBufT.size(); ++i) { fullWeek.pushOverwrite(state.weekBufT[i]); }
-      state.statsTemp1W = calculateStatistics<compact_t, PX_PER_6D+1>(fullWeek);
-      fullWeek.clear();
-      fullWeek.pushOverwrite(state.statsHumidity1D.median);
-      for (int i = 0; i < state.weekBufH.size(); ++i) { fullWeek.pushOverwrite(state.weekBufH[i]); }
-      state.statsHumidity1W = calculateStatistics<compact_t, PX_PER_6D+1>(fullWeek);
-      updateFlags |= UpdateFlags::STATS_WEEK;
-
-      RingBuf<compact_t, PX_PER_23D+1> fullMonth;
-      fullMonth.pushOverwrite(state.statsTemp1W.median);
-      for (int i = 0; i < state.monthBufT.size(); ++i) { fullMonth.pushOverwrite(state.monthBufT[i]); }
-      state.statsTemp1M = calculateStatistics<compact_t, PX_PER_23D+1>(fullMonth);
-      fullMonth.clear();
-      fullMonth.pushOverwrite(state.statsHumidity1W.median);
-      for (int i = 0; i < state.monthBufH.size(); ++i) { fullMonth.pushOverwrite(state.monthBufH[i]); }
-      state.statsHumidity1M = calculateStatistics<compact_t, PX_PER_23D+1>(fullMonth);
-      updateFlags |= UpdateFlags::STATS_MONTH;
-    }
-
+    // d/w/m statistics follow every hour push
+    statsPending = statsPending || isFlagSet(updateFlags, UpdateFlags::HISTORY_HOUR);
     return updateFlags;
   }
 
-  void currentReadingMedian(float* temp, float* humidity) {
-    *temp = unpack(state.statsTempCurrent);
-    *humidity = unpack(state.statsHumidityCurrent);
-  }
-
-  MeasurementStatistics<float> statsTemp1D() {
-    return unpack(state.statsTemp1D);
+  UpdateFlags finishIngest(UpdateFlags updateFlags) {
+    if (statsPending) {
+      updateFlags |= updatePeriodStats();
+    }
+    return updateFlags;
   }
 
-  MeasurementStatistics<float> statsTemp1W() {
-    return unpack(state.statsTemp1W);
+  UpdateFlags updatePeriodStats() {
+    statsPending = false;
+    compact_t medianT = tierMedian(state.hourBufT);
+    compact_t medianH = tierMedian(state.hourBufH);
+    state.statsTemp1D = periodStatistics(medianT, state.dayBufT);
+    state.statsHumidity1D = periodStatistics(medianH, state.dayBufH);
+    state.statsTemp1W = periodStatistics(medianT, state.weekBufT);
+    state.statsHumidity1W = periodStatistics(medianH, state.weekBufH);
+    state.statsTemp1M = periodStatistics(medianT, state.monthBufT);
+    state.statsHumidity1M = periodStatistics(medianH, state.monthBufH);
+    return UpdateFlags::STATS_DAY | UpdateFlags::STATS_WEEK | UpdateFlags::STATS_MONTH;
   }
 
-  MeasurementStatistics<float> statsTemp1M() {
-    return unpack(state.statsTemp1M);
+  // Median of the oldest entries of a tier without its gaps, the gap marker if nothing is left.
+  template<long S>
+  static compact_t tierMedian(const RingBuffer<compact_t, S>& buf, long onlyOldestNEntries = S) {
+    compact_t values[S];
+    const uint16_t count = withoutGaps(values, buf.copyTo(values, std::min(static_cast<long>(buf.size()), onlyOldestNEntries)));
+    return count == 0 ? historyGap<compact_t>() : calculateStatistics(values, count).median;
   }
 
-  MeasurementStatistics<float> statsHumidity1D() {
-    return unpack(state.statsHumidity1D);
-  }
-
-  MeasurementStatistics<float> statsHumidity1W() {
-    return unpack(state.statsHumidity1W);
+  // Each period is the newest median of the finer tier followed by this tier's entries, gaps
+  // left out. `median` moves on to this period's median, unless the period has no values.
+  template<long S>
+  static MeasurementStatistics<compact_t> periodStatistics(compact_t& median, const RingBuffer<compact_t, S>& buf) {
+    compact_t values[S + 1];
+    values[0] = median;
+    const uint16_t count = withoutGaps(values, 1 + buf.copyTo(values + 1, S));
+    const MeasurementStatistics<compact_t> stats = calculateStatistics(values, count);
+    if (count > 0) median = stats.median;
+    return stats;
   }
 
-  MeasurementStatistics<float> statsHumidity1M() {
-    return unpack(state.statsHumidity1M);
+  // Moves every running tier on by the slots `gapSec` covers, whatever its length in O(tiers):
+  // the first slot still takes the pre-gap data of the finer tier like a normal push, the rest
+  // (at most the tier capacity) are gap markers. Coarsest tier first, so that first push sees
+  // the finer tier before the gap reaches it.
+  UpdateFlags skipGap(time_t gapSec) {
+    UpdateFlags updateFlags = UpdateFlags::NONE;
+    if (state.monthBufT.isFull() && skipGap(state.yearBufT, state.yearBufH, state.timeSinceLastYearBufPush, yearBufPushInterval, gapSec,
+        tierMedian(state.monthBufT, 7*24/8), tierMedian(state.monthBufH, 7*24/8))) {
+      updateFlags |= UpdateFlags::HISTORY_YEAR;
+    }
+    if (state.weekBufT.isFull() && skipGap(state.monthBufT, state.monthBufH, state.timeSinceLastMonthBufPush, monthBufPushInterval, gapSec,
+        tierMedian(state.weekBufT, 8/4), tierMedian(state.weekBufH, 8/4))) {
+      updateFlags |= UpdateFlags::HISTORY_MONTH;
+    }
+    if (state.dayBufT.isFull() && skipGap(state.weekBufT, state.weekBufH, state.timeSinceLastWeekBufPush, weekBufPushInterval, gapSec,
+        tierMedian(state.dayBufT, 4*60/30), tierMedian(state.dayBufH, 4*60/30))) {
+      updateFlags |= UpdateFlags::HISTORY_WEEK;
+    }
+    if (state.hourBufT.isFull() && skipGap(state.dayBufT, state.dayBufH, state.timeSinceLastDayBufPush, dayBufPushInterval, gapSec,
+        tierMedian(state.hourBufT, 30/2), tierMedian(state.hourBufH, 30/2))) {
+      updateFlags |= UpdateFlags::HISTORY_DAY;
+    }
+    if (state.currentReadingBufT.isFull() && skipGap(state.hourBufT, state.hourBufH, state.timeSinceLastHourBufPush, hourBufPushInterval, gapSec,
+        tierMedian(state.currentReadingBufT), tierMedian(state.currentReadingBufH))) {
+      state.trendT.clear();
+      state.trendH.clear();
+      updateFlags |= UpdateFlags::HISTORY_HOUR;
+    }
+    return updateFlags;
   }
 
-  void getHistoryChartDataT(float (&values)[CHART_LEN_PX]) {
-    int v = 0, b = state.hourBufT.size();
-    while (b > 0) values[v++] = unpack(state.hourBufT[--b]);
-    b = state.dayBufT.size();
-    while (b > 0) values[v++] = unpack(state.dayBufT[--b]);
-    b = state.weekBufT.size();
-    while (b > 0) values[v++] = unpack(state.weekBufT[--b]);
-    b = state.monthBufT.size();
-    while (b > 0) values[v++] = unpack(state.monthBufT[--b]);
-    b = state.yearBufT.size();
-    while (b > 0) values[v++] = unpack(state.yearBufT[--b]);
-    while (v < CHART_LEN_PX) values[v++] = NAN;
-  }
-
-  void getHistoryChartDataH(float (&values)[CHART_LEN_PX]) {
-    int v = 0, b = state.hourBufH.size();
-    while (b > 0) values[v++] = unpack(state.hourBufH[--b]);
-    b = state.dayBufH.size();
-    while (b > 0) values[v++] = unpack(state.dayBufH[--b]);
-    b = state.weekBufH.size();
-    while (b > 0) values[v++] = unpack(state.weekBufH[--b]);
-    b = state.monthBufH.size();
-    while (b > 0) values[v++] = unpack(state.monthBufH[--b]);
-    b = state.yearBufH.size();
-    while (b > 0) values[v++] = unpack(state.yearBufH[--b]);
-    while (v < CHART_LEN_PX) values[v++] = NAN;
+  template<long S>
+  static bool skipGap(RingBuffer<compact_t, S>& bufT, RingBuffer<compact_t, S>& bufH, time_t& sinceLastPush, uint32_t interval, time_t gapSec, compact_t firstT, compact_t firstH) {
+    const time_t slots = (sinceLastPush + gapSec) / interval;
+    sinceLastPush = (sinceLastPush + gapSec) % interval;
+    if (slots == 0) {
+      return false;
+    }
+    bufT.pushOverwrite(firstT);
+    bufH.pushOverwrite(firstH);
+    const uint32_t gaps = std::min(slots - 1, (time_t)S);
+    bufT.pushRepeated(historyGap<compact_t>(), gaps);
+    bufH.pushRepeated(historyGap<compact_t>(), gaps);
+    return true;
   }
 
-private:
   struct State {
     time_t lastCollectedAtUnixTimeSec;
     time_t timeSinceLastHourBufPush;
@@ -312,18 +497,23 @@ private:
     time_t timeSinceLastMonthBufPush;
     time_t timeSinceLastYearBufPush;
 
-    RingBuf<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE> currentReadingBufT;
-    RingBuf<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE> currentReadingBufH;
-    RingBuf<compact_t, PX_PER_1H>  hourBufT;
-    RingBuf<compact_t, PX_PER_1H>  hourBufH;
-    RingBuf<compact_t, PX_PER_23H> dayBufT;
-    RingBuf<compact_t, PX_PER_23H> dayBufH;
-    RingBuf<compact_t, PX_PER_6D>  weekBufT;
-    RingBuf<compact_t, PX_PER_6D>  weekBufH;
-    RingBuf<compact_t, PX_PER_23D> monthBufT;
-    RingBuf<compact_t, PX_PER_23D> monthBufH;
-    RingBuf<compact_t, PX_PER_11M> yearBufT;
-    RingBuf<compact_t, PX_PER_11M> yearBufH;
+    RingBuffer<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE> currentReadingBufT;
+    RingBuffer<compact_t, CURRENT_READING_MEDIAN_FILTER_SIZE> currentReadingBufH;
+    RingBuffer<compact_t, PX_PER_1H>  hourBufT;
+    RingBuffer<compact_t, PX_PER_1H>  hourBufH;
+    RingBuffer<compact_t, PX_PER_23H> dayBufT;
+    RingBuffer<compact_t, PX_PER_23H> dayBufH;
+    RingBuffer<compact_t, PX_PER_6D>  weekBufT;
+    RingBuffer<compact_t, PX_PER_6D>  weekBufH;
+    RingBuffer<compact_t, PX_PER_23D> monthBufT;
+    RingBuffer<compact_t, PX_PER_23D> monthBufH;
+    RingBuffer<compact_t, PX_PER_11M> yearBufT;
+    RingBuffer<compact_t, PX_PER_11M> yearBufH;
+
+    TrendWindow<PX_PER_1H> trendT;
+    TrendWindow<PX_PER_1H> trendH;
+    TumblingMetrics metricsT;
+    TumblingMetrics metricsH;
 
     compact_t statsTempCurrent;
     MeasurementStatistics<compact_t> statsTemp1D;
@@ -350,23 +540,102 @@ private:
   };
 
   State state;
+  bool statsPending = false; // an hour push happened, period statistics not taken yet
   static const uint32_t hourBufPushInterval = 60/PX_PER_1H*60; // 2m/px, full buf = 1h
   static const uint32_t dayBufPushInterval = 60/(PX_PER_23H/(24-1))*60; // 30m/px, full buf = 23h
   static const uint32_t weekBufPushInterval = (7-1)*24/PX_PER_6D*60*60; // 4h/px, full buf = 6d
   static const uint32_t monthBufPushInterval = (24-1)*24/PX_PER_23D*60*60; // 8h/px, full buf = 23d
   static const uint32_t yearBufPushInterval = ((float)(12-1)*30)/PX_PER_11M*60*60*24; // 7d/px, full buf = 11M
 
-  template<size_t S>
-  void printDebug(const char* name, RingBuf<compact_t, S>& buf) {
-    Serial.print(name); 
-    Serial.print(": ["); 
-    for (uint8_t i = 0; i < buf.size(); ++i) { 
-      Serial.print(buf[i]); 
-      i+1 < buf.size() && Serial.print(", "); 
-    } Serial.print("] ("); 
-    Serial.print(buf.size()); 
-    Serial.print(" / "); 
-    Serial.print(buf.maxSize());
-    Serial.println(")"); 
+  static float trendPerHour(const TrendWindow<PX_PER_1H>& trend) {
+    if (trend.size() < TREND_MIN_POINTS) return NAN;
+    return unpack(1) * trend.slope() * (MIN_PER_HOUR * SEC_PER_MIN / hourBufPushInterval);
+  }
+
+  uint16_t historySize(HistoryRange range) {
+    const uint32_t pxSec = historyRangePxSec(range);
+    if (pxSec == 0) {
+      return std::min((uint16_t)(state.hourBufT.size() + state.dayBufT.size() + state.weekBufT.size() + state.monthBufT.size() + state.yearBufT.size()), (uint16_t)(CHART_LEN_PX));
+    }
+    const uint32_t spanSec = state.hourBufT.size() * hourBufPushInterval + state.dayBufT.size() * dayBufPushInterval
+      + state.weekBufT.size() * weekBufPushInterval + state.monthBufT.size() * monthBufPushInterval + state.yearBufT.size() * yearBufPushInterval;
+    return std::min((uint16_t)((spanSec + pxSec - 1) / pxSec), (uint16_t)(CHART_LEN_PX));
+  }
+
+  static inline float unpackHistory(compact_t value) {
+    return value == historyGap<compact_t>() ? NAN : unpack(value);
+  }
+
+  // takes the index-th newest entry if the tier has it, otherwise skips past the tier
+  template<long S>
+  static inline bool newestAt(RingBuffer<compact_t, S>& buf, uint16_t& index, compact_t* value) {
+    if (index < buf.size()) {
+      *value = buf[buf.size() - 1 - index];
+      return true;
+    }
+    index -= buf.size();
+    return false;
+  }
+
+  // takes the entry covering ageSec if the tier reaches that far back, otherwise skips past the tier
+  template<long S>
+  static inline bool agedAt(RingBuffer<compact_t, S>& buf, uint32_t stepSec, uint32_t& ageSec, compact_t* value) {
+    const uint32_t spanSec = buf.size() * stepSec;
+    if (ageSec < spanSec) {
+      *value = buf[buf.size() - 1 - ageSec / stepSec];
+      return true;
+    }
+    ageSec -= spanSec;
+    return false;
+  }
+
+  // Chart pixel `index` (newest first). With pxSec = 0 every tier entry is a pixel, otherwise the
+  // pixel shows the finest tier entry covering its age - a range query resampled to the chart
+  // width, one lookup per pixel.
+  static inline float historyAt(RingBuffer<compact_t, PX_PER_1H>& hour, RingBuffer<compact_t, PX_PER_23H>& day, RingBuffer<compact_t, PX_PER_6D>& week, RingBuffer<compact_t, PX_PER_23D>& month, RingBuffer<compact_t, PX_PER_11M>& year, uint16_t index, uint32_t pxSec) {
+    compact_t value;
+    if (pxSec == 0) {
+      if (newestAt(hour, index, &value) || newestAt(day, index, &value) || newestAt(week, index, &value) || newestAt(month, index, &value) || newestAt(year, index, &value)) {
+        return unpackHistory(value);
+      }
+      return NAN;
+    }
+    uint32_t ageSec = index * pxSec;
+    if (agedAt(hour, hourBufPushInterval, ageSec, &value) || agedAt(day, dayBufPushInterval, ageSec, &value) || agedAt(week, weekBufPushInterval, ageSec, &value)
+        || agedAt(month, monthBufPushInterval, ageSec, &value) || agedAt(year, yearBufPushInterval, ageSec, &value)) {
+      return unpackHistory(value);
+    }
+    return NAN;
+  }
+
+  static float historyAtT(void* source, uint16_t index, uint32_t pxSec) {
+    State& s = static_cast<StatsCollector*>(source)->state;
+    return historyAt(s.hourBufT, s.dayBufT, s.weekBufT, s.monthBufT, s.yearBufT, index, pxSec);
+  }
+
+  static float historyAtH(void* source, uint16_t index, uint32_t pxSec) {
+    State& s = static_cast<StatsCollector*>(source)->state;
+    return historyAt(s.hourBufH, s.dayBufH, s.weekBufH, s.monthBufH, s.yearBufH, index, pxSec);
+  }
+
+  template<long S>
+  static void dump(BlobWriter& w, RingBuffer<compact_t, S>& buf) {
+    w.u8(S);
+    w.u8(buf.size());
+    buf.forEach([&w](compact_t value) { w.u16(value); });
+  }
+
+  static void dump(BlobWriter& w, const MeasurementStatistics<compact_t>& stats) {
+    w.u16(stats.average);
+    w.u16(stats.median);
+    w.u16(stats.max);
+    w.u16(stats.min);
+  }
+
+  static void dump(BlobWriter& w, const ExposureStatistics<float>& exposure) {
+    w.f32(exposure.mean);
+    w.f32(exposure.stddev);
+    w.f32(exposure.outOfBandPercent);
+    w.f32(exposure.dangerPercent);
   }
 };
@@ -0,0 +1,56 @@
+#include "telemetry.h"
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFi.h>
+#include "log.h"
+#include "time_sync.h"
+#include "energy_meter.h"
+
+extern WifiCache wifiCache;
+
+bool uploadTelemetry(TelemetryQueue& queue, uint32_t nowSec) {
+  queue.attempted(nowSec);
+
+  EspTimeSyncNetwork network;
+  TimeSync connection(network, wifiCache);
+  const unsigned long radioOnAt = micros();
+  connection.start(millis(), false);
+  while (!connection.finished()) {
+    delay(WIFI_POLL_INTERVAL_MS);
+    connection.step(millis());
+  }
+  if (connection.state() != TimeSync::State::DONE) {
+    energyMeter.addRadio(micros() - radioOnAt);
+    LOG_WARN(TELEMETRY_UPLOAD, queue.sequence(), queue.count(), 0);
+    return false;
+  }
+
+  char header[16];
+  HTTPClient http;
+  http.setTimeout(TELEMETRY_HTTP_TIMEOUT_MS);
+  http.begin(TELEMETRY_URL);
+  http.addHeader("Content-Type", "application/octet-stream");
+  http.addHeader("X-Device-Id", WiFi.macAddress());
+  snprintf(header, sizeof(header), "%lu", (unsigned long)queue.session());
+  http.addHeader("X-Session-Id", header);
+  snprintf(header, sizeof(header), "%lu", (unsigned long)queue.sequence());
+  http.addHeader("X-Batch-Seq", header);
+  snprintf(header, sizeof(header), "%lu", (unsigned long)queue.dropped());
+  http.addHeader("X-Dropped", header);
+  const int status = http.POST(const_cast<uint8_t*>(queue.batch()), queue.batchSize());
+  http.end();
+  network.shutdown();
+  energyMeter.addRadio(micros() - radioOnAt);
+
+  LOG_INFO(TELEMETRY_UPLOAD, queue.sequence(), queue.count(), status);
+  if (status < 0 && connection.usedFastPath()) {
+    // connected with a cached lease but could not reach anything, refresh it next time
+    wifiCache.valid = false;
+  }
+  if (status < 200 || status >= 300) {
+    return false;
+  }
+  queue.ack();
+  return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "settings.h"
+
+#define TELEMETRY_FORMAT_VERSION 1
+#define TELEMETRY_MAX_SAMPLE_BITS (36 + 2 * 25) // worst case dod + two xor values
+
+/*
+ Readings waiting for upload, compressed as they arrive into a bit stream kept in RTC memory.
+
+ Format (bits MSB first, after a 3 byte header: version, uint16 LE sample count):
+   first sample:  timestamp 32 | temperature 16 | humidity 16   (compact values, x100)
+   next samples:  timestamp delta-of-delta
+                    '0'                 dod == 0
+                    '10'   + 7 bits     dod in [-64, 63]
+                    '110'  + 9 bits     dod in [-256, 255]
+                    '1110' + 12 bits    dod in [-2048, 2047]
+                    '1111' + 32 bits    otherwise
+                  then temperature and humidity, each XOR-ed with the previous value
+                    '0'                 same value
+                    '1' + leading zeros 4 | meaningful bits - 1 4 | meaningful bits
+
+ tools/telemetry_collector.py decodes it. A batch keeps its sequence number until the upload
+ is acknowledged, so a retried upload can be deduplicated by the collector. The sequence starts
+ over on a cold boot, so uploads also carry a session id drawn once per cold boot and the
+ collector deduplicates on (device, session, sequence).
+*/
+class TelemetryQueue {
+public:
+  TelemetryQueue(bool initial) {
+    if (initial) {
+      batchSeq = 0;
+      sessionId = 0;
+      lastUploadAttemptAtSec = 0;
+      clear();
+    }
+  }
+
+  // Returns false when the batch is full, the reading is then dropped.
+  bool append(uint32_t timestamp, int16_t temperature, uint16_t humidity);
+  bool isFull() const { return bitPos + TELEMETRY_MAX_SAMPLE_BITS > TELEMETRY_BUFFER_BYTES * 8; }
+  bool uploadDue(uint32_t nowSec) const;
+
+  // The encoded batch including header, valid until the next append() or ack().
+  const uint8_t* batch();
+  size_t batchSize() const { return 3 + (bitPos + 7) / 8; }
+  uint32_t sequence() const { return batchSeq; }
+  // Random, nonzero, the same for every batch until the next cold boot.
+  uint32_t session();
+  uint16_t count() const { return samples; }
+  uint32_t dropped() const { return droppedSamples; }
+
+  void attempted(uint32_t nowSec) { lastUploadAttemptAtSec = nowSec; }
+  // The collector has the batch, start a new one.
+  void ack();
+
+private:
+  uint8_t data[3 + TELEMETRY_BUFFER_BYTES];
+  uint32_t bitPos;
+  uint16_t samples;
+  uint32_t droppedSamples;
+  uint32_t batchSeq;
+  uint32_t sessionId; // 0 until the first upload draws it
+  uint32_t lastUploadAttemptAtSec;
+  uint32_t firstAtSec;
+  uint32_t prevTimestamp;
+  int32_t prevDelta;
+  uint16_t prevT;
+  uint16_t prevH;
+
+  void clear();
+  void writeBits(uint32_t value, uint8_t bits);
+  void writeXor(uint16_t value, uint16_t prev);
+};
+
+// Connects to Wi-Fi and POSTs the batch to TELEMETRY_URL, acknowledging it on a 2xx answer.
+bool uploadTelemetry(TelemetryQueue& queue, uint32_t nowSec);
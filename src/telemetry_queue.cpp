@@ -0,0 +1,105 @@
+#include "telemetry.h"
+
+#include <Arduino.h>
+
+void TelemetryQueue::clear() {
+  memset(data, 0, sizeof(data));
+  bitPos = 0;
+  samples = 0;
+  droppedSamples = 0;
+  firstAtSec = 0;
+  prevTimestamp = 0;
+  prevDelta = 0;
+  prevT = 0;
+  prevH = 0;
+}
+
+void TelemetryQueue::writeBits(uint32_t value, uint8_t bits) {
+  uint8_t* stream = data + 3;
+  for (int8_t i = bits - 1; i >= 0; --i) {
+    if ((value >> i) & 1) stream[bitPos / 8] |= 0x80 >> (bitPos % 8);
+    ++bitPos;
+  }
+}
+
+void TelemetryQueue::writeXor(uint16_t value, uint16_t prev) {
+  const uint16_t x = value ^ prev;
+  if (x == 0) {
+    writeBits(0, 1);
+    return;
+  }
+  const uint8_t leading = __builtin_clz(x) - 16;
+  const uint8_t trailing = __builtin_ctz(x);
+  const uint8_t meaningful = 16 - leading - trailing;
+  writeBits(1, 1);
+  writeBits(leading, 4);
+  writeBits(meaningful - 1, 4);
+  writeBits(x >> trailing, meaningful);
+}
+
+bool TelemetryQueue::append(uint32_t timestamp, int16_t temperature, uint16_t humidity) {
+  if (isFull()) {
+    ++droppedSamples;
+    return false;
+  }
+  const uint16_t t = (uint16_t)temperature;
+  if (samples == 0) {
+    firstAtSec = timestamp;
+    writeBits(timestamp, 32);
+    writeBits(t, 16);
+    writeBits(humidity, 16);
+  } else {
+    const int32_t delta = (int32_t)(timestamp - prevTimestamp);
+    const int32_t dod = delta - prevDelta;
+    if (dod == 0) {
+      writeBits(0, 1);
+    } else if (dod >= -64 && dod <= 63) {
+      writeBits(0b10, 2);
+      writeBits(dod & 0x7F, 7);
+    } else if (dod >= -256 && dod <= 255) {
+      writeBits(0b110, 3);
+      writeBits(dod & 0x1FF, 9);
+    } else if (dod >= -2048 && dod <= 2047) {
+      writeBits(0b1110, 4);
+      writeBits(dod & 0xFFF, 12);
+    } else {
+      writeBits(0b1111, 4);
+      writeBits((uint32_t)dod, 32);
+    }
+    writeXor(t, prevT);
+    writeXor(humidity, prevH);
+    prevDelta = delta;
+  }
+  prevTimestamp = timestamp;
+  prevT = t;
+  prevH = humidity;
+  ++samples;
+  return true;
+}
+
+bool TelemetryQueue::uploadDue(uint32_t nowSec) const {
+  if (samples == 0) return false;
+  // a clock behind the stored times (not read yet, or set back) would wrap the differences
+  if (nowSec < lastUploadAttemptAtSec || nowSec < firstAtSec) return false;
+  if (nowSec - lastUploadAttemptAtSec < TELEMETRY_RETRY_INTERVAL_SEC) return false;
+  return isFull() || nowSec - firstAtSec >= TELEMETRY_UPLOAD_INTERVAL_SEC;
+}
+
+const uint8_t* TelemetryQueue::batch() {
+  data[0] = TELEMETRY_FORMAT_VERSION;
+  data[1] = samples & 0xFF;
+  data[2] = samples >> 8;
+  return data;
+}
+
+uint32_t TelemetryQueue::session() {
+  // drawn on the first upload rather than in the constructor: with the radio on the RNG is
+  // fed by RF noise, at early boot it would only be pseudo-random
+  while (sessionId == 0) sessionId = esp_random();
+  return sessionId;
+}
+
+void TelemetryQueue::ack() {
+  ++batchSeq;
+  clear();
+}
@@ -0,0 +1,78 @@
+#include "time_sync.h"
+
+#include "settings.h"
+
+void TimeSync::enter(State state, uint32_t nowMs) {
+  current = state;
+  stateSinceMs = nowMs;
+}
+
+void TimeSync::start(uint32_t nowMs, bool withSntp) {
+  sntp = withSntp;
+  fastPath = cache.valid;
+  if (fastPath) {
+    net.beginFast(cache);
+    enter(State::FAST_CONNECTING, nowMs);
+  } else {
+    beginFull(nowMs);
+  }
+}
+
+void TimeSync::beginFull(uint32_t nowMs) {
+  fastPath = false;
+  net.beginFull();
+  enter(State::FULL_CONNECTING, nowMs);
+}
+
+void TimeSync::connected(uint32_t nowMs) {
+  if (sntp) {
+    net.startSntp();
+    enter(State::SNTP_WAIT, nowMs);
+  } else {
+    enter(State::DONE, nowMs);
+  }
+}
+
+void TimeSync::fail(uint32_t nowMs) {
+  net.shutdown();
+  enter(State::FAILED, nowMs);
+}
+
+TimeSync::State TimeSync::step(uint32_t nowMs) {
+  const uint32_t inState = nowMs - stateSinceMs;
+  switch (current) {
+    case State::FAST_CONNECTING:
+      if (net.connected()) {
+        connected(nowMs);
+      } else if (inState >= WIFI_FAST_CONNECT_TIMEOUT_MS) {
+        // AP moved to another channel, BSSID changed, ... - forget it and do it the slow way
+        cache.valid = false;
+        beginFull(nowMs);
+      }
+      break;
+    case State::FULL_CONNECTING:
+      if (net.connected()) {
+        net.remember(&cache);
+        connected(nowMs);
+      } else if (inState >= WIFI_CONNECT_ATTEMPTS * WIFI_CONNECT_ATTEMPT_INTERVAL_MS) {
+        fail(nowMs);
+      }
+      break;
+    case State::SNTP_WAIT:
+      if (net.sntpSynced()) {
+        net.shutdown();
+        enter(State::DONE, nowMs);
+      } else if (inState >= NTP_SYNC_TIMEOUT_MS) {
+        // a stale static lease connects but gets nowhere, next sync starts from scratch
+        if (fastPath) cache.valid = false;
+        fail(nowMs);
+      }
+      break;
+    case State::IDLE:
+    case State::DONE:
+    case State::FAILED:
+    default:
+      break;
+  }
+  return current;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+// Connection parameters of the last successful association, kept in RTC memory so the next
+// sync can skip the scan (BSSID + channel) and DHCP (static config from the previous lease).
+struct WifiCache {
+  bool valid;
+  uint8_t bssid[6];
+  int32_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+// Network operations the sync state machine needs, implemented on top of WiFi/SNTP by
+// EspTimeSyncNetwork (time_sync_network.cpp) and replaceable by a fake for testing.
+class TimeSyncNetwork {
+public:
+  virtual ~TimeSyncNetwork() {}
+  virtual void beginFast(const WifiCache& cache) = 0;
+  virtual void beginFull() = 0;
+  virtual bool connected() = 0;
+  virtual void remember(WifiCache* cache) = 0;
+  virtual void startSntp() = 0;
+  virtual bool sntpSynced() = 0;
+  virtual void shutdown() = 0;
+};
+
+class EspTimeSyncNetwork : public TimeSyncNetwork {
+public:
+  void beginFast(const WifiCache& cache) override;
+  void beginFull() override;
+  bool connected() override;
+  void remember(WifiCache* cache) override;
+  void startSntp() override;
+  bool sntpSynced() override;
+  void shutdown() override;
+};
+
+/*
+ Time sync state machine: try the cached fast connect first, fall back to a full scan + DHCP,
+ then wait for the SNTP sync callback (or stop once connected, for other uploads). Driven by
+ step() with the current time so it never blocks by itself.
+*/
+class TimeSync {
+public:
+  enum class State : uint8_t {
+    IDLE,
+    FAST_CONNECTING,
+    FULL_CONNECTING,
+    SNTP_WAIT,
+    DONE,
+    FAILED,
+  };
+
+  TimeSync(TimeSyncNetwork& net, WifiCache& cache) : net(net), cache(cache) {}
+
+  // With sntp = false the machine stops at DONE as soon as it is connected and leaves the
+  // radio on, the caller shuts the network down when finished with it.
+  void start(uint32_t nowMs, bool sntp = true);
+  State step(uint32_t nowMs);
+
+  State state() const { return current; }
+  bool finished() const { return current == State::DONE || current == State::FAILED; }
+  bool usedFastPath() const { return fastPath; }
+
+private:
+  TimeSyncNetwork& net;
+  WifiCache& cache;
+  State current = State::IDLE;
+  uint32_t stateSinceMs = 0;
+  bool fastPath = false;
+  bool sntp = true;
+
+  void enter(State state, uint32_t nowMs);
+  void beginFull(uint32_t nowMs);
+  void connected(uint32_t nowMs);
+  void fail(uint32_t nowMs);
+};
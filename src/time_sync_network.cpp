@@ -0,0 +1,57 @@
+#include "time_sync.h"
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "esp_sntp.h"
+#include "runtime_config.h"
+#include "settings.h"
+
+static volatile bool sntpSyncedFlag = false;
+
+static void onSntpSync(struct timeval* tv) {
+  sntpSyncedFlag = true;
+}
+
+void EspTimeSyncNetwork::beginFast(const WifiCache& cache) {
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+  WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+  WiFi.begin(config.wifiSsid, config.wifiPassword, cache.channel, cache.bssid, true);
+}
+
+void EspTimeSyncNetwork::beginFull() {
+  WiFi.persistent(false);
+  WiFi.disconnect();
+  WiFi.mode(WIFI_STA);
+  WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE); // back to DHCP
+  WiFi.begin(config.wifiSsid, config.wifiPassword);
+}
+
+bool EspTimeSyncNetwork::connected() {
+  return WiFi.status() == WL_CONNECTED;
+}
+
+void EspTimeSyncNetwork::remember(WifiCache* cache) {
+  memcpy(cache->bssid, WiFi.BSSID(), sizeof(cache->bssid));
+  cache->channel = WiFi.channel();
+  cache->ip = WiFi.localIP();
+  cache->gateway = WiFi.gatewayIP();
+  cache->subnet = WiFi.subnetMask();
+  cache->dns = WiFi.dnsIP(0);
+  cache->valid = true;
+}
+
+void EspTimeSyncNetwork::startSntp() {
+  sntpSyncedFlag = false;
+  sntp_set_time_sync_notification_cb(onSntpSync);
+  configTime(config.gmtOffsetSec, config.daylightOffsetSec, config.ntpServers[0], config.ntpServers[1], config.ntpServers[2]);
+}
+
+bool EspTimeSyncNetwork::sntpSynced() {
+  return sntpSyncedFlag;
+}
+
+void EspTimeSyncNetwork::shutdown() {
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+}
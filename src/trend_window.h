@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ Least-squares line over the last S samples of a sliding window, updated in O(1) per push.
+
+ Samples sit at x = 0..n-1 (oldest first). Only sum(y) and sum(x*y) are kept, sum(x) and
+ sum(x^2) follow from n. When a full window shifts, every remaining sample moves one x to
+ the left, which takes sum(y) out of sum(x*y) once:
+   sum(x*y)' = sum(x*y) - (sum(y) - evicted) + (S - 1) * value
+ All sums are integers over compact values, so they never drift.
+*/
+template <long S>
+class TrendWindow {
+public:
+  void clear() {
+    n = 0;
+    sumY = 0;
+    sumXY = 0;
+  }
+
+  // `full` and `evicted` describe the mirrored ring buffer before the push.
+  void push(int32_t value, bool full, int32_t evicted) {
+    if (!full) {
+      sumXY += (int64_t)n * value;
+      sumY += value;
+      ++n;
+    } else {
+      sumXY = sumXY - (sumY - evicted) + (int64_t)(S - 1) * value;
+      sumY = sumY - evicted + value;
+    }
+  }
+
+  uint16_t size() const {
+    return n;
+  }
+
+  // Change of the fitted line per sample, 0 with less than two samples.
+  float slope() const {
+    if (n < 2) return 0;
+    const int64_t sumX = (int64_t)n * (n - 1) / 2;
+    const int64_t sumXX = (int64_t)(n - 1) * n * (2 * n - 1) / 6;
+    const int64_t denominator = n * sumXX - sumX * sumX;
+    return (float)(n * sumXY - sumX * sumY) / denominator;
+  }
+
+private:
+  uint16_t n;
+  int64_t sumY;
+  int64_t sumXY;
+};
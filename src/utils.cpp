@@ -5,7 +5,7 @@ float celsiusTo(const float celsius, const DegreesUnit unit) {
         case CELSIUS:
         return celsius;
         case FARENHEIT:
-        return celsius * 9/5 - 32;
+        return celsius * 9/5 + 32;
     }
     return NAN;
 }
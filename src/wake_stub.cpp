@@ -0,0 +1,64 @@
+#include "wake_stub.h"
+
+#include "esp_attr.h"
+#include "esp_sleep.h"
+#include "rom/ets_sys.h"
+#include "soc/rtc.h"
+#include "soc/rtc_cntl_reg.h"
+#include "wake_stub_decision.h"
+
+static RTC_DATA_ATTR WakeStubState wakeStubState = {};
+
+// Register level rtc_time_get(), the IDF one lives in flash.
+static inline __attribute__((always_inline)) uint64_t rtcTicks() {
+  SET_PERI_REG_MASK(RTC_CNTL_TIME_UPDATE_REG, RTC_CNTL_TIME_UPDATE);
+  while (GET_PERI_REG_MASK(RTC_CNTL_TIME_UPDATE_REG, RTC_CNTL_TIME_VALID) == 0) {
+    ets_delay_us(1); // takes up to one slow clock period
+  }
+  SET_PERI_REG_MASK(RTC_CNTL_INT_CLR_REG, RTC_CNTL_TIME_VALID_INT_CLR);
+  uint64_t ticks = READ_PERI_REG(RTC_CNTL_TIME0_REG);
+  ticks |= (uint64_t) READ_PERI_REG(RTC_CNTL_TIME1_REG) << 32;
+  return ticks;
+}
+
+// Overrides the weak IDF stub. Wakeup sources (timer, ext0 button) and the sleep config stay
+// programmed from the app's esp_deep_sleep(), only the timer target is moved.
+extern "C" void RTC_IRAM_ATTR esp_wake_deep_sleep(void) {
+  esp_default_wake_deep_sleep();
+
+  const bool buttonWake = REG_GET_FIELD(RTC_CNTL_WAKEUP_STATE_REG, RTC_CNTL_WAKEUP_CAUSE) & RTC_EXT0_TRIG_EN;
+  const uint64_t now = rtcTicks();
+  if (wakeStubDecide(&wakeStubState, now, buttonWake) == WAKE_STUB_BOOT) {
+    return;
+  }
+
+  wakeStubState.skippedWakeups++;
+  const uint64_t wakeAt = wakeStubNextWakeTicks(&wakeStubState, now);
+  WRITE_PERI_REG(RTC_CNTL_SLP_TIMER0_REG, wakeAt & UINT32_MAX);
+  WRITE_PERI_REG(RTC_CNTL_SLP_TIMER1_REG, wakeAt >> 32);
+
+  REG_WRITE(RTC_ENTRY_ADDR_REG, (uint32_t) &esp_wake_deep_sleep);
+  CLEAR_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_SLEEP_EN);
+  SET_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_SLEEP_EN);
+  while (true) {
+    // a few cycles until the sleep kicks in
+  }
+}
+
+void wakeStubArm(uint64_t deadlineUs, uint64_t intervalUs) {
+  const uint32_t calibration = REG_READ(RTC_SLOW_CLK_CAL_REG);
+  const uint64_t intervalTicks = wakeStubUsToTicks(intervalUs, calibration);
+  wakeStubState.deadlineTicks = rtcTicks() + wakeStubUsToTicks(deadlineUs, calibration);
+  wakeStubState.intervalTicks = intervalTicks;
+  wakeStubState.armed = intervalTicks > 0;
+}
+
+void wakeStubDisarm() {
+  wakeStubState.armed = false;
+}
+
+uint32_t wakeStubTakeSkipped() {
+  const uint32_t skipped = wakeStubState.skippedWakeups;
+  wakeStubState.skippedWakeups = 0;
+  return skipped;
+}
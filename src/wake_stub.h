@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ Deep sleep wake stub. Runs from RTC memory right after the ROM bootloader, before the second
+ stage boot, Arduino init and setup(). When the button did not cause the wakeup and the
+ deadline the app left is still ahead, it reprograms the sleep timer and goes straight back to
+ deep sleep. Only wakeups with work to do start the app.
+
+ The app arms the stub before every sleep with the time until its next piece of work.
+*/
+
+// Stub resolves wakeups until `deadlineUs` from now, waking every `intervalUs` to check.
+void wakeStubArm(uint64_t deadlineUs, uint64_t intervalUs);
+// Next wakeup boots the app regardless of the deadline.
+void wakeStubDisarm();
+// Wakeups the stub put back to sleep since the previous call.
+uint32_t wakeStubTakeSkipped();
@@ -0,0 +1,51 @@
+#pragma once
+
+/*
+ Plain C decision logic of the deep sleep wake stub (see wake_stub.cpp). Everything here is
+ always inlined: the stub runs from RTC fast memory before the flash cache is up, so it can
+ not call into code that lives in flash. No ESP headers, so it compiles on the host as well.
+
+ Times are RTC slow clock ticks, the counter keeps running through deep sleep.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAKE_STUB_INLINE static inline __attribute__((always_inline))
+
+typedef struct {
+  bool armed;              // the app left a deadline, cleared whenever it wants to run on the next wakeup
+  uint64_t deadlineTicks;  // the app has work to do at this tick
+  uint64_t intervalTicks;  // regular wakeup cadence between app runs
+  uint32_t skippedWakeups; // wakeups the stub put back to sleep since the app last ran
+} WakeStubState;
+
+typedef enum {
+  WAKE_STUB_BOOT,  // continue into the app
+  WAKE_STUB_SLEEP, // nothing due, back to deep sleep
+} WakeStubAction;
+
+WAKE_STUB_INLINE WakeStubAction wakeStubDecide(const WakeStubState* state, uint64_t nowTicks, bool buttonWake) {
+  if (!state->armed || buttonWake) return WAKE_STUB_BOOT;
+  return nowTicks >= state->deadlineTicks ? WAKE_STUB_BOOT : WAKE_STUB_SLEEP;
+}
+
+// Next wakeup keeps the regular cadence but never overshoots the deadline.
+WAKE_STUB_INLINE uint64_t wakeStubNextWakeTicks(const WakeStubState* state, uint64_t nowTicks) {
+  const uint64_t next = nowTicks + state->intervalTicks;
+  return next < state->deadlineTicks ? next : state->deadlineTicks;
+}
+
+// calibration: slow clock period in microseconds, Q13.19 fixed point (RTC_SLOW_CLK_CAL_REG)
+WAKE_STUB_INLINE uint64_t wakeStubUsToTicks(uint64_t us, uint32_t calibration) {
+  if (calibration == 0) return 0;
+  return (us << 19) / calibration;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include "humidity_sensor.h"
+
+/*
+ Scripted HumiditySensor for host tests. The result is ready `readyAfterUs` after
+ startConversion() on the hostMicros clock; `responding`, `starts` and `reads` switch off
+ the sensor, the conversion start or the readout (a bus or checksum error).
+*/
+class FakeHumiditySensor : public HumiditySensor {
+public:
+  bool responding = true;
+  bool starts = true;
+  bool reads = true;
+  uint32_t conversionUs = 10000;
+  uint32_t readyAfterUs = 5000;
+  float temperature = 21.0f;
+  float humidity = 50.0f;
+  size_t startCalls = 0;
+  size_t readCalls = 0;
+
+  FakeHumiditySensor() {}
+  FakeHumiditySensor(float temperature, float humidity) : temperature(temperature), humidity(humidity) {}
+
+  bool begin() override { return responding; }
+
+  bool startConversion() override {
+    ++startCalls;
+    if (!responding || !starts) return false;
+    startedAt = micros();
+    converting = true;
+    return true;
+  }
+
+  uint32_t conversionTimeUs() const override { return conversionUs; }
+
+  bool readConversion(float* t, float* h) override {
+    ++readCalls;
+    if (!converting || !reads || micros() - startedAt < readyAfterUs) return false;
+    converting = false;
+    *t = temperature;
+    *h = humidity;
+    return true;
+  }
+
+private:
+  unsigned long startedAt = 0;
+  bool converting = false;
+};
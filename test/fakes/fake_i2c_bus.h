@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+#include "i2c_bus.h"
+
+/*
+ Scripted I2C bus for host tests. Writes are recorded, reads are answered from a queue of
+ replies per address. An empty queue, or a nack() entry, NACKs the read like a sensor that is
+ still converting.
+*/
+class FakeI2CBus : public I2CBus {
+public:
+  struct Transfer {
+    uint8_t address;
+    std::vector<uint8_t> data;
+  };
+
+  std::vector<Transfer> writes;
+  size_t reads = 0;
+  bool nackWrites = false;
+
+  void reply(uint8_t address, std::vector<uint8_t> data) { replies[address].push_back(data); }
+  void nack(uint8_t address, size_t count = 1) {
+    for (size_t i = 0; i < count; ++i) replies[address].push_back({});
+  }
+  size_t pendingReplies(uint8_t address) { return replies[address].size(); }
+
+  bool write(uint8_t address, const uint8_t* data, size_t len) override {
+    if (nackWrites) return false;
+    writes.push_back({ address, std::vector<uint8_t>(data, data + len) });
+    return true;
+  }
+
+  bool read(uint8_t address, uint8_t* data, size_t len) override {
+    ++reads;
+    std::deque<std::vector<uint8_t>>& queue = replies[address];
+    if (queue.empty()) return false;
+    const std::vector<uint8_t> next = queue.front();
+    queue.pop_front();
+    if (next.size() != len) return false;
+    memcpy(data, next.data(), len);
+    return true;
+  }
+
+private:
+  std::map<uint8_t, std::deque<std::vector<uint8_t>>> replies;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include "time_sync.h"
+
+// Scripted network for TimeSync tests: the test flips `link` and `synced`, every call is
+// appended to `calls` so the sequence can be checked.
+class FakeTimeSyncNetwork : public TimeSyncNetwork {
+public:
+  bool link = false;
+  bool synced = false;
+  std::string calls;
+
+  void beginFast(const WifiCache& cache) override { calls += "fast "; }
+  void beginFull() override { calls += "full "; }
+  bool connected() override { return link; }
+  void remember(WifiCache* cache) override {
+    calls += "remember ";
+    cache->valid = true;
+    cache->channel = 6;
+  }
+  void startSntp() override { calls += "sntp "; }
+  bool sntpSynced() override { return synced; }
+  void shutdown() override {
+    calls += "shutdown ";
+    link = false;
+  }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the unit-tested modules use. Time only
+// moves when the code under test waits, or when a test advances hostMicros itself.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+// flash and RAM are one address space on the host
+#define PROGMEM
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+
+inline unsigned long hostMicros = 0;
+
+inline unsigned long micros() { return hostMicros; }
+inline unsigned long millis() { return hostMicros / 1000; }
+inline void delayMicroseconds(uint32_t us) { hostMicros += us; }
+inline void delay(uint32_t ms) { hostMicros += ms * 1000; }
+
+// deterministic stand-in for the hardware RNG
+inline uint32_t hostRandomState = 1;
+inline uint32_t esp_random() { return hostRandomState = hostRandomState * 1664525u + 1013904223u; }
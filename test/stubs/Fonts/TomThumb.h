@@ -0,0 +1,9 @@
+#pragma once
+
+// Host stand-in for Fonts/TomThumb.h, metrics only - the native tests do not draw with it.
+
+#include <Adafruit_GFX.h>
+
+static const uint8_t TomThumbBitmaps[] PROGMEM = { 0x00 };
+static const GFXglyph TomThumbGlyphs[] PROGMEM = { { 0, 8, 1, 2, 0, -5 } };
+const GFXfont TomThumb PROGMEM = { (uint8_t*)TomThumbBitmaps, (GFXglyph*)TomThumbGlyphs, 0x20, 0x20, 6 };
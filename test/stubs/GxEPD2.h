@@ -0,0 +1,6 @@
+#pragma once
+
+// Host stand-in for GxEPD2.h, the colours.
+
+#define GxEPD_BLACK 0x0000
+#define GxEPD_WHITE 0xFFFF
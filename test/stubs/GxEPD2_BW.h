@@ -0,0 +1,164 @@
+#pragma once
+
+// Host stand-in for GxEPD2_BW 1.5 and the GxEPD2_213_B74 driver. The driver keeps what a
+// panel would see instead of talking SPI: every command with its data bytes, busy waits, and
+// the new image RAM (0x24). The frame buffer template keeps the library's pixel mapping.
+
+#include <Adafruit_GFX.h>
+#include <GxEPD2.h>
+#include <cstring>
+#include <vector>
+
+struct PanelCommand {
+  uint8_t command;
+  std::vector<uint8_t> data;
+  bool waitedBusy; // the driver waited for BUSY after this command
+};
+
+class GxEPD2_213_B74 {
+public:
+  static const uint16_t WIDTH = 128;
+  static const uint16_t WIDTH_VISIBLE = 122;
+  static const uint16_t HEIGHT = 250;
+
+  std::vector<PanelCommand> commands;
+  uint8_t ram[WIDTH / 8 * HEIGHT];
+
+  GxEPD2_213_B74(int16_t cs, int16_t dc, int16_t rst, int16_t busy) {
+    memset(ram, 0xFF, sizeof(ram));
+  }
+
+  void init(uint32_t serial_diag_bitrate, bool initial = true, uint16_t reset_duration = 10, bool pulldown_rst_mode = false) {
+    _initial_write = initial;
+    _initial_refresh = initial;
+    _power_is_on = false;
+    _hibernating = false;
+  }
+
+  void writeImage(const uint8_t* bitmap, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) {
+    writeImagePart(bitmap, 0, 0, w, h, x, y, w, h);
+  }
+
+  void writeImagePart(const uint8_t* bitmap, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+    int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) {
+    _writeCommand(0x24);
+    for (int16_t j = 0; j < h; ++j) {
+      for (int16_t i = 0; i < w / 8; ++i) {
+        const uint8_t data = bitmap[(y_part + j) * (w_bitmap / 8) + x_part / 8 + i];
+        ram[(y + j) * (WIDTH / 8) + x / 8 + i] = data;
+        _writeData(data);
+      }
+    }
+  }
+
+  // the previous image RAM (0x26) is only recorded as written
+  void writeImageAgain(const uint8_t* bitmap, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) {
+    _writeCommand(0x26);
+  }
+
+  void writeImagePartAgain(const uint8_t* bitmap, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+    int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) {
+    _writeCommand(0x26);
+  }
+
+  void refresh(bool partial_update_mode = false) {
+    _writeCommand(0x22);
+    _writeData(0xF7);
+    _writeCommand(0x20);
+    _waitWhileBusy("_Update_Full", 4000);
+    _initial_refresh = false;
+    _power_is_on = false;
+  }
+
+  void refresh(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (_initial_refresh) return refresh(false);
+    _writeCommand(0x22);
+    _writeData(0xFC);
+    _writeCommand(0x20);
+    _waitWhileBusy("_Update_Part", 300);
+    _power_is_on = true;
+  }
+
+  void powerOff() {
+    if (!_power_is_on) return;
+    _writeCommand(0x22);
+    _writeData(0x83);
+    _writeCommand(0x20);
+    _waitWhileBusy("_PowerOff", 140);
+    _power_is_on = false;
+  }
+
+  void hibernate() {
+    powerOff();
+    _writeCommand(0x10);
+    _writeData(0x01);
+    _hibernating = true;
+  }
+
+protected:
+  bool _initial_write = true;
+  bool _initial_refresh = true;
+  bool _power_is_on = false;
+  bool _hibernating = false;
+
+  void _writeCommand(uint8_t c) { commands.push_back({ c, {}, false }); }
+  void _writeData(uint8_t d) { commands.back().data.push_back(d); }
+  void _writeData(const uint8_t* data, uint16_t n) {
+    for (uint16_t i = 0; i < n; ++i) _writeData(data[i]);
+  }
+  void _writeDataPGM(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes = 0) {
+    _writeData(data, n);
+    for (int16_t i = 0; i < fill_with_zeroes; ++i) _writeData(0x00);
+  }
+  void _waitWhileBusy(const char* comment = 0, uint16_t busy_time = 5000) { commands.back().waitedBusy = true; }
+};
+
+template<typename GxEPD2_Type, const uint16_t page_height>
+class GxEPD2_BW : public Adafruit_GFX {
+public:
+  GxEPD2_Type epd2;
+
+  GxEPD2_BW(GxEPD2_Type epd2_instance) : Adafruit_GFX(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance) {
+    fillScreen(GxEPD_WHITE);
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || x >= width() || y < 0 || y >= height()) return;
+    // as in GxEPD2_BW, with the visible width of the panel as the Adafruit_GFX WIDTH
+    switch (getRotation()) {
+      case 1:
+        _swap_int16_t(x, y);
+        x = WIDTH - x - 1;
+        break;
+      case 2:
+        x = WIDTH - x - 1;
+        y = HEIGHT - y - 1;
+        break;
+      case 3:
+        _swap_int16_t(x, y);
+        y = HEIGHT - y - 1;
+        break;
+    }
+    if (y >= int16_t(page_height)) return;
+    const uint16_t i = x / 8 + y * (GxEPD2_Type::WIDTH / 8);
+    if (color) {
+      _buffer[i] = _buffer[i] | (1 << (7 - x % 8));
+    } else {
+      _buffer[i] = _buffer[i] & (0xFF ^ (1 << (7 - x % 8)));
+    }
+  }
+
+  void fillScreen(uint16_t color) override {
+    memset(_buffer, color == GxEPD_BLACK ? 0x00 : 0xFF, sizeof(_buffer));
+  }
+
+  // full window only, one page
+  void display(bool partial_update_mode = false) {
+    epd2.writeImage(_buffer, 0, 0, GxEPD2_Type::WIDTH, HEIGHT);
+    epd2.refresh(false);
+    epd2.writeImageAgain(_buffer, 0, 0, GxEPD2_Type::WIDTH, HEIGHT);
+  }
+
+private:
+  uint8_t _buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+// Host stand-in, nothing in the unit-tested code prints.
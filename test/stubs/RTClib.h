@@ -0,0 +1,15 @@
+#pragma once
+
+// Host stand-in for the RTClib types the shared headers mention.
+
+#include <cstdint>
+
+class DateTime {
+public:
+  DateTime(uint32_t t = 0) : t(t) {}
+  uint32_t unixtime() const { return t; }
+  char* toString(char* buffer) const { return buffer; }
+
+private:
+  uint32_t t;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+// Host stand-in for TwoWire, only so that i2c_bus.h compiles: tests use FakeI2CBus.
+
+#include <cstddef>
+#include <cstdint>
+
+class TwoWire {
+public:
+  void beginTransmission(uint8_t) {}
+  size_t write(const uint8_t*, size_t len) { return len; }
+  uint8_t endTransmission() { return 2; }
+  size_t requestFrom(uint8_t, size_t) { return 0; }
+  int read() { return -1; }
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+#define WIFI_SSID "test-ssid"
+#define WIFI_PASSWORD "test-password"
@@ -0,0 +1,17 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF bits the unit-tested headers touch. RTC-resident objects ask
+// for the wakeup cause to tell a cold boot from a deep sleep wakeup: tests set hostWakeupCause
+// to ESP_SLEEP_WAKEUP_TIMER to construct them as if they survived a deep sleep.
+
+typedef enum {
+  ESP_SLEEP_WAKEUP_UNDEFINED,
+  ESP_SLEEP_WAKEUP_ALL,
+  ESP_SLEEP_WAKEUP_EXT0,
+  ESP_SLEEP_WAKEUP_EXT1,
+  ESP_SLEEP_WAKEUP_TIMER,
+} esp_sleep_wakeup_cause_t;
+
+inline esp_sleep_wakeup_cause_t hostWakeupCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() { return hostWakeupCause; }
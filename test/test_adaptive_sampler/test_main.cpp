@@ -0,0 +1,109 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <cstdio>
+#include "adaptive_sampler.h"
+
+RuntimeConfig config;
+
+void setUp(void) {
+  config.sensorReadIntervalSec = SENSOR_READ_INTERVAL_SEC;
+  config.sensorMaxIntervalSec = ADAPTIVE_SENSOR_MAX_INTERVAL_SEC;
+}
+
+void tearDown(void) {}
+
+static void test_interval_doubles_while_flat(void) {
+  AdaptiveSampler<uint16_t> sampler(true);
+  TEST_ASSERT_EQUAL(SENSOR_READ_INTERVAL_SEC, sampler.intervalSec());
+  sampler.update(21.0, 50.0);
+  TEST_ASSERT_EQUAL(SENSOR_READ_INTERVAL_SEC, sampler.intervalSec());
+  uint32_t expected = SENSOR_READ_INTERVAL_SEC;
+  for (int i = 0; i < 10; ++i) {
+    sampler.update(21.05, 50.2);
+    expected = std::min(expected * 2, (uint32_t)ADAPTIVE_SENSOR_MAX_INTERVAL_SEC);
+    TEST_ASSERT_EQUAL(expected, sampler.intervalSec());
+  }
+}
+
+static void test_step_resets_interval(void) {
+  AdaptiveSampler<uint16_t> sampler(true);
+  for (int i = 0; i < 5; ++i) sampler.update(21.0, 50.0);
+  TEST_ASSERT_GREATER_THAN(SENSOR_READ_INTERVAL_SEC, sampler.intervalSec());
+  sampler.update(21.0, 51.0);
+  TEST_ASSERT_EQUAL(SENSOR_READ_INTERVAL_SEC, sampler.intervalSec());
+  sampler.update(22.0, 51.0);
+  TEST_ASSERT_EQUAL(SENSOR_READ_INTERVAL_SEC, sampler.intervalSec());
+}
+
+// Each reading moves less than the threshold, together they move more.
+static void test_slow_drift_resets_interval(void) {
+  AdaptiveSampler<uint16_t> sampler(true);
+  float t = 21.0;
+  sampler.update(t, 50.0);
+  bool reset = false;
+  for (int i = 0; i < 10 && !reset; ++i) {
+    t += 0.08;
+    sampler.update(t, 50.0);
+    reset = sampler.intervalSec() == SENSOR_READ_INTERVAL_SEC;
+  }
+  TEST_ASSERT_TRUE(reset);
+}
+
+// Day of readings: flat with sensor noise, a step (lid opened for half an hour) and a slow
+// drift of 0.9 C/h, just under the threshold per reading at the longest interval.
+static void trace(uint32_t at, float* t, float* h) {
+  const float hour = at / 3600.0f;
+  const float noise = ((at * 2654435761u) >> 24) / 255.0f * 0.04f - 0.02f;
+  *t = 21.0f + noise;
+  *h = 50.0f + noise;
+  if (hour >= 6 && hour < 6.5) {
+    *t += 1.5f;
+    *h += 4.0f;
+  }
+  if (hour >= 8) *t += 0.9f * (std::min(hour, 14.0f) - 8);
+}
+
+static void test_replay_against_fixed_rate(void) {
+  const uint32_t day = 24 * 3600;
+  const uint32_t fixedReads = day / SENSOR_READ_INTERVAL_SEC;
+  AdaptiveSampler<uint16_t> sampler(true);
+  uint32_t reads = 0, driftReads = 0;
+  uint32_t nextReadAt = 0;
+  float shownT = 0, shownH = 0, maxLagH = 0, maxDriftLagT = 0;
+  // the fixed rate reference reads on every base interval, compare with what the sampler shows
+  for (uint32_t at = 0; at < day; at += SENSOR_READ_INTERVAL_SEC) {
+    float t, h;
+    trace(at, &t, &h);
+    if (at >= nextReadAt) {
+      sampler.update(t, h);
+      shownT = t;
+      shownH = h;
+      nextReadAt = at + sampler.intervalSec();
+      ++reads;
+      if (at >= 8 * 3600 && at < 14 * 3600) ++driftReads;
+    }
+    maxLagH = std::max(maxLagH, fabsf(h - shownH));
+    if (at >= 8 * 3600 && at < 14 * 3600) maxDriftLagT = std::max(maxDriftLagT, fabsf(t - shownT));
+  }
+  char report[160];
+  snprintf(report, sizeof(report), "%u reads vs %u at a fixed rate (%.0f%% saved), %u reads and %.2f C lag while drifting",
+    reads, fixedReads, 100.0 * (fixedReads - reads) / fixedReads, driftReads, maxDriftLagT);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_LESS_THAN(fixedReads / 2, reads);
+  // the step is caught on the next read, the lag is the step itself
+  TEST_ASSERT_LESS_THAN(4.1, maxLagH);
+  // the drift keeps resetting the interval instead of being read at the slowest rate
+  TEST_ASSERT_GREATER_THAN(6 * 3600 / ADAPTIVE_SENSOR_MAX_INTERVAL_SEC * 3 / 2, driftReads);
+  // threshold + one longest interval of drift + noise
+  const float driftPerMaxInterval = 0.9f * ADAPTIVE_SENSOR_MAX_INTERVAL_SEC / 3600;
+  TEST_ASSERT_LESS_THAN(ADAPTIVE_SENSOR_STABLE_DELTA_T + driftPerMaxInterval + 0.05f, maxDriftLagT);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_interval_doubles_while_flat);
+  RUN_TEST(test_step_resets_interval);
+  RUN_TEST(test_slow_drift_resets_interval);
+  RUN_TEST(test_replay_against_fixed_rate);
+  return UNITY_END();
+}
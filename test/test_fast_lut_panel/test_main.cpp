@@ -0,0 +1,80 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "fast_lut_panel.h"
+
+static FastLutPanel* panel;
+
+void setUp(void) {
+  panel = new FastLutPanel(-1, -1, -1, -1);
+  panel->init(0, true);
+}
+
+void tearDown(void) {
+  delete panel;
+}
+
+static void assertCommand(const PanelCommand& command, uint8_t expected, const std::vector<uint8_t>& data) {
+  TEST_ASSERT_EQUAL_HEX8(expected, command.command);
+  TEST_ASSERT_EQUAL(data.size(), command.data.size());
+  if (!data.empty()) TEST_ASSERT_EQUAL_HEX8_ARRAY(data.data(), command.data.data(), data.size());
+}
+
+static void test_first_refresh_is_full(void) {
+  panel->refreshFast();
+  TEST_ASSERT_EQUAL(2, panel->commands.size());
+  assertCommand(panel->commands[0], 0x22, { 0xF7 });
+  assertCommand(panel->commands[1], 0x20, {});
+  TEST_ASSERT_TRUE(panel->commands[1].waitedBusy);
+}
+
+static void test_register_lut_sequence(void) {
+  panel->refresh(false);
+  panel->commands.clear();
+  panel->refreshFast();
+  const std::vector<PanelCommand>& c = panel->commands;
+  TEST_ASSERT_EQUAL(8, c.size());
+  TEST_ASSERT_EQUAL_HEX8(0x32, c[0].command);
+  TEST_ASSERT_EQUAL(153, c[0].data.size());
+  TEST_ASSERT_EQUAL_HEX8(0x0A, c[0].data[60]); // group 0 drive frames
+  TEST_ASSERT_EQUAL_HEX8(0x22, c[0].data[144]); // frame rate
+  assertCommand(c[1], 0x3F, { 0x22 });
+  assertCommand(c[2], 0x03, { 0x17 });
+  assertCommand(c[3], 0x04, { 0x41, 0x00, 0x32 });
+  assertCommand(c[4], 0x2C, { 0x36 });
+  assertCommand(c[5], 0x3C, { 0x80 });
+  assertCommand(c[6], 0x22, { 0xC7 });
+  assertCommand(c[7], 0x20, {});
+  for (uint8_t i = 0; i < 7; ++i) TEST_ASSERT_FALSE(c[i].waitedBusy);
+  TEST_ASSERT_TRUE(c[7].waitedBusy);
+}
+
+// 0xC7 ends with the analog part off, hibernating must not power it off again.
+static void test_power_off_after_fast_refresh(void) {
+  panel->refresh(false);
+  panel->refresh(0, 0, 16, 16);
+  panel->refreshFast();
+  panel->commands.clear();
+  panel->hibernate();
+  TEST_ASSERT_EQUAL(1, panel->commands.size());
+  assertCommand(panel->commands[0], 0x10, { 0x01 });
+}
+
+// The standard partial refresh after a fast one loads the OTP waveform again by itself
+// (0xFC has "load LUT" set).
+static void test_partial_refresh_after_fast_one(void) {
+  panel->refresh(false);
+  panel->refreshFast();
+  panel->commands.clear();
+  panel->refresh(0, 0, 16, 16);
+  TEST_ASSERT_EQUAL(2, panel->commands.size());
+  assertCommand(panel->commands[0], 0x22, { 0xFC });
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_refresh_is_full);
+  RUN_TEST(test_register_lut_sequence);
+  RUN_TEST(test_power_off_after_fast_refresh);
+  RUN_TEST(test_partial_refresh_after_fast_one);
+  return UNITY_END();
+}
@@ -0,0 +1,93 @@
+#include <unity.h>
+#include "morse_table.h"
+
+static uint8_t units[MORSE_MAX_STEPS];
+
+void setUp(void) {
+  for (uint8_t& unit : units) unit = 0xFF;
+}
+
+void tearDown(void) {}
+
+static void test_dot_and_dash(void) {
+  // A: dot, symbol gap, dash
+  const uint8_t expected[] = { 1, 1, 3 };
+  TEST_ASSERT_EQUAL(3, compileMorse("A", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, 3);
+}
+
+static void test_letter_gap(void) {
+  // E T: dot, letter gap, dash
+  const uint8_t expected[] = { 1, 3, 3 };
+  TEST_ASSERT_EQUAL(3, compileMorse("ET", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, 3);
+}
+
+static void test_word_gap(void) {
+  // E, word gap, E; a run of spaces is still one gap
+  const uint8_t expected[] = { 1, 7, 1 };
+  TEST_ASSERT_EQUAL(3, compileMorse("E E", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, 3);
+  TEST_ASSERT_EQUAL(3, compileMorse("E   E", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, 3);
+}
+
+static void test_sos(void) {
+  const uint8_t expected[] = {
+    1, 1, 1, 1, 1, // S
+    3,
+    3, 1, 3, 1, 3, // O
+    3,
+    1, 1, 1, 1, 1, // S
+  };
+  TEST_ASSERT_EQUAL(sizeof(expected), compileMorse("sos", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, sizeof(expected));
+}
+
+static void test_digits(void) {
+  const uint8_t expected[] = { 1, 1, 3, 1, 3, 1, 3, 1, 3 };
+  TEST_ASSERT_EQUAL(9, compileMorse("1", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, 9);
+}
+
+static void test_unknown_and_leading_spaces_skipped(void) {
+  // no gap before the first tone, the unknown characters leave a letter gap, not a word gap
+  const uint8_t expected[] = { 1, 3, 3 };
+  TEST_ASSERT_EQUAL(3, compileMorse("  E?!T", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, units, 3);
+  TEST_ASSERT_EQUAL(0, compileMorse(" ?* ", units, MORSE_MAX_STEPS));
+  TEST_ASSERT_EQUAL(0, compileMorse("", units, MORSE_MAX_STEPS));
+}
+
+static void test_truncated_at_max_steps(void) {
+  // H is 7 entries, the 8th would be a gap with no tone after it
+  TEST_ASSERT_EQUAL(7, compileMorse("HH", units, 8));
+  TEST_ASSERT_EQUAL(0xFF, units[7]);
+  TEST_ASSERT_EQUAL(9, compileMorse("HH", units, 9));
+  TEST_ASSERT_EQUAL(3, units[7]);
+  TEST_ASSERT_EQUAL(1, units[8]);
+}
+
+static void test_count_always_odd(void) {
+  const char* messages[] = { "E", "TEMP HIGH", "0123456789", "humidity low 42", "SOS SOS SOS SOS SOS SOS" };
+  for (const char* msg : messages) {
+    for (uint8_t maxSteps = 1; maxSteps <= MORSE_MAX_STEPS; ++maxSteps) {
+      const uint8_t count = compileMorse(msg, units, maxSteps);
+      TEST_ASSERT_LESS_OR_EQUAL(maxSteps, count);
+      TEST_ASSERT_EQUAL(1, count % 2);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_dot_and_dash);
+  RUN_TEST(test_letter_gap);
+  RUN_TEST(test_word_gap);
+  RUN_TEST(test_sos);
+  RUN_TEST(test_digits);
+  RUN_TEST(test_unknown_and_leading_spaces_skipped);
+  RUN_TEST(test_truncated_at_max_steps);
+  RUN_TEST(test_count_always_odd);
+  return UNITY_END();
+}
@@ -0,0 +1,237 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include "panel_assets.h"
+#include "tiniest_num42.h"
+
+typedef GxEPD2_BW<GxEPD2_213_B74, GxEPD2_213_B74::HEIGHT> Reference;
+
+static const uint16_t RAM_SIZE = PanelCanvas::LINE_BYTES * PanelCanvas::NATIVE_HEIGHT;
+
+static PanelCanvas* canvas;
+static Reference* reference;
+
+// The landscape bitmap a native one was generated from, as drawInvertedBitmap() takes it
+// (MSB first rows, 0 = ink).
+struct LandscapeBitmap {
+  uint8_t bits[128 * 16];
+  int16_t width;
+  int16_t height;
+};
+
+static LandscapeBitmap landscape(const NativeBitmap& bitmap) {
+  LandscapeBitmap out = {};
+  out.width = bitmap.width;
+  out.height = bitmap.height;
+  memset(out.bits, 0xFF, sizeof(out.bits));
+  const uint8_t rowBytes = (bitmap.height + 7) / 8;
+  const int16_t lineBytes = (bitmap.width + 7) / 8;
+  for (int16_t x = 0; x < bitmap.width; ++x) {
+    for (int16_t j = 0; j < bitmap.height; ++j) {
+      if (!(bitmap.rows[x * rowBytes + j / 8] & (0x80 >> (j % 8)))) continue;
+      const int16_t y = bitmap.height - 1 - j;
+      out.bits[y * lineBytes + x / 8] &= ~(0x80 >> (x % 8));
+    }
+  }
+  return out;
+}
+
+static void drawBitmap(PanelCanvas& display, const NativeBitmap& bitmap, int16_t x, int16_t y, uint16_t color) {
+  display.drawNative(bitmap, x, y, color);
+}
+
+static void drawBitmap(Reference& display, const NativeBitmap& bitmap, int16_t x, int16_t y, uint16_t color) {
+  const LandscapeBitmap source = landscape(bitmap);
+  display.drawInvertedBitmap(x, y, source.bits, source.width, source.height, color);
+}
+
+// A main screen as DisplayController draws it, plus the cases it only hits at the edges:
+// clipping on every side, odd byte offsets, white over black and the per-pixel fallbacks.
+template <typename Display>
+static void drawScene(Display& display) {
+  display.fillScreen(GxEPD_WHITE);
+  display.setTextColor(GxEPD_BLACK);
+  display.setTextWrap(false);
+
+  display.setFont(&Font_04b03b);
+  display.setCursor(72, 5);
+  display.print("12.3.2024 21:07");
+  display.setCursor(3, 18);
+  display.print("-12.5 C  99.9%");
+  display.setFont(&big_digits);
+  display.setCursor(120, 30);
+  display.print("-23.4");
+  display.setCursor(240, 12); // off the right edge
+  display.print("88");
+
+  drawBitmap(display, nbmp_gauge_t_bg, 2, 19, GxEPD_BLACK);
+  drawBitmap(display, nbmp_gauge_h_bg, 2, 37, GxEPD_BLACK);
+  display.fillRect(40, 20, 5, 9, GxEPD_WHITE);
+  drawBitmap(display, nbmp_arrow_thin_dn, 40, 20, GxEPD_BLACK);
+  drawBitmap(display, nbmp_warning, -4, 115, GxEPD_BLACK);
+  drawBitmap(display, nbmp_no_sd_card, 220, -3, GxEPD_BLACK);
+  drawBitmap(display, nbmp_bat_full, 231, 1, GxEPD_BLACK);
+  display.fillRect(236, 2, 5, 3, GxEPD_WHITE);
+  display.drawPixel(230, 2, GxEPD_BLACK);
+
+  display.drawRect(131, 80, 104, 39, GxEPD_BLACK);
+  display.fillRect(128, 76, 16, 15, GxEPD_WHITE);
+  drawBitmap(display, nbmp_stats_hint, 128, 76, GxEPD_BLACK);
+  display.drawFastHLine(144, 90, 90, GxEPD_BLACK);
+  display.drawFastHLine(132, 104, 102, GxEPD_BLACK);
+  display.drawFastVLine(138, 91, 27, GxEPD_BLACK);
+  display.drawFastVLine(170, 81, 37, GxEPD_BLACK);
+  display.drawFastVLine(202, 81, 37, GxEPD_BLACK);
+
+  display.fillRect(-5, 60, 30, 70, GxEPD_BLACK);
+  display.fillRect(3, 61, 7, 1, GxEPD_WHITE);
+  display.drawFastVLine(249, -10, 200, GxEPD_BLACK);
+  display.drawFastHLine(-10, 121, 300, GxEPD_BLACK);
+  display.drawFastVLine(250, 10, 10, GxEPD_BLACK);
+  display.drawFastHLine(10, 122, 10, GxEPD_BLACK);
+  display.drawLine(30, 62, 110, 75, GxEPD_BLACK);
+  display.drawCircle(100, 100, 14, GxEPD_BLACK);
+
+  // not a native font, and wrapping on: the GFX path
+  display.setFont(&tiniest_num42);
+  display.setCursor(60, 110);
+  display.print("42%");
+  display.setTextWrap(true);
+  display.setFont(&Font_04b03b);
+  display.setCursor(230, 70);
+  display.print("wrap");
+}
+
+// What the panel RAM holds after each one is written out, the reference as GxEPD2_BW does.
+static const uint8_t* referenceRam() {
+  reference->display();
+  return reference->epd2.ram;
+}
+
+static const uint8_t* canvasRam() {
+  GxEPD2_213_B74& epd = reference->epd2;
+  epd.writeImage(canvas->buffer(), 0, 0, PanelCanvas::NATIVE_WIDTH, PanelCanvas::NATIVE_HEIGHT);
+  return epd.ram;
+}
+
+void setUp(void) {
+  canvas = new PanelCanvas(nativeFonts, sizeof(nativeFonts) / sizeof(nativeFonts[0]));
+  reference = new Reference(GxEPD2_213_B74(-1, -1, -1, -1));
+  reference->setRotation(1);
+}
+
+void tearDown(void) {
+  delete canvas;
+  delete reference;
+}
+
+static void test_same_size_as_rotated_driver(void) {
+  TEST_ASSERT_EQUAL(reference->width(), canvas->width());
+  TEST_ASSERT_EQUAL(reference->height(), canvas->height());
+}
+
+static void test_scene_matches_gxepd2(void) {
+  static uint8_t expected[RAM_SIZE];
+  drawScene(*reference);
+  memcpy(expected, referenceRam(), RAM_SIZE);
+  drawScene(*canvas);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, canvasRam(), RAM_SIZE);
+}
+
+// Every native bitmap at every bit offset within a buffer byte, black on white and white on black.
+static void test_bitmaps_at_every_offset(void) {
+  static uint8_t expected[RAM_SIZE];
+  const NativeBitmap* bitmaps[] = { &nbmp_gauge_t_bg, &nbmp_warning, &nbmp_danger, &nbmp_h_icon, &nbmp_t_icon, &nbmp_sd_card_icon };
+  for (const NativeBitmap* bitmap : bitmaps) {
+    for (uint16_t color : { GxEPD_BLACK, GxEPD_WHITE }) {
+      reference->fillScreen(color ^ 0xFFFF);
+      canvas->fillScreen(color ^ 0xFFFF);
+      for (int16_t y = -3; y < 9; ++y) {
+        drawBitmap(*reference, *bitmap, 3 * y, y + 10 * (y & 1), color);
+        drawBitmap(*canvas, *bitmap, 3 * y, y + 10 * (y & 1), color);
+      }
+      drawBitmap(*reference, *bitmap, 1, PanelCanvas::VISIBLE_WIDTH - 5, color);
+      drawBitmap(*canvas, *bitmap, 1, PanelCanvas::VISIBLE_WIDTH - 5, color);
+      memcpy(expected, referenceRam(), RAM_SIZE);
+      TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, canvasRam(), RAM_SIZE);
+    }
+  }
+}
+
+static void test_native_window_covers_rect(void) {
+  int16_t nx, ny, nw, nh;
+  PanelCanvas::nativeWindow(131, 80, 104, 39, &nx, &ny, &nw, &nh);
+  TEST_ASSERT_EQUAL(0, nx % 8);
+  TEST_ASSERT_EQUAL(0, nw % 8);
+  TEST_ASSERT_LESS_OR_EQUAL(PanelCanvas::VISIBLE_WIDTH - 80 - 39, nx);
+  TEST_ASSERT_GREATER_OR_EQUAL(PanelCanvas::VISIBLE_WIDTH - 80, nx + nw);
+  TEST_ASSERT_EQUAL(131, ny);
+  TEST_ASSERT_EQUAL(104, nh);
+  // clipped to the panel
+  PanelCanvas::nativeWindow(-5, -5, 300, 200, &nx, &ny, &nw, &nh);
+  TEST_ASSERT_EQUAL(0, nx);
+  TEST_ASSERT_EQUAL(PanelCanvas::NATIVE_WIDTH, nw);
+  TEST_ASSERT_EQUAL(0, ny);
+  TEST_ASSERT_EQUAL(PanelCanvas::NATIVE_HEIGHT, nh);
+}
+
+template <typename F>
+static double usPerRun(F f, uint32_t runs) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < runs; ++i) f();
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+// Raster time of the scene with the per-pixel GxEPD2_BW path and with the canvas. The
+// reference draws its bitmaps from landscape copies made up front, as the firmware did.
+static void test_benchmark_against_gxepd2(void) {
+  const uint32_t runs = 2000;
+  const LandscapeBitmap gaugeT = landscape(nbmp_gauge_t_bg);
+  const LandscapeBitmap gaugeH = landscape(nbmp_gauge_h_bg);
+  const LandscapeBitmap hint = landscape(nbmp_stats_hint);
+  auto frame = [&](auto& display, auto bitmaps) {
+    display.fillScreen(GxEPD_WHITE);
+    display.setTextColor(GxEPD_BLACK);
+    display.setTextWrap(false);
+    display.setFont(&Font_04b03b);
+    display.setCursor(72, 5);
+    display.print("12.3.2024 21:07");
+    display.setFont(&big_digits);
+    display.setCursor(120, 30);
+    display.print("-23.4");
+    bitmaps(display);
+    display.drawRect(131, 80, 104, 39, GxEPD_BLACK);
+    display.fillRect(128, 76, 16, 15, GxEPD_WHITE);
+    display.drawFastHLine(132, 104, 102, GxEPD_BLACK);
+    display.drawFastVLine(170, 81, 37, GxEPD_BLACK);
+  };
+  const double referenceUs = usPerRun([&]() {
+    frame(*reference, [&](Reference& display) {
+      display.drawInvertedBitmap(2, 19, gaugeT.bits, gaugeT.width, gaugeT.height, GxEPD_BLACK);
+      display.drawInvertedBitmap(2, 37, gaugeH.bits, gaugeH.width, gaugeH.height, GxEPD_BLACK);
+      display.drawInvertedBitmap(128, 76, hint.bits, hint.width, hint.height, GxEPD_BLACK);
+    });
+  }, runs);
+  const double canvasUs = usPerRun([&]() {
+    frame(*canvas, [&](PanelCanvas& display) {
+      display.drawNative(nbmp_gauge_t_bg, 2, 19, GxEPD_BLACK);
+      display.drawNative(nbmp_gauge_h_bg, 2, 37, GxEPD_BLACK);
+      display.drawNative(nbmp_stats_hint, 128, 76, GxEPD_BLACK);
+    });
+  }, runs);
+  char report[120];
+  snprintf(report, sizeof(report), "frame: canvas %.1f us, GxEPD2_BW %.1f us (%.1fx)", canvasUs, referenceUs, referenceUs / canvasUs);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_LESS_THAN(referenceUs, canvasUs);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_same_size_as_rotated_driver);
+  RUN_TEST(test_scene_matches_gxepd2);
+  RUN_TEST(test_bitmaps_at_every_offset);
+  RUN_TEST(test_native_window_covers_rect);
+  RUN_TEST(test_benchmark_against_gxepd2);
+  return UNITY_END();
+}
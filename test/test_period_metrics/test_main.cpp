@@ -0,0 +1,172 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <random>
+#include <vector>
+#include "period_metrics.h"
+
+static const uint32_t DAY_SEC = HOUR_PER_DAY * MIN_PER_HOUR * SEC_PER_MIN;
+
+struct Reading {
+  float value;
+  AlertLevel band;
+  uint32_t seconds;
+};
+
+static std::vector<Reading> randomReadings(uint32_t seed, uint32_t count) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> value(60, 80);
+  std::uniform_int_distribution<uint32_t> seconds(20, 600);
+  std::vector<Reading> out;
+  for (uint32_t i = 0; i < count; ++i) {
+    const float v = value(rng);
+    out.push_back({ v, v > 75 ? ALERT_DANGER : v > 72 ? ALERT_WARNING : ALERT_NONE, seconds(rng) });
+  }
+  return out;
+}
+
+// Weighted mean and population variance, computed twice over in double.
+static void reference(const std::vector<Reading>& readings, double* mean, double* variance) {
+  double weight = 0, sum = 0;
+  for (const Reading& r : readings) {
+    weight += r.seconds;
+    sum += (double)r.value * r.seconds;
+  }
+  *mean = sum / weight;
+  double squares = 0;
+  for (const Reading& r : readings) squares += r.seconds * (r.value - *mean) * (r.value - *mean);
+  *variance = squares / weight;
+}
+
+// A whole day of 40 s readings at `value`.
+static void addDay(TumblingMetrics& metrics, float value, AlertLevel band) {
+  for (uint32_t i = 0; i < DAY_SEC / SENSOR_READ_INTERVAL_SEC; ++i) metrics.add(value, band, SENSOR_READ_INTERVAL_SEC);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void test_empty_period(void) {
+  PeriodMetrics metrics;
+  metrics.clear();
+  metrics.add(21, ALERT_NONE, 0);
+  const ExposureStatistics<float> stats = metrics.statistics();
+  TEST_ASSERT_TRUE(std::isnan(stats.mean));
+  TEST_ASSERT_TRUE(std::isnan(stats.stddev));
+}
+
+static void test_weighted_mean_and_deviation(void) {
+  const std::vector<Reading> readings = randomReadings(41, 20000);
+  PeriodMetrics metrics;
+  metrics.clear();
+  for (const Reading& r : readings) metrics.add(r.value, r.band, r.seconds);
+  double mean, variance;
+  reference(readings, &mean, &variance);
+  const ExposureStatistics<float> stats = metrics.statistics();
+  TEST_ASSERT_FLOAT_WITHIN(0.001, mean, stats.mean);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, sqrt(variance), stats.stddev);
+}
+
+// Two readings: 3 h at 20, 1 h at 24 -> mean 21, deviation sqrt(3).
+static void test_weights_are_seconds(void) {
+  PeriodMetrics metrics;
+  metrics.clear();
+  metrics.add(20, ALERT_NONE, 3 * 3600);
+  metrics.add(24, ALERT_DANGER, 3600);
+  const ExposureStatistics<float> stats = metrics.statistics();
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 21, stats.mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, sqrtf(3), stats.stddev);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 25, stats.outOfBandPercent);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 25, stats.dangerPercent);
+}
+
+static void test_merge_equals_one_period(void) {
+  const std::vector<Reading> readings = randomReadings(42, 6000);
+  PeriodMetrics all, first, second;
+  all.clear();
+  first.clear();
+  second.clear();
+  for (size_t i = 0; i < readings.size(); ++i) {
+    const Reading& r = readings[i];
+    all.add(r.value, r.band, r.seconds);
+    (i < 2000 ? first : second).add(r.value, r.band, r.seconds);
+  }
+  first.merge(second);
+  const ExposureStatistics<float> expected = all.statistics();
+  const ExposureStatistics<float> merged = first.statistics();
+  TEST_ASSERT_FLOAT_WITHIN(0.001, expected.mean, merged.mean);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, expected.stddev, merged.stddev);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.outOfBandPercent, merged.outOfBandPercent);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.dangerPercent, merged.dangerPercent);
+  // merging an empty period changes nothing
+  PeriodMetrics empty;
+  empty.clear();
+  first.merge(empty);
+  TEST_ASSERT_EQUAL_FLOAT(merged.mean, first.statistics().mean);
+}
+
+static void test_day_closes_into_week_and_month(void) {
+  TumblingMetrics metrics;
+  metrics.clear();
+  addDay(metrics, 70, ALERT_NONE);
+  // the new day is still empty, week and month hold the closed one
+  TEST_ASSERT_TRUE(std::isnan(metrics.dayStatistics().mean));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 70, metrics.weekStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 70, metrics.monthStatistics().mean);
+  // half a day in warning: the running day counts in the week and month
+  for (uint32_t i = 0; i < DAY_SEC / 2 / SENSOR_READ_INTERVAL_SEC; ++i) metrics.add(73, ALERT_WARNING, SENSOR_READ_INTERVAL_SEC);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 73, metrics.dayStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 100, metrics.dayStatistics().outOfBandPercent);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 71, metrics.weekStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 100.0f / 3, metrics.weekStatistics().outOfBandPercent);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, metrics.weekStatistics().dangerPercent);
+}
+
+// The week tumbles after 7 days: the 8th starts a new one, the month keeps all of them.
+static void test_week_rollover(void) {
+  TumblingMetrics metrics;
+  metrics.clear();
+  for (uint8_t day = 0; day < 6; ++day) addDay(metrics, 70, ALERT_NONE);
+  addDay(metrics, 76, ALERT_DANGER);
+  for (uint32_t i = 0; i < DAY_SEC / 2 / SENSOR_READ_INTERVAL_SEC; ++i) metrics.add(66, ALERT_NONE, SENSOR_READ_INTERVAL_SEC);
+  // only the running day of the new week, none of the danger day before it
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 66, metrics.weekStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, metrics.weekStatistics().dangerPercent);
+  // 6 days at 70, one at 76, half a day at 66
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, (6 * 70 + 76 + 0.5f * 66) / 7.5f, metrics.monthStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 100 / 7.5f, metrics.monthStatistics().dangerPercent);
+}
+
+static void test_month_rollover(void) {
+  TumblingMetrics metrics;
+  metrics.clear();
+  for (uint8_t day = 0; day < DAY_PER_MONTH; ++day) addDay(metrics, day < 10 ? 76 : 70, day < 10 ? ALERT_DANGER : ALERT_NONE);
+  TEST_ASSERT_TRUE(std::isnan(metrics.monthStatistics().mean));
+  addDay(metrics, 68, ALERT_NONE);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 68, metrics.monthStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, metrics.monthStatistics().dangerPercent);
+}
+
+// A reading after a long gap stands for all of it, split over the days it covers.
+static void test_gap_spans_days(void) {
+  TumblingMetrics metrics;
+  metrics.clear();
+  metrics.add(70, ALERT_NONE, DAY_SEC / 2);
+  metrics.add(74, ALERT_WARNING, 2 * DAY_SEC);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 74, metrics.dayStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, (0.5f * 70 + 2 * 74) / 2.5f, metrics.weekStatistics().mean);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3, 100 * 2 / 2.5f, metrics.weekStatistics().outOfBandPercent);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_period);
+  RUN_TEST(test_weighted_mean_and_deviation);
+  RUN_TEST(test_weights_are_seconds);
+  RUN_TEST(test_merge_equals_one_period);
+  RUN_TEST(test_day_closes_into_week_and_month);
+  RUN_TEST(test_week_rollover);
+  RUN_TEST(test_month_rollover);
+  RUN_TEST(test_gap_spans_days);
+  return UNITY_END();
+}
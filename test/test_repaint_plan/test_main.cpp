@@ -0,0 +1,135 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "repaint_plan.h"
+
+typedef DisplayController::DrawFlags DrawFlags;
+
+static const uint8_t UPDATE_REGISTER_LUT = 0xC7;
+static const uint8_t UPDATE_OTP_PARTIAL = 0xFC;
+
+static FastLutPanel* panel;
+static uint8_t buffer[PanelCanvas::LINE_BYTES * PanelCanvas::NATIVE_HEIGHT];
+
+struct Flushed {
+  uint8_t fast;
+  uint8_t standard;
+};
+
+void setUp(void) {
+  panel = new FastLutPanel(-1, -1, -1, -1);
+  panel->init(0, true);
+  // past the full refresh after power-up, as in a partial repaint
+  panel->refresh(false);
+  panel->commands.clear();
+}
+
+void tearDown(void) {
+  delete panel;
+}
+
+// Runs a partial repaint of `flags` as DisplayController::flush() does.
+static Flushed flush(DrawFlags flags) {
+  DirtyArea areas[DIRTY_AREAS_MAX];
+  RefreshWindow windows[DIRTY_AREAS_MAX];
+  const uint8_t count = planRefreshWindows(areas, dirtyAreasFor(flags, areas), windows);
+  Flushed flushed = {};
+  flushWindows(*panel, buffer, windows, count, [&flushed](const RefreshWindow& window, uint32_t us) {
+    TEST_ASSERT_TRUE(!window.fast || (uint32_t) window.w * window.h <= FAST_LUT_MAX_AREA_PX);
+    ++(window.fast ? flushed.fast : flushed.standard);
+  });
+  return flushed;
+}
+
+static uint8_t updatesWith(uint8_t mode) {
+  uint8_t count = 0;
+  for (const PanelCommand& command : panel->commands) {
+    if (command.command == 0x22 && command.data.size() == 1 && command.data[0] == mode) ++count;
+  }
+  return count;
+}
+
+static bool covers(const RefreshWindow& outer, int16_t x, int16_t y, int16_t w, int16_t h) {
+  return x >= outer.x && y >= outer.y && x + w <= outer.x + outer.w && y + h <= outer.y + outer.h;
+}
+
+// The update after every reading: the status bar and the readings run the fast waveform, only
+// the gauges need the OTP one.
+static void test_current_reading_update_runs_fast(void) {
+  const Flushed flushed = flush(drawFlagsFor(UpdateFlags::CURRENT_READING));
+  TEST_ASSERT_EQUAL(3, flushed.fast);
+  TEST_ASSERT_EQUAL(1, flushed.standard);
+  TEST_ASSERT_EQUAL(3, updatesWith(UPDATE_REGISTER_LUT));
+  TEST_ASSERT_EQUAL(1, updatesWith(UPDATE_OTP_PARTIAL));
+}
+
+static void test_status_bar_update_is_fast_only(void) {
+  const Flushed flushed = flush(drawFlagsFor(UpdateFlags::NONE));
+  TEST_ASSERT_EQUAL(2, flushed.fast);
+  TEST_ASSERT_EQUAL(0, flushed.standard);
+  TEST_ASSERT_EQUAL(0, updatesWith(UPDATE_OTP_PARTIAL));
+}
+
+static void test_large_areas_share_one_window(void) {
+  const Flushed flushed = flush(DrawFlags::GAUGES | DrawFlags::STATISTICS | DrawFlags::HISTORY_GRAPH);
+  TEST_ASSERT_EQUAL(0, flushed.fast);
+  TEST_ASSERT_EQUAL(1, flushed.standard);
+}
+
+static void test_small_area_inside_large_one(void) {
+  const DirtyArea areas[] = { { 0, 64, 250, 58 }, { 10, 70, 20, 20 } };
+  RefreshWindow windows[2];
+  TEST_ASSERT_EQUAL(1, planRefreshWindows(areas, 2, windows));
+  TEST_ASSERT_FALSE(windows[0].fast);
+}
+
+// Whatever the flags, every area ends up in a window and no fast window grows past the limit.
+static void test_windows_cover_every_area(void) {
+  for (uint16_t bits = 0; bits < 1 << DIRTY_AREAS_MAX; ++bits) {
+    const DrawFlags flags = static_cast<DrawFlags>(bits << 1);
+    DirtyArea areas[DIRTY_AREAS_MAX];
+    RefreshWindow windows[DIRTY_AREAS_MAX];
+    const uint8_t areaCount = dirtyAreasFor(flags, areas);
+    const uint8_t windowCount = planRefreshWindows(areas, areaCount, windows);
+    TEST_ASSERT_LESS_OR_EQUAL(areaCount, windowCount);
+    uint8_t standard = 0;
+    for (uint8_t j = 0; j < windowCount; ++j) {
+      if (windows[j].fast) TEST_ASSERT_LESS_OR_EQUAL(FAST_LUT_MAX_AREA_PX, (uint32_t) windows[j].w * windows[j].h);
+      else ++standard;
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(1, standard);
+    for (uint8_t i = 0; i < areaCount; ++i) {
+      int16_t nx, ny, nw, nh;
+      PanelCanvas::nativeWindow(areas[i].x, areas[i].y, areas[i].w, areas[i].h, &nx, &ny, &nw, &nh);
+      bool covered = false;
+      for (uint8_t j = 0; j < windowCount; ++j) covered = covered || covers(windows[j], nx, ny, nw, nh);
+      TEST_ASSERT_TRUE(covered);
+    }
+  }
+}
+
+// Both panel RAMs hold the canvas in every window afterwards.
+static void test_windows_written_to_ram(void) {
+  for (uint16_t i = 0; i < sizeof(buffer); ++i) buffer[i] = i * 13 + 7;
+  memset(panel->ram, 0, sizeof(panel->ram));
+  DirtyArea areas[DIRTY_AREAS_MAX];
+  RefreshWindow windows[DIRTY_AREAS_MAX];
+  const uint8_t count = planRefreshWindows(areas, dirtyAreasFor(drawFlagsFor(UpdateFlags::CURRENT_READING), areas), windows);
+  flushWindows(*panel, buffer, windows, count, [](const RefreshWindow&, uint32_t) {});
+  for (uint8_t j = 0; j < count; ++j) {
+    for (int16_t y = windows[j].y; y < windows[j].y + windows[j].h; ++y) {
+      const uint16_t at = y * PanelCanvas::LINE_BYTES + windows[j].x / 8;
+      TEST_ASSERT_EQUAL_HEX8_ARRAY(buffer + at, panel->ram + at, windows[j].w / 8);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_current_reading_update_runs_fast);
+  RUN_TEST(test_status_bar_update_is_fast_only);
+  RUN_TEST(test_large_areas_share_one_window);
+  RUN_TEST(test_small_area_inside_large_one);
+  RUN_TEST(test_windows_cover_every_area);
+  RUN_TEST(test_windows_written_to_ram);
+  return UNITY_END();
+}
@@ -0,0 +1,174 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+#include "ring_buffer.h"
+
+/*
+ The ring the stats tiers used before, locoduino RingBuf: every access wraps its index, a
+ push into a full ring pops the oldest value first.
+*/
+template <typename T, long S>
+class LegacyRingBuf {
+public:
+  uint16_t size() const { return count; }
+
+  T operator[](uint16_t index) const { return buf[(head + index) % S]; }
+
+  void pushOverwrite(const T& value) {
+    if (count == S) {
+      head = (head + 1) % S;
+      --count;
+    }
+    buf[(head + count) % S] = value;
+    ++count;
+  }
+
+private:
+  T buf[S];
+  uint16_t head = 0;
+  uint16_t count = 0;
+};
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+template <long S>
+static void checkSame(const RingBuffer<uint16_t, S>& ring, const std::deque<uint16_t>& ref, std::mt19937& rnd) {
+  TEST_ASSERT_EQUAL(ref.size(), ring.size());
+  TEST_ASSERT_EQUAL(ref.empty(), ring.isEmpty());
+  TEST_ASSERT_EQUAL(ref.size() == (size_t)S, ring.isFull());
+  if (ref.empty()) return;
+  TEST_ASSERT_EQUAL(ref.front(), ring.oldest());
+  TEST_ASSERT_EQUAL(ref.back(), ring.newest());
+
+  std::vector<uint16_t> walked;
+  ring.forEach([&](uint16_t v) { walked.push_back(v); });
+  TEST_ASSERT_EQUAL(ref.size(), walked.size());
+  const auto a = ring.first();
+  const auto b = ring.second();
+  TEST_ASSERT_EQUAL(ref.size(), a.length + b.length);
+  for (size_t i = 0; i < ref.size(); ++i) {
+    TEST_ASSERT_EQUAL(ref[i], ring[i]);
+    TEST_ASSERT_EQUAL(ref[i], walked[i]);
+    TEST_ASSERT_EQUAL(ref[i], i < a.length ? a.data[i] : b.data[i - a.length]);
+  }
+
+  uint16_t out[S + 1];
+  const uint16_t max = rnd() % (S + 2);
+  const uint16_t copied = ring.copyTo(out, max);
+  TEST_ASSERT_EQUAL(std::min<size_t>(max, ref.size()), copied);
+  for (uint16_t i = 0; i < copied; ++i) TEST_ASSERT_EQUAL(ref[i], out[i]);
+}
+
+template <long S>
+static void randomOps(uint32_t seed, uint32_t ops) {
+  std::mt19937 rnd(seed);
+  RingBuffer<uint16_t, S> ring;
+  std::deque<uint16_t> ref;
+  auto pushRef = [&](uint16_t v, std::vector<uint16_t>* evicted) {
+    if (ref.size() == (size_t)S) {
+      if (evicted) evicted->push_back(ref.front());
+      ref.pop_front();
+    }
+    ref.push_back(v);
+  };
+
+  for (uint32_t op = 0; op < ops; ++op) {
+    const uint32_t kind = rnd() % 100;
+    const uint16_t value = rnd();
+    if (kind < 60) {
+      ring.pushOverwrite(value);
+      pushRef(value, nullptr);
+    } else if (kind < 80) {
+      std::vector<uint16_t> evicted, expected;
+      ring.pushOverwrite(value, [&](const uint16_t& v) { evicted.push_back(v); });
+      pushRef(value, &expected);
+      TEST_ASSERT_TRUE(evicted == expected);
+    } else if (kind < 88) {
+      const uint16_t n = rnd() % (2 * S + 1);
+      std::vector<uint16_t> values(n + 1), evicted, expected;
+      for (uint16_t& v : values) v = rnd();
+      ring.pushOverwrite(values.data(), n, [&](const uint16_t& v) { evicted.push_back(v); });
+      for (uint16_t i = 0; i < n; ++i) pushRef(values[i], &expected);
+      TEST_ASSERT_TRUE(evicted == expected);
+    } else if (kind < 98) {
+      // mostly short runs, sometimes past the capacity (a long gap in the readings)
+      const uint32_t n = kind < 95 ? rnd() % (S + 1) : S + rnd() % 100000;
+      ring.pushRepeated(value, n);
+      for (uint32_t i = 0; i < std::min<uint32_t>(n, S); ++i) pushRef(value, nullptr);
+    } else {
+      ring.clear();
+      ref.clear();
+    }
+    checkSame<S>(ring, ref, rnd);
+  }
+}
+
+static void test_matches_deque_small(void) {
+  randomOps<1>(1, 20000);
+  randomOps<2>(2, 20000);
+  randomOps<7>(3, 30000);
+}
+
+static void test_matches_deque_tier_sizes(void) {
+  randomOps<69>(4, 100000);
+  randomOps<300>(5, 30000);
+}
+
+template <typename F>
+static double nsPerRun(F f, uint32_t runs) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < runs; ++i) f();
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+// Summing a wrapped tier the way the statistics do, and pushing into it, against RingBuf.
+static void test_benchmark_against_ringbuf(void) {
+  const long S = 69; // hour tier
+  const uint32_t runs = 200000;
+  RingBuffer<uint16_t, S> ring;
+  LegacyRingBuf<uint16_t, S> legacy;
+  for (uint16_t i = 0; i < S + S / 3; ++i) {
+    ring.pushOverwrite(i * 37);
+    legacy.pushOverwrite(i * 37);
+  }
+  volatile uint32_t sink = 0;
+  uint32_t ringSum = 0, legacySum = 0;
+
+  const double legacySumNs = nsPerRun([&]() {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < legacy.size(); ++i) sum += legacy[i];
+    legacySum = sum;
+    sink = sink + sum;
+  }, runs);
+  const double ringSumNs = nsPerRun([&]() {
+    uint32_t sum = 0;
+    ring.forEach([&](uint16_t v) { sum += v; });
+    ringSum = sum;
+    sink = sink + sum;
+  }, runs);
+  TEST_ASSERT_EQUAL(legacySum, ringSum);
+
+  uint16_t value = 0;
+  const double legacyPushNs = nsPerRun([&]() { legacy.pushOverwrite(value++); }, runs * 10);
+  value = 0;
+  const double ringPushNs = nsPerRun([&]() { ring.pushOverwrite(value++); }, runs * 10);
+  for (uint16_t i = 0; i < S; ++i) TEST_ASSERT_EQUAL(legacy[i], ring[i]);
+
+  char report[160];
+  snprintf(report, sizeof(report), "%ld entries: sum %.1f ns (RingBuf %.1f ns), push %.2f ns (RingBuf %.2f ns)",
+    S, ringSumNs, legacySumNs, ringPushNs, legacyPushNs);
+  TEST_MESSAGE(report);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_deque_small);
+  RUN_TEST(test_matches_deque_tier_sizes);
+  RUN_TEST(test_benchmark_against_ringbuf);
+  return UNITY_END();
+}
@@ -0,0 +1,213 @@
+#include <unity.h>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "credentials.h"
+#include "runtime_config.h"
+
+// payload offset of the Wi-Fi SSID: intervals 12, bands 2 x 20, battery 4, unit 1, offsets 8
+#define SSID_AT (CONFIG_HEADER_BYTES + 65)
+
+static RuntimeConfig defaults;
+
+static std::vector<uint8_t> serialize(const RuntimeConfig& config) {
+  std::vector<uint8_t> blob(CONFIG_MAX_BYTES);
+  blob.resize(configSerialize(config, blob.data(), blob.size()));
+  TEST_ASSERT_GREATER_THAN(0, blob.size());
+  return blob;
+}
+
+// Rewrites the payload length and the CRC after the payload was edited.
+static void reseal(std::vector<uint8_t>& blob) {
+  blob.resize(blob.size() - 4);
+  const size_t payloadLen = blob.size() - CONFIG_HEADER_BYTES;
+  blob[4] = payloadLen;
+  blob[5] = payloadLen >> 8;
+  const uint32_t crc = configCrc32(blob.data(), blob.size());
+  for (int i = 0; i < 4; ++i) blob.push_back(crc >> (8 * i));
+}
+
+static ConfigStatus parse(const std::vector<uint8_t>& blob, RuntimeConfig* out) {
+  return configParse(blob.data(), blob.size(), out);
+}
+
+void setUp(void) {
+  configDefaults(&defaults);
+}
+
+void tearDown(void) {}
+
+static void test_defaults_round_trip(void) {
+  TEST_ASSERT_TRUE(configValid(defaults));
+  RuntimeConfig config = defaults;
+  config.sensorReadIntervalSec = 60;
+  config.gmtOffsetSec = -5 * 3600;
+  config.degreesUnit = FARENHEIT;
+  strcpy(config.ntpServers[2], "ntp.example.org");
+  RuntimeConfig parsed;
+  memset(&parsed, 0xAA, sizeof(parsed));
+  TEST_ASSERT_EQUAL(ConfigStatus::OK, parse(serialize(config), &parsed));
+  TEST_ASSERT_EQUAL(60, parsed.sensorReadIntervalSec);
+  TEST_ASSERT_EQUAL(-5 * 3600, parsed.gmtOffsetSec);
+  TEST_ASSERT_EQUAL(FARENHEIT, parsed.degreesUnit);
+  TEST_ASSERT_EQUAL_FLOAT(defaults.humidityBands.warningHigh, parsed.humidityBands.warningHigh);
+  TEST_ASSERT_EQUAL_STRING(WIFI_SSID, parsed.wifiSsid);
+  TEST_ASSERT_EQUAL_STRING(WIFI_PASSWORD, parsed.wifiPassword);
+  TEST_ASSERT_EQUAL_STRING("ntp.example.org", parsed.ntpServers[2]);
+  TEST_ASSERT_EQUAL(0, memcmp(serialize(config).data(), serialize(parsed).data(), serialize(config).size()));
+}
+
+static void test_bad_header_and_crc(void) {
+  RuntimeConfig parsed = defaults;
+  std::vector<uint8_t> blob = serialize(defaults);
+  blob[0] ^= 1;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_MAGIC, parse(blob, &parsed));
+  blob = serialize(defaults);
+  blob[2] = CONFIG_FORMAT_VERSION + 1;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VERSION, parse(blob, &parsed));
+  blob = serialize(defaults);
+  blob[SSID_AT + 1] ^= 0x20;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_CRC, parse(blob, &parsed));
+  blob = serialize(defaults);
+  blob.back() ^= 0x80;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_CRC, parse(blob, &parsed));
+}
+
+static void test_out_untouched_on_error(void) {
+  RuntimeConfig parsed = defaults;
+  parsed.sensorReadIntervalSec = 123;
+  std::vector<uint8_t> blob = serialize(defaults);
+  blob[3] = 1; // reserved byte is covered by the CRC
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_CRC, parse(blob, &parsed));
+  TEST_ASSERT_EQUAL(123, parsed.sensorReadIntervalSec);
+}
+
+static void test_truncated(void) {
+  RuntimeConfig parsed = defaults;
+  const std::vector<uint8_t> full = serialize(defaults);
+  TEST_ASSERT_EQUAL(ConfigStatus::TOO_SHORT, configParse(full.data(), 0, &parsed));
+  TEST_ASSERT_EQUAL(ConfigStatus::TOO_SHORT, configParse(full.data(), CONFIG_HEADER_BYTES + 3, &parsed));
+  // cut in transfer: the header promises more than there is
+  TEST_ASSERT_EQUAL(ConfigStatus::TOO_SHORT, configParse(full.data(), full.size() - 1, &parsed));
+  // sealed with a short payload: the fields run past its end
+  for (size_t cut : { (size_t)1, (size_t)10, full.size() - SSID_AT, full.size() - CONFIG_HEADER_BYTES - 4 }) {
+    std::vector<uint8_t> blob = full;
+    blob.erase(blob.end() - 4 - cut, blob.end() - 4);
+    reseal(blob);
+    TEST_ASSERT_EQUAL(ConfigStatus::TOO_SHORT, parse(blob, &parsed));
+  }
+}
+
+static void test_newer_revision_fields_ignored(void) {
+  RuntimeConfig config = defaults;
+  config.alarmIntervalSec = 600;
+  std::vector<uint8_t> blob = serialize(config);
+  const uint8_t extra[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+  blob.insert(blob.end() - 4, extra, extra + sizeof(extra));
+  reseal(blob);
+  RuntimeConfig parsed;
+  TEST_ASSERT_EQUAL(ConfigStatus::OK, parse(blob, &parsed));
+  TEST_ASSERT_EQUAL(600, parsed.alarmIntervalSec);
+  TEST_ASSERT_EQUAL_STRING(defaults.ntpServers[2], parsed.ntpServers[2]);
+}
+
+static void test_string_lengths(void) {
+  RuntimeConfig parsed;
+  std::vector<uint8_t> blob = serialize(defaults);
+  const size_t ssidLen = blob[SSID_AT];
+  TEST_ASSERT_EQUAL(strlen(WIFI_SSID), ssidLen);
+  for (size_t len : { (size_t)CONFIG_SSID_LEN - 1, (size_t)CONFIG_SSID_LEN, (size_t)200 }) {
+    std::vector<uint8_t> edited = blob;
+    const std::string ssid(len, 'x');
+    edited.erase(edited.begin() + SSID_AT, edited.begin() + SSID_AT + 1 + ssidLen);
+    edited.insert(edited.begin() + SSID_AT, (uint8_t)len);
+    edited.insert(edited.begin() + SSID_AT + 1, ssid.begin(), ssid.end());
+    reseal(edited);
+    const ConfigStatus status = parse(edited, &parsed);
+    if (len < CONFIG_SSID_LEN) {
+      TEST_ASSERT_EQUAL(ConfigStatus::OK, status);
+      TEST_ASSERT_EQUAL_STRING(ssid.c_str(), parsed.wifiSsid);
+    } else {
+      TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, status);
+    }
+  }
+}
+
+static void test_invalid_values(void) {
+  RuntimeConfig parsed;
+  RuntimeConfig config = defaults;
+  config.humidityBands.warningLow = config.humidityBands.warningHigh;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+  config = defaults;
+  config.temperatureBands.dangerHigh = NAN;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+  config = defaults;
+  config.temperatureBands.hysteresis = (config.temperatureBands.warningHigh - config.temperatureBands.warningLow) / 2;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+  config = defaults;
+  config.humidityBands.dangerLow = config.humidityBands.warningLow + 1;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+  config = defaults;
+  config.sensorReadIntervalSec = SENSOR_READ_INTERVAL_SEC - 1;
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+  config = defaults;
+  config.degreesUnit = (DegreesUnit)(FARENHEIT + 1);
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+  config = defaults;
+  config.wifiSsid[0] = '\0';
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, parse(serialize(config), &parsed));
+}
+
+static void test_parse_line(void) {
+  uint8_t blob[CONFIG_MAX_BYTES];
+  size_t len = 0;
+  ConfigStatus status = ConfigStatus::OK;
+  TEST_ASSERT_EQUAL(ConfigCommand::QUERY, configParseLine("#CFG?", blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigCommand::DUMP, configParseLine("#DUMP?", blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigCommand::NONE, configParseLine("hello", blob, sizeof(blob), &len, &status));
+
+  const std::vector<uint8_t> expected = serialize(defaults);
+  std::string line = "#CFG:";
+  char byte[3];
+  for (uint8_t b : expected) {
+    snprintf(byte, sizeof(byte), b & 1 ? "%02X" : "%02x", b);
+    line += byte;
+  }
+  TEST_ASSERT_EQUAL(ConfigCommand::STORE, configParseLine(line.c_str(), blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigStatus::OK, status);
+  TEST_ASSERT_EQUAL(expected.size(), len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected.data(), blob, len);
+}
+
+static void test_malformed_hex_line(void) {
+  uint8_t blob[16];
+  size_t len = 0;
+  ConfigStatus status = ConfigStatus::OK;
+  TEST_ASSERT_EQUAL(ConfigCommand::STORE, configParseLine("#CFG:43464", blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, status);
+  TEST_ASSERT_EQUAL(ConfigCommand::STORE, configParseLine("#CFG:4346zz", blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, status);
+  const std::string tooLong = "#CFG:" + std::string(2 * sizeof(blob) + 2, '0');
+  TEST_ASSERT_EQUAL(ConfigCommand::STORE, configParseLine(tooLong.c_str(), blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigStatus::BAD_VALUE, status);
+  // well formed but empty, left to configParse
+  TEST_ASSERT_EQUAL(ConfigCommand::STORE, configParseLine("#CFG:", blob, sizeof(blob), &len, &status));
+  TEST_ASSERT_EQUAL(ConfigStatus::OK, status);
+  TEST_ASSERT_EQUAL(0, len);
+  TEST_ASSERT_EQUAL(ConfigStatus::TOO_SHORT, configParse(blob, len, &defaults));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_defaults_round_trip);
+  RUN_TEST(test_bad_header_and_crc);
+  RUN_TEST(test_out_untouched_on_error);
+  RUN_TEST(test_truncated);
+  RUN_TEST(test_newer_revision_fields_ignored);
+  RUN_TEST(test_string_lengths);
+  RUN_TEST(test_invalid_values);
+  RUN_TEST(test_parse_line);
+  RUN_TEST(test_malformed_hex_line);
+  return UNITY_END();
+}
@@ -0,0 +1,132 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "fake_humidity_sensor.h"
+#include "sensor_registry.h"
+
+static FakeHumiditySensor sensors[SENSOR_REGISTRY_MAX];
+static SensorRegistry* registry;
+static SensorReading readings[SENSOR_REGISTRY_MAX];
+
+void setUp(void) {
+  hostMicros = 1000;
+  registry = new SensorRegistry();
+  for (uint8_t i = 0; i < SENSOR_REGISTRY_MAX; ++i) {
+    sensors[i] = FakeHumiditySensor(20.0f + i, 50.0f + i);
+    registry->add(&sensors[i]);
+  }
+  memset(readings, 0, sizeof(readings));
+}
+
+void tearDown(void) {
+  delete registry;
+}
+
+static void test_add_until_full(void) {
+  FakeHumiditySensor extra;
+  TEST_ASSERT_EQUAL(SENSOR_REGISTRY_MAX, registry->count());
+  TEST_ASSERT_FALSE(registry->add(&extra));
+  TEST_ASSERT_EQUAL(SENSOR_REGISTRY_MAX, registry->count());
+}
+
+static void test_only_responding_sensors_started(void) {
+  sensors[1].responding = false;
+  TEST_ASSERT_EQUAL_HEX8(0b1101, registry->begin());
+  TEST_ASSERT_EQUAL_HEX8(0b1101, registry->up());
+  sensors[3].starts = false;
+  TEST_ASSERT_EQUAL_HEX8(0b0101, registry->startAll());
+  // a sensor that is not up is not even asked
+  TEST_ASSERT_EQUAL(0, sensors[1].startCalls);
+  TEST_ASSERT_EQUAL(1, sensors[3].startCalls);
+}
+
+static void test_collect_all_in_one_conversion_time(void) {
+  registry->begin();
+  TEST_ASSERT_EQUAL_HEX8(0b1111, registry->startAll());
+  sensors[2].readyAfterUs = 8000;
+  TEST_ASSERT_EQUAL_HEX8(0b1111, registry->collectAll(readings));
+  for (uint8_t i = 0; i < SENSOR_REGISTRY_MAX; ++i) {
+    TEST_ASSERT_EQUAL_FLOAT(20.0f + i, readings[i].temperature);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f + i, readings[i].humidity);
+  }
+  // in parallel: the slowest sensor plus one poll interval, not the sum of all of them
+  TEST_ASSERT_LESS_OR_EQUAL(1000 + 8000 + SENSOR_POLL_INTERVAL_US, hostMicros);
+}
+
+static void test_timeout_mask(void) {
+  registry->begin();
+  sensors[0].reads = false;             // never answers
+  sensors[1].readyAfterUs = 30000;      // well past twice its conversion time
+  sensors[2].readyAfterUs = 20000;      // just in time
+  registry->startAll();
+  TEST_ASSERT_EQUAL_HEX8(0b1100, registry->collectAll(readings));
+  TEST_ASSERT_EQUAL_FLOAT(22.0f, readings[2].temperature);
+  // gave up once the slowest sensor ran past twice its conversion time
+  TEST_ASSERT_GREATER_THAN(1000 + 2 * 10000, hostMicros);
+  TEST_ASSERT_LESS_OR_EQUAL(1000 + 2 * 10000 + 2 * SENSOR_POLL_INTERVAL_US, hostMicros);
+}
+
+static void test_collect_without_start(void) {
+  registry->begin();
+  TEST_ASSERT_EQUAL_HEX8(0, registry->collectAll(readings));
+  TEST_ASSERT_EQUAL(0, sensors[0].readCalls);
+  // a collect ends the round, the next one needs a new start
+  registry->startAll();
+  TEST_ASSERT_EQUAL_HEX8(0b1111, registry->collectAll(readings));
+  TEST_ASSERT_EQUAL_HEX8(0, registry->collectAll(readings));
+}
+
+static void test_failed_start_not_polled(void) {
+  registry->begin();
+  sensors[2].starts = false;
+  TEST_ASSERT_EQUAL_HEX8(0b1011, registry->startAll());
+  TEST_ASSERT_EQUAL_HEX8(0b1011, registry->collectAll(readings));
+  TEST_ASSERT_EQUAL(0, sensors[2].readCalls);
+}
+
+static void test_fuse_odd_count_is_median(void) {
+  const SensorReading r[] = { { 21.0f, 50.0f }, { 35.0f, 10.0f }, { 21.4f, 52.0f } };
+  float t = 0, h = 0;
+  TEST_ASSERT_TRUE(SensorRegistry::fuse(r, 0b111, &t, &h));
+  // the outlier does not move the result
+  TEST_ASSERT_EQUAL_FLOAT(21.4f, t);
+  TEST_ASSERT_EQUAL_FLOAT(50.0f, h);
+  TEST_ASSERT_TRUE(SensorRegistry::fuse(r, 0b001, &t, &h));
+  TEST_ASSERT_EQUAL_FLOAT(21.0f, t);
+  TEST_ASSERT_EQUAL_FLOAT(50.0f, h);
+}
+
+static void test_fuse_even_count_is_mean_of_middle(void) {
+  const SensorReading r[] = { { 21.0f, 50.0f }, { 35.0f, 10.0f }, { 21.4f, 52.0f }, { 21.2f, 51.0f } };
+  float t = 0, h = 0;
+  TEST_ASSERT_TRUE(SensorRegistry::fuse(r, 0b1111, &t, &h));
+  TEST_ASSERT_FLOAT_WITHIN(1e-5, 21.3f, t);
+  TEST_ASSERT_FLOAT_WITHIN(1e-5, 50.5f, h);
+  // two sensors: nothing to outvote a bad one, it is the plain mean
+  TEST_ASSERT_TRUE(SensorRegistry::fuse(r, 0b0011, &t, &h));
+  TEST_ASSERT_EQUAL_FLOAT(28.0f, t);
+  TEST_ASSERT_EQUAL_FLOAT(30.0f, h);
+}
+
+static void test_fuse_uses_mask_only(void) {
+  const SensorReading r[] = { { 21.0f, 50.0f }, { NAN, NAN }, { 23.0f, 54.0f }, { -40.0f, 0.0f } };
+  float t = -1, h = -1;
+  TEST_ASSERT_FALSE(SensorRegistry::fuse(r, 0, &t, &h));
+  TEST_ASSERT_EQUAL_FLOAT(-1, t);
+  TEST_ASSERT_TRUE(SensorRegistry::fuse(r, 0b0101, &t, &h));
+  TEST_ASSERT_EQUAL_FLOAT(22.0f, t);
+  TEST_ASSERT_EQUAL_FLOAT(52.0f, h);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_add_until_full);
+  RUN_TEST(test_only_responding_sensors_started);
+  RUN_TEST(test_collect_all_in_one_conversion_time);
+  RUN_TEST(test_timeout_mask);
+  RUN_TEST(test_collect_without_start);
+  RUN_TEST(test_failed_start_not_polled);
+  RUN_TEST(test_fuse_odd_count_is_median);
+  RUN_TEST(test_fuse_even_count_is_mean_of_middle);
+  RUN_TEST(test_fuse_uses_mask_only);
+  return UNITY_END();
+}
@@ -0,0 +1,137 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "fake_i2c_bus.h"
+#include "si7021.h"
+
+// RH code 0x7C80 -> 54.79 %, temperature code 0x6654 -> 23.39 C, with their CRCs
+static const std::vector<uint8_t> RH_REPLY = { 0x7C, 0x80, 0xF5 };
+static const std::vector<uint8_t> T_REPLY = { 0x66, 0x54 };
+
+static FakeI2CBus* bus;
+
+void setUp(void) {
+  bus = new FakeI2CBus();
+  hostMicros = 0;
+}
+
+void tearDown(void) {
+  delete bus;
+}
+
+static void test_crc8(void) {
+  const uint8_t rh[] = { 0x7C, 0x80 };
+  const uint8_t t[] = { 0x66, 0x54 };
+  const uint8_t beef[] = { 0xBE, 0xEF };
+  TEST_ASSERT_EQUAL_HEX8(0xF5, Si7021::crc8(rh, 2));
+  TEST_ASSERT_EQUAL_HEX8(0xB5, Si7021::crc8(t, 2));
+  TEST_ASSERT_EQUAL_HEX8(0x13, Si7021::crc8(beef, 2));
+  TEST_ASSERT_EQUAL_HEX8(0x00, Si7021::crc8(rh, 0));
+}
+
+static void test_start_conversion_uses_no_hold_mode(void) {
+  Si7021 sensor(*bus);
+  TEST_ASSERT_TRUE(sensor.startConversion());
+  TEST_ASSERT_EQUAL(1, bus->writes.size());
+  TEST_ASSERT_EQUAL_HEX8(SI7021_ADDRESS, bus->writes[0].address);
+  TEST_ASSERT_EQUAL(1, bus->writes[0].data.size());
+  TEST_ASSERT_EQUAL_HEX8(0xF5, bus->writes[0].data[0]);
+}
+
+static void test_polls_through_nacks(void) {
+  Si7021 sensor(*bus);
+  bus->nack(SI7021_ADDRESS, 3);
+  bus->reply(SI7021_ADDRESS, RH_REPLY);
+  bus->reply(SI7021_ADDRESS, T_REPLY);
+  float t = 0, h = 0;
+  TEST_ASSERT_TRUE(sensor.measure(&t, &h));
+  TEST_ASSERT_EQUAL(5, bus->reads);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 54.79, h);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 23.39, t);
+  // one poll interval per NACK, far from the timeout
+  TEST_ASSERT_LESS_THAN(sensor.conversionTimeUs(), hostMicros);
+}
+
+static void test_read_fails_while_converting(void) {
+  Si7021 sensor(*bus);
+  bus->nack(SI7021_ADDRESS);
+  float t = 0, h = 0;
+  TEST_ASSERT_FALSE(sensor.readConversion(&t, &h));
+  // no temperature readback attempted for a NACKed RH read
+  TEST_ASSERT_EQUAL(0, bus->writes.size());
+}
+
+static void test_await_times_out(void) {
+  Si7021 sensor(*bus);
+  float t = 0, h = 0;
+  TEST_ASSERT_TRUE(sensor.startConversion());
+  TEST_ASSERT_FALSE(sensor.awaitConversion(&t, &h));
+  TEST_ASSERT_GREATER_THAN(2 * sensor.conversionTimeUs(), hostMicros);
+  TEST_ASSERT_LESS_THAN(2 * sensor.conversionTimeUs() + 1000, hostMicros);
+}
+
+static void test_crc_mismatch_rejected(void) {
+  Si7021 sensor(*bus);
+  bus->reply(SI7021_ADDRESS, { 0x7C, 0x80, 0xF4 });
+  bus->reply(SI7021_ADDRESS, T_REPLY);
+  float t = -1, h = -1;
+  TEST_ASSERT_FALSE(sensor.readConversion(&t, &h));
+  TEST_ASSERT_EQUAL_FLOAT(-1, t);
+  TEST_ASSERT_EQUAL_FLOAT(-1, h);
+  TEST_ASSERT_EQUAL(1, bus->pendingReplies(SI7021_ADDRESS));
+}
+
+static void test_temperature_read_back_from_rh_conversion(void) {
+  Si7021 sensor(*bus);
+  bus->reply(SI7021_ADDRESS, RH_REPLY);
+  bus->reply(SI7021_ADDRESS, T_REPLY);
+  float t = 0, h = 0;
+  TEST_ASSERT_TRUE(sensor.readConversion(&t, &h));
+  // no second conversion, just "read temperature value from previous RH measurement"
+  TEST_ASSERT_EQUAL(1, bus->writes.size());
+  TEST_ASSERT_EQUAL_HEX8(0xE0, bus->writes[0].data[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 23.39, t);
+}
+
+static void test_begin_sets_resolution_bits(void) {
+  Si7021 sensor(*bus);
+  // reset value 0x3A, heater bit set on top
+  bus->reply(SI7021_ADDRESS, { 0x3E });
+  TEST_ASSERT_TRUE(sensor.begin(Si7021Resolution::RH11_T11));
+  TEST_ASSERT_EQUAL(2, bus->writes.size());
+  TEST_ASSERT_EQUAL_HEX8(0xE7, bus->writes[0].data[0]);
+  // D7 and D0 set, heater off, reserved bits kept
+  const uint8_t expected[] = { 0xE6, 0xBB };
+  TEST_ASSERT_EQUAL(2, bus->writes[1].data.size());
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, bus->writes[1].data.data(), 2);
+  TEST_ASSERT_EQUAL(7000 + 2400, sensor.conversionTimeUs());
+}
+
+static void test_begin_skips_write_when_unchanged(void) {
+  Si7021 sensor(*bus);
+  bus->reply(SI7021_ADDRESS, { 0x3A | 0x80 });
+  TEST_ASSERT_TRUE(sensor.begin(Si7021Resolution::RH10_T13));
+  TEST_ASSERT_EQUAL(1, bus->writes.size());
+  TEST_ASSERT_EQUAL(4500 + 6200, sensor.conversionTimeUs());
+}
+
+static void test_begin_fails_without_sensor(void) {
+  Si7021 sensor(*bus);
+  TEST_ASSERT_FALSE(sensor.begin(Si7021Resolution::RH12_T14));
+  bus->nackWrites = true;
+  TEST_ASSERT_FALSE(sensor.begin(Si7021Resolution::RH12_T14));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc8);
+  RUN_TEST(test_start_conversion_uses_no_hold_mode);
+  RUN_TEST(test_polls_through_nacks);
+  RUN_TEST(test_read_fails_while_converting);
+  RUN_TEST(test_await_times_out);
+  RUN_TEST(test_crc_mismatch_rejected);
+  RUN_TEST(test_temperature_read_back_from_rh_conversion);
+  RUN_TEST(test_begin_sets_resolution_bits);
+  RUN_TEST(test_begin_skips_write_when_unchanged);
+  RUN_TEST(test_begin_fails_without_sensor);
+  return UNITY_END();
+}
@@ -0,0 +1,63 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "sleep_governor.h"
+
+static const uint64_t INTERVAL_US = (uint64_t) WAKEUP_INTERVAL_MS * MICROSECONDS_PER_MILLISECOND;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void test_break_even_from_default_cold_wake(void) {
+  SleepGovernor governor(true);
+  const uint64_t expected = (uint64_t) (SLEEP_COLD_WAKE_DEFAULT_US * (CURRENT_AWAKE_MA * 1000.0f) / (CURRENT_LIGHT_SLEEP_UA - CURRENT_SLEEP_UA));
+  TEST_ASSERT_UINT64_WITHIN(1, expected, governor.breakEvenUs());
+  TEST_ASSERT_EQUAL(SLEEP_LIGHT_ENABLED, governor.preferLightSleep(governor.breakEvenUs() - 1));
+  TEST_ASSERT_FALSE(governor.preferLightSleep(governor.breakEvenUs()));
+}
+
+static void test_gap_until_work(void) {
+  TEST_ASSERT_EQUAL_UINT64(3 * MICROSECONDS_PER_SECOND, SleepGovernor::gapUs(3, false, INTERVAL_US));
+  TEST_ASSERT_EQUAL_UINT64(600ull * MICROSECONDS_PER_SECOND, SleepGovernor::gapUs(600, false, INTERVAL_US));
+}
+
+static void test_pending_work_waits_an_interval(void) {
+  TEST_ASSERT_EQUAL_UINT64(INTERVAL_US, SleepGovernor::gapUs(3, true, INTERVAL_US));
+  TEST_ASSERT_EQUAL_UINT64(INTERVAL_US, SleepGovernor::gapUs(600, true, INTERVAL_US));
+}
+
+// Work still due after the wakeup ran is work that failed, retried an interval later.
+static void test_overdue_work_waits_an_interval(void) {
+  TEST_ASSERT_EQUAL_UINT64(INTERVAL_US, SleepGovernor::gapUs(0, false, INTERVAL_US));
+  TEST_ASSERT_EQUAL_UINT64(INTERVAL_US, SleepGovernor::gapUs(-30, false, INTERVAL_US));
+}
+
+// A sensor that stopped answering: every wakeup leaves the reading due. The retries must come
+// no faster than the regular wakeups, not on the light sleep floor.
+static void test_failing_sensor_retries_at_wakeup_interval(void) {
+  const int64_t readingDueAtSec = 40;
+  uint64_t nowUs = 0;
+  uint32_t wakeups = 0;
+  while (nowUs < 600ull * MICROSECONDS_PER_SECOND) {
+    ++wakeups;
+    const int64_t nowSec = nowUs / MICROSECONDS_PER_SECOND;
+    const uint64_t gapUs = SleepGovernor::gapUs(readingDueAtSec - nowSec, false, INTERVAL_US);
+    TEST_ASSERT_GREATER_OR_EQUAL(MICROSECONDS_PER_SECOND, gapUs);
+    if (nowSec >= readingDueAtSec) {
+      TEST_ASSERT_EQUAL_UINT64(INTERVAL_US, gapUs);
+    }
+    nowUs += gapUs;
+  }
+  // one wakeup to reach the due time, then one per interval
+  TEST_ASSERT_LESS_OR_EQUAL(2 + 600 * 1000 / WAKEUP_INTERVAL_MS, wakeups);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_break_even_from_default_cold_wake);
+  RUN_TEST(test_gap_until_work);
+  RUN_TEST(test_pending_work_waits_an_interval);
+  RUN_TEST(test_overdue_work_waits_an_interval);
+  RUN_TEST(test_failing_sensor_retries_at_wakeup_interval);
+  return UNITY_END();
+}
@@ -0,0 +1,260 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "stats_collector.h"
+
+RuntimeConfig config;
+
+typedef StatsCollector<uint16_t> Collector;
+
+static const time_t START = 1700000000;
+
+void setUp(void) {
+  configDefaults(&config);
+  hostWakeupCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+void tearDown(void) {}
+
+static std::vector<uint8_t> dumpOf(Collector& collector) {
+  std::vector<uint8_t> blob(16384);
+  BlobWriter w(blob.data(), blob.size());
+  collector.dump(w);
+  TEST_ASSERT_FALSE(w.overflow());
+  blob.resize(w.size());
+  return blob;
+}
+
+// The dump starts with the signedness byte and the time of the last reading.
+#define DUMP_CLOCK_AT 1
+#define DUMP_CLOCK_END 5
+// and ends with the exposure statistics, six times four floats
+#define DUMP_EXPOSURE_BYTES (6 * 4 * 4)
+
+static void assertSameState(Collector& expected, Collector& actual, bool sameClock = true) {
+  std::vector<uint8_t> a = dumpOf(expected);
+  std::vector<uint8_t> b = dumpOf(actual);
+  TEST_ASSERT_EQUAL(a.size(), b.size());
+  if (!sameClock) {
+    memset(a.data() + DUMP_CLOCK_AT, 0, DUMP_CLOCK_END - DUMP_CLOCK_AT);
+    memset(b.data() + DUMP_CLOCK_AT, 0, DUMP_CLOCK_END - DUMP_CLOCK_AT);
+  }
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(a.data(), b.data(), a.size());
+}
+
+// `days` of readings: the base interval with some jitter, stretches the adaptive sampler
+// widened, and now and then the device off for longer than HISTORY_GAP_SEC.
+static std::vector<TimedReading> trace(uint32_t days, uint32_t seed) {
+  std::vector<TimedReading> readings;
+  uint32_t rnd = seed;
+  auto next = [&rnd](uint32_t n) {
+    rnd = rnd * 1664525u + 1013904223u;
+    return (rnd >> 8) % n;
+  };
+  time_t at = START;
+  float t = 21.0f, h = 68.0f;
+  while (at < START + (time_t)days * 24 * 3600) {
+    const uint32_t kind = next(100000);
+    if (kind < 90000) {
+      at += SENSOR_READ_INTERVAL_SEC + next(3) - 1;
+    } else if (kind < 99995) {
+      at += SENSOR_READ_INTERVAL_SEC << next(6);
+    } else {
+      at += HISTORY_GAP_SEC + next(3 * 24 * 3600);
+    }
+    t += (next(41) - 20) / 200.0f;
+    h += (next(41) - 20) / 100.0f;
+    readings.push_back(TimedReading { at, t, h });
+  }
+  return readings;
+}
+
+static void test_batch_matches_sequential(void) {
+  const std::vector<TimedReading> readings = trace(60, 1);
+  Collector* sequential = new Collector(true);
+  Collector* batched = new Collector(true);
+  UpdateFlags sequentialFlags = UpdateFlags::NONE;
+  for (const TimedReading& r : readings) sequentialFlags |= sequential->collect(r.temperature, r.humidity, r.at);
+  const UpdateFlags batchFlags = batched->collectBatch(readings.data(), readings.size());
+  TEST_ASSERT_EQUAL(static_cast<uint16_t>(sequentialFlags), static_cast<uint16_t>(batchFlags));
+  assertSameState(*sequential, *batched);
+  delete sequential;
+  delete batched;
+}
+
+// Chunk boundaries fall anywhere, e.g. between the readings of an hour push, and each chunk
+// ends in the state the sequential calls are in at that point.
+static void test_chunked_batches_match_sequential(void) {
+  const std::vector<TimedReading> readings = trace(30, 2);
+  Collector* sequential = new Collector(true);
+  Collector* chunked = new Collector(true);
+  uint32_t rnd = 7;
+  size_t done = 0;
+  while (done < readings.size()) {
+    rnd = rnd * 1664525u + 1013904223u;
+    const size_t n = std::min<size_t>(1 + (rnd >> 8) % 2000, readings.size() - done);
+    UpdateFlags sequentialFlags = UpdateFlags::NONE;
+    for (size_t i = done; i < done + n; ++i) {
+      sequentialFlags |= sequential->collect(readings[i].temperature, readings[i].humidity, readings[i].at);
+    }
+    const UpdateFlags chunkFlags = chunked->collectBatch(readings.data() + done, n);
+    TEST_ASSERT_EQUAL(static_cast<uint16_t>(sequentialFlags), static_cast<uint16_t>(chunkFlags));
+    assertSameState(*sequential, *chunked);
+    done += n;
+  }
+  delete sequential;
+  delete chunked;
+}
+
+static void test_empty_batch(void) {
+  Collector* collector = new Collector(true);
+  TEST_ASSERT_EQUAL(static_cast<uint16_t>(UpdateFlags::NONE), static_cast<uint16_t>(collector->collectBatch(nullptr, 0)));
+  delete collector;
+}
+
+// Two hours of readings on the base interval, the clock of `stepped` moves by `stepSec`
+// after `before` of them.
+static void collectAcrossStep(Collector& reference, Collector& stepped, time_t stepSec, bool announced, uint32_t before = 100) {
+  for (uint32_t i = 0; i < 180; ++i) {
+    const time_t at = START + i * SENSOR_READ_INTERVAL_SEC;
+    const float t = 21.0f + (i % 7) * 0.1f, h = 68.0f - (i % 5) * 0.2f;
+    if (i == before && announced) stepped.clockStepped(stepSec);
+    reference.collect(t, h, at);
+    stepped.collect(t, h, i >= before ? at + stepSec : at);
+  }
+}
+
+static void test_clock_step_forward_is_not_a_gap(void) {
+  Collector* reference = new Collector(true);
+  Collector* stepped = new Collector(true);
+  collectAcrossStep(*reference, *stepped, 10 * 3600, true);
+  assertSameState(*reference, *stepped, false);
+  for (uint16_t i = 0; i < PX_PER_1H; ++i) TEST_ASSERT_FALSE(std::isnan(stepped->historyViewT()[i]));
+  delete reference;
+  delete stepped;
+
+  // unannounced, the same jump is a device that was off
+  reference = new Collector(true);
+  stepped = new Collector(true);
+  collectAcrossStep(*reference, *stepped, 10 * 3600, false);
+  TEST_ASSERT_TRUE(std::isnan(stepped->historyViewT()[PX_PER_1H - 1]));
+  delete reference;
+  delete stepped;
+}
+
+static void test_clock_step_back(void) {
+  for (bool announced : { true, false }) {
+    Collector* reference = new Collector(true);
+    Collector* stepped = new Collector(true);
+    // announced, the reading after the step stands for the time that really passed; otherwise
+    // for one base interval, which is what the reference saw as well
+    collectAcrossStep(*reference, *stepped, -3600, announced);
+    assertSameState(*reference, *stepped, false);
+    const ExposureStatistics<float> exposure = stepped->exposureTemp1D();
+    TEST_ASSERT_FALSE(std::isnan(exposure.mean));
+    TEST_ASSERT_FLOAT_WITHIN(0.4, 21.3, exposure.mean);
+    delete reference;
+    delete stepped;
+  }
+}
+
+// Readings with the same or an earlier timestamp (no sync announced the step) count as one
+// base interval each instead of a negative or wrapped one.
+static void test_backwards_readings_weighted_one_interval(void) {
+  Collector* reference = new Collector(true);
+  Collector* repeated = new Collector(true);
+  for (uint32_t i = 0; i < 120; ++i) {
+    reference->collect(21.0f, 68.0f, START + i * SENSOR_READ_INTERVAL_SEC);
+    repeated->collect(21.0f, 68.0f, i < 60 ? START + i * SENSOR_READ_INTERVAL_SEC : START + (i - 60) * SENSOR_READ_INTERVAL_SEC);
+  }
+  // the second half is an hour earlier on the clock, every reading still moved the tiers on
+  assertSameState(*reference, *repeated, false);
+  for (uint32_t i = 0; i < 3; ++i) repeated->collect(21.0f, 68.0f, START);
+  for (uint32_t i = 0; i < 3; ++i) reference->collect(21.0f, 68.0f, START + (120 + i) * SENSOR_READ_INTERVAL_SEC);
+  assertSameState(*reference, *repeated, false);
+  delete reference;
+  delete repeated;
+}
+
+// A trace tools/test_tier_cascade.py replays through the host port of the cascade
+// (tools/tier_cascade.py): before each segment the clock steps by clockStepSec (announced with
+// clockStepped() or not), then come `readings` readings intervalSec apart. It runs the tiers
+// up to the year one and through gaps, clock steps both ways and repeated timestamps.
+struct ParitySegment {
+  uint16_t readings;
+  int32_t intervalSec;
+  int32_t clockStepSec;
+  bool announced;
+};
+
+static const ParitySegment PARITY_TRACE[] = {
+  { 10, 40, 3600, true },
+  { 200, 40, 0, false },
+  { 100, 43, 0, false },
+  { 3000, 600, 0, false },
+  { 50, 40, 36000, true },
+  { 50, 40, -3600, true },
+  { 20, 0, 0, false },
+  { 20, 40, -7200, false },
+  { 10, 40, 172800, false },
+  { 3000, 640, 0, false },
+  { 5, 40, 3456000, false },
+  { 500, 320, 0, false },
+};
+
+// CRC32 of the dump of the collector after the trace, up to the exposure statistics the host
+// port does not model.
+static const uint32_t PARITY_DUMP_CRC = 0xa886cb55;
+
+static void test_parity_trace(void) {
+  Collector* collector = new Collector(true);
+  time_t at = START;
+  uint32_t i = 0;
+  for (const ParitySegment& segment : PARITY_TRACE) {
+    at += segment.clockStepSec;
+    if (segment.announced) collector->clockStepped(segment.clockStepSec);
+    for (uint16_t n = 0; n < segment.readings; ++n, ++i) {
+      at += segment.intervalSec;
+      // quarter steps, exact in a float and in the host's doubles
+      collector->collect(18.0f + (i * 7 % 40) * 0.25f, 55.0f + (i * 11 % 48) * 0.25f, at);
+    }
+  }
+  const std::vector<uint8_t> blob = dumpOf(*collector);
+  TEST_ASSERT_EQUAL_HEX32(PARITY_DUMP_CRC, blobCrc32(blob.data(), blob.size() - DUMP_EXPOSURE_BYTES));
+  delete collector;
+}
+
+static void test_benchmark_batch_against_sequential(void) {
+  const std::vector<TimedReading> readings = trace(365, 3);
+  Collector* sequential = new Collector(true);
+  Collector* batched = new Collector(true);
+  auto started = std::chrono::steady_clock::now();
+  for (const TimedReading& r : readings) sequential->collect(r.temperature, r.humidity, r.at);
+  const double sequentialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+  started = std::chrono::steady_clock::now();
+  batched->collectBatch(readings.data(), readings.size());
+  const double batchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+  assertSameState(*sequential, *batched);
+
+  char report[160];
+  snprintf(report, sizeof(report), "%zu readings: collect() %.0f ms, collectBatch() %.0f ms",
+    readings.size(), sequentialMs, batchMs);
+  TEST_MESSAGE(report);
+  delete sequential;
+  delete batched;
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_batch_matches_sequential);
+  RUN_TEST(test_chunked_batches_match_sequential);
+  RUN_TEST(test_empty_batch);
+  RUN_TEST(test_clock_step_forward_is_not_a_gap);
+  RUN_TEST(test_clock_step_back);
+  RUN_TEST(test_backwards_readings_weighted_one_interval);
+  RUN_TEST(test_parity_trace);
+  RUN_TEST(test_benchmark_batch_against_sequential);
+  return UNITY_END();
+}
@@ -0,0 +1,135 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "telemetry.h"
+
+// Readings as append() takes them, temperature and humidity x100. The timestamp deltas walk
+// every delta-of-delta width, the values repeat, step and go negative.
+// tools/test_telemetry_collector.py decodes EXPECTED_BATCH back into this trace.
+struct TraceSample {
+  uint32_t timestamp;
+  int16_t temperature;
+  uint16_t humidity;
+};
+
+static const TraceSample TRACE[] = {
+  { 1700000000, 2150, 4520 },
+  { 1700000040, 2150, 4520 },
+  { 1700000080, 2151, 4518 },
+  { 1700000120, 2149, 4518 },
+  { 1700000200, 2149, 4600 },
+  { 1700000400, -512, 4600 },
+  { 1700001400, -498, 9999 },
+  { 1700001440, 0, 0 },
+  { 1700101440, 2150, 4520 },
+  { 1700101480, 2150, 4520 },
+};
+static const uint16_t TRACE_SIZE = sizeof(TRACE) / sizeof(TRACE[0]);
+
+static const uint8_t EXPECTED_BATCH[] = {
+  0x01, 0x0a, 0x00, 0x65, 0x53, 0xf1, 0x00, 0x08, 0x66, 0x11, 0xa8, 0x94,
+  0x0f, 0x87, 0x85, 0xde, 0x0a, 0x50, 0xca, 0xdf, 0x8f, 0x10, 0xff, 0x66,
+  0x57, 0x19, 0x07, 0x0b, 0xcb, 0x76, 0xf7, 0xec, 0x40, 0x87, 0x7f, 0x07,
+  0x96, 0xce, 0x1f, 0xe0, 0x00, 0x30, 0xcf, 0x14, 0xa8, 0x67, 0x39, 0x8d,
+  0x7f, 0xff, 0xf9, 0xe6, 0x20,
+};
+
+static TelemetryQueue* queue;
+
+static void appendTrace() {
+  for (const TraceSample& s : TRACE) {
+    TEST_ASSERT_TRUE(queue->append(s.timestamp, s.temperature, s.humidity));
+  }
+}
+
+void setUp(void) {
+  queue = new TelemetryQueue(true);
+}
+
+void tearDown(void) {
+  delete queue;
+}
+
+static void test_encodes_trace(void) {
+  appendTrace();
+  TEST_ASSERT_EQUAL(TRACE_SIZE, queue->count());
+  TEST_ASSERT_EQUAL(sizeof(EXPECTED_BATCH), queue->batchSize());
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(EXPECTED_BATCH, queue->batch(), sizeof(EXPECTED_BATCH));
+}
+
+static void test_header(void) {
+  appendTrace();
+  const uint8_t* batch = queue->batch();
+  TEST_ASSERT_EQUAL(TELEMETRY_FORMAT_VERSION, batch[0]);
+  TEST_ASSERT_EQUAL(TRACE_SIZE, batch[1] | batch[2] << 8);
+}
+
+// Appends stop once a worst case sample would not fit, nothing is written past the buffer.
+static void test_fills_up_and_drops(void) {
+  uint32_t appended = 0;
+  while (queue->append(1700000000 + appended * 40, appended * 37 % 4000 - 2000, appended * 53 % 10000)) {
+    ++appended;
+  }
+  TEST_ASSERT_TRUE(queue->isFull());
+  TEST_ASSERT_LESS_OR_EQUAL(3 + TELEMETRY_BUFFER_BYTES, queue->batchSize());
+  TEST_ASSERT_EQUAL(appended, queue->count());
+  // the append that ended the loop was dropped too
+  TEST_ASSERT_FALSE(queue->append(1800000000, 0, 0));
+  TEST_ASSERT_EQUAL(2, queue->dropped());
+}
+
+static void test_upload_due_after_interval(void) {
+  const uint32_t t0 = TRACE[0].timestamp;
+  TEST_ASSERT_FALSE(queue->uploadDue(t0));
+  queue->append(t0, 2150, 4520);
+  TEST_ASSERT_FALSE(queue->uploadDue(t0 + TELEMETRY_UPLOAD_INTERVAL_SEC - 1));
+  TEST_ASSERT_TRUE(queue->uploadDue(t0 + TELEMETRY_UPLOAD_INTERVAL_SEC));
+  // a failed attempt waits the retry interval
+  queue->attempted(t0 + TELEMETRY_UPLOAD_INTERVAL_SEC);
+  TEST_ASSERT_FALSE(queue->uploadDue(t0 + TELEMETRY_UPLOAD_INTERVAL_SEC + TELEMETRY_RETRY_INTERVAL_SEC - 1));
+  TEST_ASSERT_TRUE(queue->uploadDue(t0 + TELEMETRY_UPLOAD_INTERVAL_SEC + TELEMETRY_RETRY_INTERVAL_SEC));
+}
+
+// A clock that was not read (year 2000) or was set back must not wrap into a due upload.
+static void test_upload_not_due_with_clock_behind(void) {
+  const uint32_t t0 = TRACE[0].timestamp;
+  queue->append(t0, 2150, 4520);
+  TEST_ASSERT_FALSE(queue->uploadDue(946684800));
+  queue->attempted(t0 + TELEMETRY_UPLOAD_INTERVAL_SEC);
+  TEST_ASSERT_FALSE(queue->uploadDue(t0 + 10));
+}
+
+static void test_session_kept_across_batches(void) {
+  appendTrace();
+  const uint32_t session = queue->session();
+  TEST_ASSERT_NOT_EQUAL(0, session);
+  TEST_ASSERT_EQUAL(0, queue->sequence());
+  queue->ack();
+  TEST_ASSERT_EQUAL(1, queue->sequence());
+  TEST_ASSERT_EQUAL(0, queue->count());
+  TEST_ASSERT_EQUAL(3, queue->batchSize());
+  TEST_ASSERT_EQUAL(session, queue->session());
+  // a cold boot draws a new one, and starts the sequence over
+  TelemetryQueue rebooted(true);
+  TEST_ASSERT_NOT_EQUAL(session, rebooted.session());
+  TEST_ASSERT_EQUAL(0, rebooted.sequence());
+}
+
+// The batch after an ack starts from scratch, not as a continuation of the previous one.
+static void test_encodes_again_after_ack(void) {
+  appendTrace();
+  queue->ack();
+  appendTrace();
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(EXPECTED_BATCH, queue->batch(), sizeof(EXPECTED_BATCH));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_encodes_trace);
+  RUN_TEST(test_header);
+  RUN_TEST(test_fills_up_and_drops);
+  RUN_TEST(test_upload_due_after_interval);
+  RUN_TEST(test_upload_not_due_with_clock_behind);
+  RUN_TEST(test_session_kept_across_batches);
+  RUN_TEST(test_encodes_again_after_ack);
+  return UNITY_END();
+}
@@ -0,0 +1,135 @@
+#include <unity.h>
+#include "fake_time_sync_network.h"
+#include "settings.h"
+#include "time_sync.h"
+
+typedef TimeSync::State State;
+
+static FakeTimeSyncNetwork* net;
+static WifiCache cache;
+
+void setUp(void) {
+  net = new FakeTimeSyncNetwork();
+  cache = WifiCache {};
+}
+
+void tearDown(void) {
+  delete net;
+}
+
+// Steps every 10 ms from `fromMs` until the machine leaves `state` or `untilMs` passes.
+static uint32_t stepWhile(TimeSync& sync, State state, uint32_t fromMs, uint32_t untilMs) {
+  uint32_t now = fromMs;
+  while (now <= untilMs && sync.step(now) == state) now += 10;
+  return now;
+}
+
+static void test_fast_connect(void) {
+  cache.valid = true;
+  TimeSync sync(*net, cache);
+  sync.start(0);
+  TEST_ASSERT_EQUAL(State::FAST_CONNECTING, sync.state());
+  TEST_ASSERT_EQUAL(State::FAST_CONNECTING, sync.step(100));
+  net->link = true;
+  TEST_ASSERT_EQUAL(State::SNTP_WAIT, sync.step(200));
+  net->synced = true;
+  TEST_ASSERT_EQUAL(State::DONE, sync.step(300));
+  TEST_ASSERT_TRUE(sync.usedFastPath());
+  TEST_ASSERT_TRUE(cache.valid);
+  TEST_ASSERT_EQUAL_STRING("fast sntp shutdown ", net->calls.c_str());
+}
+
+static void test_no_cache_starts_full(void) {
+  TimeSync sync(*net, cache);
+  sync.start(0);
+  TEST_ASSERT_EQUAL(State::FULL_CONNECTING, sync.state());
+  net->link = true;
+  TEST_ASSERT_EQUAL(State::SNTP_WAIT, sync.step(500));
+  TEST_ASSERT_TRUE(cache.valid);
+  TEST_ASSERT_FALSE(sync.usedFastPath());
+  TEST_ASSERT_EQUAL_STRING("full remember sntp ", net->calls.c_str());
+}
+
+static void test_fast_timeout_falls_back_to_full(void) {
+  cache.valid = true;
+  TimeSync sync(*net, cache);
+  sync.start(0);
+  const uint32_t fellBackAt = stepWhile(sync, State::FAST_CONNECTING, 0, 10000);
+  TEST_ASSERT_EQUAL(State::FULL_CONNECTING, sync.state());
+  TEST_ASSERT_EQUAL(WIFI_FAST_CONNECT_TIMEOUT_MS, fellBackAt);
+  TEST_ASSERT_FALSE(cache.valid);
+  TEST_ASSERT_FALSE(sync.usedFastPath());
+  net->link = true;
+  TEST_ASSERT_EQUAL(State::SNTP_WAIT, sync.step(fellBackAt + 500));
+  net->synced = true;
+  TEST_ASSERT_EQUAL(State::DONE, sync.step(fellBackAt + 600));
+  TEST_ASSERT_TRUE(cache.valid);
+  TEST_ASSERT_EQUAL_STRING("fast full remember sntp shutdown ", net->calls.c_str());
+}
+
+static void test_full_timeout_fails(void) {
+  TimeSync sync(*net, cache);
+  sync.start(1000);
+  const uint32_t failedAt = stepWhile(sync, State::FULL_CONNECTING, 1000, 60000);
+  TEST_ASSERT_EQUAL(State::FAILED, sync.state());
+  TEST_ASSERT_EQUAL(1000 + WIFI_CONNECT_ATTEMPTS * WIFI_CONNECT_ATTEMPT_INTERVAL_MS, failedAt);
+  TEST_ASSERT_TRUE(sync.finished());
+  TEST_ASSERT_EQUAL_STRING("full shutdown ", net->calls.c_str());
+}
+
+static void test_sntp_timeout_after_fast_connect_drops_cache(void) {
+  cache.valid = true;
+  TimeSync sync(*net, cache);
+  sync.start(0);
+  net->link = true;
+  TEST_ASSERT_EQUAL(State::SNTP_WAIT, sync.step(50));
+  const uint32_t failedAt = stepWhile(sync, State::SNTP_WAIT, 50, 60000);
+  TEST_ASSERT_EQUAL(State::FAILED, sync.state());
+  TEST_ASSERT_EQUAL(50 + NTP_SYNC_TIMEOUT_MS, failedAt);
+  // a stale static lease connects but gets nowhere
+  TEST_ASSERT_FALSE(cache.valid);
+  TEST_ASSERT_EQUAL_STRING("fast sntp shutdown ", net->calls.c_str());
+}
+
+static void test_sntp_timeout_after_full_connect_keeps_cache(void) {
+  TimeSync sync(*net, cache);
+  sync.start(0);
+  net->link = true;
+  TEST_ASSERT_EQUAL(State::SNTP_WAIT, sync.step(50));
+  stepWhile(sync, State::SNTP_WAIT, 50, 60000);
+  TEST_ASSERT_EQUAL(State::FAILED, sync.state());
+  TEST_ASSERT_TRUE(cache.valid);
+}
+
+static void test_without_sntp_stops_connected(void) {
+  cache.valid = true;
+  TimeSync sync(*net, cache);
+  sync.start(0, false);
+  net->link = true;
+  TEST_ASSERT_EQUAL(State::DONE, sync.step(100));
+  // the radio stays on for the caller
+  TEST_ASSERT_TRUE(net->link);
+  TEST_ASSERT_EQUAL_STRING("fast ", net->calls.c_str());
+}
+
+static void test_counter_wrap(void) {
+  cache.valid = true;
+  TimeSync sync(*net, cache);
+  const uint32_t start = 0xFFFFFF00;
+  sync.start(start);
+  TEST_ASSERT_EQUAL(State::FAST_CONNECTING, sync.step(start + 500));
+  TEST_ASSERT_EQUAL(State::FULL_CONNECTING, sync.step(start + WIFI_FAST_CONNECT_TIMEOUT_MS));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fast_connect);
+  RUN_TEST(test_no_cache_starts_full);
+  RUN_TEST(test_fast_timeout_falls_back_to_full);
+  RUN_TEST(test_full_timeout_fails);
+  RUN_TEST(test_sntp_timeout_after_fast_connect_drops_cache);
+  RUN_TEST(test_sntp_timeout_after_full_connect_keeps_cache);
+  RUN_TEST(test_without_sntp_stops_connected);
+  RUN_TEST(test_counter_wrap);
+  return UNITY_END();
+}
@@ -0,0 +1,146 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <deque>
+#include <random>
+#include "alerts.h"
+#include "trend_window.h"
+
+static const long S = 30;
+
+// Humidor humidity: good 65..72 %, danger outside 60..75 %.
+static const AlertBands BANDS = { 60, 65, 72, 75, 1 };
+static const float HORIZON_SEC = 3 * 3600;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// Least squares over the window from scratch, samples at x = 0..n-1 oldest first.
+static double referenceSlope(const std::deque<int32_t>& window) {
+  const double n = window.size();
+  if (n < 2) return 0;
+  double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+  for (size_t x = 0; x < window.size(); ++x) {
+    sumX += x;
+    sumY += window[x];
+    sumXY += x * (double)window[x];
+    sumXX += (double)x * x;
+  }
+  return (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+}
+
+// Pushes like StatsCollector does, mirroring a ring buffer of S entries.
+static void push(TrendWindow<S>& trend, std::deque<int32_t>& window, int32_t value) {
+  const bool full = window.size() == S;
+  const int32_t evicted = full ? window.front() : 0;
+  trend.push(value, full, evicted);
+  if (full) window.pop_front();
+  window.push_back(value);
+}
+
+static void test_slope_of_a_line(void) {
+  TrendWindow<S> trend;
+  trend.clear();
+  std::deque<int32_t> window;
+  TEST_ASSERT_EQUAL_FLOAT(0, trend.slope());
+  push(trend, window, 7);
+  TEST_ASSERT_EQUAL_FLOAT(0, trend.slope());
+  for (int32_t x = 1; x < 3 * S; ++x) {
+    push(trend, window, 7 + 3 * x);
+    TEST_ASSERT_EQUAL_FLOAT(3, trend.slope());
+  }
+  TEST_ASSERT_EQUAL(S, trend.size());
+}
+
+// Once the window is full the slope only covers the last S samples: a falling line that turns
+// flat reads flat once S flat samples pushed the last of it out.
+static void test_eviction_forgets_old_samples(void) {
+  TrendWindow<S> trend;
+  trend.clear();
+  std::deque<int32_t> window;
+  for (int32_t x = 0; x < S; ++x) push(trend, window, -50 * x);
+  TEST_ASSERT_EQUAL_FLOAT(-50, trend.slope());
+  for (long i = 0; i < S - 1; ++i) push(trend, window, 1000);
+  TEST_ASSERT_GREATER_THAN(0, trend.slope());
+  push(trend, window, 1000);
+  TEST_ASSERT_EQUAL_FLOAT(0, trend.slope());
+}
+
+static void test_matches_recomputed_fit(void) {
+  std::mt19937 rng(36);
+  std::uniform_int_distribution<int32_t> value(0, 0xFFFF);
+  TrendWindow<S> trend;
+  trend.clear();
+  std::deque<int32_t> window;
+  for (int i = 0; i < 10000; ++i) {
+    push(trend, window, value(rng));
+    const double expected = referenceSlope(window);
+    TEST_ASSERT_FLOAT_WITHIN(fabs(expected) * 1e-5 + 1e-3, expected, trend.slope());
+  }
+  trend.clear();
+  TEST_ASSERT_EQUAL(0, trend.size());
+  TEST_ASSERT_EQUAL_FLOAT(0, trend.slope());
+}
+
+static void test_worse_level_raised_at_once(void) {
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(72, 0, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(72.1, 0, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_DANGER, calcAlert(75.1, 0, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(64.9, 0, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_DANGER, calcAlert(59.9, 0, BANDS, ALERT_WARNING, HORIZON_SEC));
+}
+
+static void test_better_level_needs_hysteresis(void) {
+  // back under the danger edge, but not by the hysteresis yet
+  TEST_ASSERT_EQUAL(ALERT_DANGER, calcAlert(74.5, 0, BANDS, ALERT_DANGER, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(73.9, 0, BANDS, ALERT_DANGER, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(71.5, 0, BANDS, ALERT_WARNING, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(70.9, 0, BANDS, ALERT_WARNING, HORIZON_SEC));
+  // straight from danger to good when far enough inside
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(68, 0, BANDS, ALERT_DANGER, HORIZON_SEC));
+  // the same on the low side
+  TEST_ASSERT_EQUAL(ALERT_DANGER, calcAlert(60.5, 0, BANDS, ALERT_DANGER, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(61.5, 0, BANDS, ALERT_DANGER, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(66.1, 0, BANDS, ALERT_WARNING, HORIZON_SEC));
+}
+
+static void test_trending_enters_within_horizon(void) {
+  const float rising = 2.0f / HORIZON_SEC; // 70 % reaches 72 % right at the horizon
+  TEST_ASSERT_EQUAL(ALERT_TRENDING, calcAlert(70, rising, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(69.9, rising, BANDS, ALERT_NONE, HORIZON_SEC));
+  // falling towards the low edge
+  TEST_ASSERT_EQUAL(ALERT_TRENDING, calcAlert(66, -rising / 2, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(66, rising / 2, BANDS, ALERT_NONE, HORIZON_SEC));
+}
+
+static void test_trending_exits_at_one_and_a_half_horizon(void) {
+  const float rising = 2.0f / HORIZON_SEC;
+  // crossing 1.4 horizons away: not raised, but kept once raised
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(72 - 2.8f, rising, BANDS, ALERT_NONE, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_TRENDING, calcAlert(72 - 2.8f, rising, BANDS, ALERT_TRENDING, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(72 - 3.1f, rising, BANDS, ALERT_TRENDING, HORIZON_SEC));
+  // flat or unknown trend clears it
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(71.9, 0, BANDS, ALERT_TRENDING, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_NONE, calcAlert(71.9, NAN, BANDS, ALERT_TRENDING, HORIZON_SEC));
+}
+
+// Out of the good band the band level wins over any trend.
+static void test_trending_only_inside_good_band(void) {
+  const float rising = 2.0f / HORIZON_SEC;
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(73, rising, BANDS, ALERT_TRENDING, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_WARNING, calcAlert(71.5, -rising, BANDS, ALERT_WARNING, HORIZON_SEC));
+  TEST_ASSERT_EQUAL(ALERT_TRENDING, calcAlert(70.5, rising, BANDS, ALERT_WARNING, HORIZON_SEC));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_slope_of_a_line);
+  RUN_TEST(test_eviction_forgets_old_samples);
+  RUN_TEST(test_matches_recomputed_fit);
+  RUN_TEST(test_worse_level_raised_at_once);
+  RUN_TEST(test_better_level_needs_hysteresis);
+  RUN_TEST(test_trending_enters_within_horizon);
+  RUN_TEST(test_trending_exits_at_one_and_a_half_horizon);
+  RUN_TEST(test_trending_only_inside_good_band);
+  return UNITY_END();
+}
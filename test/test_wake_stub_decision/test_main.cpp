@@ -0,0 +1,92 @@
+#include <unity.h>
+#include "wake_stub_decision.h"
+
+// 150 kHz RC slow clock: 6.667 us per tick in Q13.19, as read from RTC_SLOW_CLK_CAL_REG
+#define CALIBRATION_150KHZ ((uint32_t)(1000000.0 / 150000 * (1 << 19)))
+// 125 kHz, exactly 8 us per tick
+#define CALIBRATION_125KHZ (8u << 19)
+
+static WakeStubState state;
+
+void setUp(void) {
+  state.armed = true;
+  state.deadlineTicks = 10000;
+  state.intervalTicks = 3000;
+  state.skippedWakeups = 0;
+}
+
+void tearDown(void) {}
+
+static void test_disarmed_boots(void) {
+  state.armed = false;
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, 0, false));
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, state.deadlineTicks - 1, false));
+}
+
+static void test_button_boots_before_deadline(void) {
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, 0, true));
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, state.deadlineTicks - 1, true));
+}
+
+static void test_sleeps_before_deadline(void) {
+  TEST_ASSERT_EQUAL(WAKE_STUB_SLEEP, wakeStubDecide(&state, 0, false));
+  TEST_ASSERT_EQUAL(WAKE_STUB_SLEEP, wakeStubDecide(&state, state.deadlineTicks - 1, false));
+}
+
+static void test_boots_at_and_after_deadline(void) {
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, state.deadlineTicks, false));
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, state.deadlineTicks + 1, false));
+  // a counter far past the deadline, e.g. after a long button hold
+  TEST_ASSERT_EQUAL(WAKE_STUB_BOOT, wakeStubDecide(&state, UINT64_MAX, false));
+}
+
+static void test_next_wake_keeps_cadence(void) {
+  TEST_ASSERT_EQUAL_UINT64(3000, wakeStubNextWakeTicks(&state, 0));
+  TEST_ASSERT_EQUAL_UINT64(6500, wakeStubNextWakeTicks(&state, 3500));
+}
+
+static void test_next_wake_clamped_to_deadline(void) {
+  TEST_ASSERT_EQUAL_UINT64(10000, wakeStubNextWakeTicks(&state, 7000));
+  TEST_ASSERT_EQUAL_UINT64(10000, wakeStubNextWakeTicks(&state, 9999));
+  state.intervalTicks = 0;
+  TEST_ASSERT_EQUAL_UINT64(5000, wakeStubNextWakeTicks(&state, 5000));
+}
+
+// Wakeups the stub would sleep through until the deadline, as wake_stub.cpp runs them.
+static void test_sleeps_through_to_deadline(void) {
+  uint64_t now = 500;
+  uint32_t wakeups = 0;
+  while (wakeStubDecide(&state, now, false) == WAKE_STUB_SLEEP) {
+    now = wakeStubNextWakeTicks(&state, now);
+    ++wakeups;
+  }
+  TEST_ASSERT_EQUAL_UINT64(state.deadlineTicks, now);
+  TEST_ASSERT_EQUAL(4, wakeups); // 3500, 6500, 9500, 10000
+}
+
+static void test_us_to_ticks(void) {
+  TEST_ASSERT_EQUAL_UINT64(125000, wakeStubUsToTicks(1000000, CALIBRATION_125KHZ));
+  TEST_ASSERT_EQUAL_UINT64(0, wakeStubUsToTicks(7, CALIBRATION_125KHZ));
+  // a day does not overflow the shift, the truncated calibration is off by less than 0.00001%
+  const uint64_t day = wakeStubUsToTicks(24ULL * 3600 * 1000000, CALIBRATION_150KHZ);
+  TEST_ASSERT_UINT64_WITHIN(150000ULL * 24 * 3600 / 10000000, 150000ULL * 24 * 3600, day);
+}
+
+static void test_zero_calibration(void) {
+  TEST_ASSERT_EQUAL_UINT64(0, wakeStubUsToTicks(1000000, 0));
+  TEST_ASSERT_EQUAL_UINT64(0, wakeStubUsToTicks(0, 0));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_disarmed_boots);
+  RUN_TEST(test_button_boots_before_deadline);
+  RUN_TEST(test_sleeps_before_deadline);
+  RUN_TEST(test_boots_at_and_after_deadline);
+  RUN_TEST(test_next_wake_keeps_cadence);
+  RUN_TEST(test_next_wake_clamped_to_deadline);
+  RUN_TEST(test_sleeps_through_to_deadline);
+  RUN_TEST(test_us_to_ticks);
+  RUN_TEST(test_zero_calibration);
+  return UNITY_END();
+}
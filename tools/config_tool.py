@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+"""Reads and writes the runtime config blob of the firmware (see src/runtime_config.h).
+
+Usage:
+    python3 tools/config_tool.py defaults > config.json
+    python3 tools/config_tool.py encode config.json         # prints the #CFG: line
+    python3 tools/config_tool.py decode <hex | #CFG:hex>
+    python3 tools/config_tool.py get --port /dev/ttyUSB0
+    python3 tools/config_tool.py set config.json --port /dev/ttyUSB0
+
+The device only listens for a moment after a cold boot or a button press: start get/set,
+then press the button. get/set need pyserial (it comes with PlatformIO).
+"""
+
+import argparse
+import json
+import math
+import re
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+MAGIC = 0x4643
+FORMAT_VERSION = 1
+HEADER = struct.Struct("<HBBH")
+FIXED = struct.Struct("<HHII5f5ffBii")
+STRINGS = (("wifi_ssid", 32), ("wifi_password", 64), ("ntp_server_0", 39), ("ntp_server_1", 39), ("ntp_server_2", 39))
+BAND_KEYS = ("danger_low", "warning_low", "warning_high", "danger_high", "hysteresis")
+UNITS = ("celsius", "fahrenheit")
+STATUS = ("ok", "too short", "bad magic", "bad version", "bad crc", "bad value", "storage fail")
+SETTINGS_H = Path(__file__).resolve().parent.parent / "include" / "settings.h"
+
+
+def settings_macros():
+    macros = {}
+    for line in SETTINGS_H.read_text().splitlines():
+        m = re.match(r"#define\s+(\w+)\s+(.*?)\s*(//.*)?$", line)
+        if m:
+            macros[m.group(1)] = m.group(2)
+    return macros
+
+
+def defaults():
+    """Compile-time defaults from settings.h, Wi-Fi credentials are left empty."""
+    m = settings_macros()
+    number = lambda name: eval(m[name], {})  # plain arithmetic like 3*60*60+5
+    bands = lambda name: dict(zip(BAND_KEYS, json.loads(m[name].replace("{", "[").replace("}", "]"))))
+    return {
+        "sensor_read_interval_sec": number("SENSOR_READ_INTERVAL_SEC"),
+        "sensor_max_interval_sec": number("ADAPTIVE_SENSOR_MAX_INTERVAL_SEC"),
+        "alarm_interval_sec": number("ALARM_INTERVAL_SEC"),
+        "trend_alert_horizon_sec": number("TREND_ALERT_HORIZON_SEC"),
+        "humidity_bands": bands("HUMIDITY_BANDS"),
+        "temperature_bands": bands("TEMPERATURE_BANDS"),
+        "alert_battery_low": number("ALERT_BAT_LOW"),
+        "degrees_unit": UNITS[0],
+        "gmt_offset_sec": number("GMT_OFFSET_SEC"),
+        "daylight_offset_sec": number("DAYLIGHT_OFFSET_SEC"),
+        "wifi_ssid": "",
+        "wifi_password": "",
+        "ntp_server_0": json.loads(m["NTP_SERVER_0"]),
+        "ntp_server_1": json.loads(m["NTP_SERVER_1"]),
+        "ntp_server_2": json.loads(m["NTP_SERVER_2"]),
+    }
+
+
+def validate(config):
+    """Same rules as configValid() in src/runtime_config.cpp, raises ValueError."""
+    def check(ok, message):
+        if not ok:
+            raise ValueError(message)
+
+    min_interval = settings_macros()["SENSOR_READ_INTERVAL_SEC"]
+    check(int(min_interval) <= config["sensor_read_interval_sec"] <= config["sensor_max_interval_sec"] <= 30 * 60,
+          f"sensor intervals must satisfy {min_interval} <= read <= max <= 1800")
+    check(config["alarm_interval_sec"] >= 60, "alarm interval must be at least 60s")
+    check(0 <= config["trend_alert_horizon_sec"] <= 24 * 3600, "trend horizon must be within a day")
+    for key in ("humidity_bands", "temperature_bands"):
+        b = config[key]
+        check(all(math.isfinite(b[k]) for k in BAND_KEYS), f"{key} must be finite")
+        check(b["danger_low"] <= b["warning_low"] < b["warning_high"] <= b["danger_high"], f"{key} edges must be ordered")
+        check(0 <= b["hysteresis"] and b["hysteresis"] * 2 < b["warning_high"] - b["warning_low"],
+              f"{key} hysteresis must be less than half of the good band")
+    check(0 <= config["alert_battery_low"] <= 1, "battery low must be within 0..1")
+    check(config["degrees_unit"] in UNITS, f"degrees unit must be one of {UNITS}")
+    for key in ("gmt_offset_sec", "daylight_offset_sec"):
+        check(abs(config[key]) <= 14 * 3600, f"{key} must be within 14h")
+    for key, max_len in STRINGS:
+        check(len(config[key].encode()) <= max_len, f"{key} is longer than {max_len} bytes")
+    check(config["wifi_ssid"] and config["ntp_server_0"], "wifi_ssid and ntp_server_0 must be set")
+
+
+def encode(config):
+    validate(config)
+    hb, tb = config["humidity_bands"], config["temperature_bands"]
+    payload = FIXED.pack(
+        config["sensor_read_interval_sec"], config["sensor_max_interval_sec"],
+        config["alarm_interval_sec"], config["trend_alert_horizon_sec"],
+        *(hb[k] for k in BAND_KEYS), *(tb[k] for k in BAND_KEYS),
+        config["alert_battery_low"], UNITS.index(config["degrees_unit"]),
+        config["gmt_offset_sec"], config["daylight_offset_sec"])
+    for key, _ in STRINGS:
+        value = config[key].encode()
+        payload += bytes([len(value)]) + value
+    blob = HEADER.pack(MAGIC, FORMAT_VERSION, 0, len(payload)) + payload
+    return blob + struct.pack("<I", zlib.crc32(blob))
+
+
+def decode(blob):
+    magic, version, _, length = HEADER.unpack_from(blob)
+    if magic != MAGIC or version != FORMAT_VERSION:
+        raise ValueError(f"unsupported blob: magic {magic:#06x}, version {version}")
+    end = HEADER.size + length
+    (crc,) = struct.unpack_from("<I", blob, end)
+    if crc != zlib.crc32(blob[:end]):
+        raise ValueError("crc mismatch")
+    fields = FIXED.unpack_from(blob, HEADER.size)
+    config = {
+        "sensor_read_interval_sec": fields[0],
+        "sensor_max_interval_sec": fields[1],
+        "alarm_interval_sec": fields[2],
+        "trend_alert_horizon_sec": fields[3],
+        "humidity_bands": {k: round(v, 4) for k, v in zip(BAND_KEYS, fields[4:9])},
+        "temperature_bands": {k: round(v, 4) for k, v in zip(BAND_KEYS, fields[9:14])},
+        "alert_battery_low": round(fields[14], 4),
+        "degrees_unit": UNITS[fields[15]],
+        "gmt_offset_sec": fields[16],
+        "daylight_offset_sec": fields[17],
+    }
+    pos = HEADER.size + FIXED.size
+    for key, _ in STRINGS:
+        n = blob[pos]
+        config[key] = blob[pos + 1:pos + 1 + n].decode()
+        pos += 1 + n
+    return config
+
+
+def exchange(port, command, baud=115200, timeout=30):
+    """Waits for the device config window and sends one command, returns the reply line."""
+    import serial
+
+    with serial.Serial(port, baud, timeout=timeout) as conn:
+        print("waiting for the device, press the button...", file=sys.stderr)
+        while True:
+            line = conn.readline().decode(errors="replace").strip()
+            if not line:
+                raise TimeoutError("device did not open the config window")
+            if line == "#CFG:READY":
+                break
+        conn.write((command + "\n").encode())
+        while True:
+            line = conn.readline().decode(errors="replace").strip()
+            if not line:
+                raise TimeoutError("no reply from the device")
+            if line.startswith("#CFG:"):
+                return line[5:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    sub.add_parser("defaults")
+    p = sub.add_parser("encode")
+    p.add_argument("file")
+    p = sub.add_parser("decode")
+    p.add_argument("blob")
+    p = sub.add_parser("get")
+    p.add_argument("--port", required=True)
+    p = sub.add_parser("set")
+    p.add_argument("file")
+    p.add_argument("--port", required=True)
+    args = parser.parse_args()
+
+    if args.command == "defaults":
+        print(json.dumps(defaults(), indent=2))
+    elif args.command == "encode":
+        print("#CFG:" + encode(json.loads(Path(args.file).read_text())).hex())
+    elif args.command == "decode":
+        print(json.dumps(decode(bytes.fromhex(args.blob.removeprefix("#CFG:"))), indent=2))
+    elif args.command == "get":
+        print(json.dumps(decode(bytes.fromhex(exchange(args.port, "#CFG?"))), indent=2))
+    elif args.command == "set":
+        reply = exchange(args.port, "#CFG:" + encode(json.loads(Path(args.file).read_text())).hex())
+        if reply != "OK":
+            code = int(reply.split()[-1])
+            sys.exit(f"device rejected the config: {STATUS[code] if code < len(STATUS) else code}")
+        print("config stored")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Fleet aggregation service: keeps the device tier cascade for many humidor monitors.
+
+Usage:
+    python3 tools/fleet_aggregator.py [--port 8090] [--shards N]
+
+Endpoints:
+    POST /telemetry        telemetry batch as uploaded by the firmware (X-Device-Id, X-Session-Id,
+                           X-Batch-Seq)
+    POST /readings         text lines "device,timestamp,temperature,humidity" (serial dumps, replays)
+    GET  /stats/<device>   current reading and 1D/1W/1M statistics, same as the device shows
+    GET  /devices          number of devices per shard
+
+Devices are hashed onto shard processes, one per core by default. Each shard owns the
+TierCascade (tools/tier_cascade.py) of its devices, so readings of a device are applied in
+arrival order, and statistics are precomputed on every hour tier push just like on the
+device - a query only copies them out, under the shard lock it shares with the ingest loop.
+"""
+
+import argparse
+import json
+import multiprocessing as mp
+import threading
+import time
+import zlib
+from collections import OrderedDict
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+from telemetry_collector import decode_batch
+from tier_cascade import TierCascade
+
+# Batches remembered per device for deduplication. A device only ever retries its latest
+# unacknowledged batch, so a short window is plenty.
+SEEN_BATCHES_PER_DEVICE = 16
+
+
+def shard_main(ingest, queries):
+    devices = {}
+    # the query thread reads devices and cascades the ingest loop changes, a query sees a
+    # batch either not at all or completely applied
+    lock = threading.Lock()
+
+    def serve_queries():
+        while True:
+            kind, device = queries.recv()
+            with lock:
+                if kind == "stats":
+                    cascade = devices.get(device)
+                    reply = cascade.summary() if cascade else None
+                else:
+                    reply = len(devices)
+            queries.send(reply)
+
+    threading.Thread(target=serve_queries, daemon=True).start()
+    while True:
+        device, samples = ingest.get()
+        with lock:
+            cascade = devices.get(device)
+            if cascade is None:
+                cascade = devices[device] = TierCascade()
+            for ts, temperature, humidity in samples:
+                cascade.collect(ts, temperature, humidity)
+
+
+class Shard:
+    def __init__(self):
+        self.ingest = mp.Queue()
+        self.queries, remote = mp.Pipe()
+        self.lock = threading.Lock()
+        self.process = mp.Process(target=shard_main, args=(self.ingest, remote), daemon=True)
+        self.process.start()
+
+    def query(self, kind, device=None):
+        with self.lock:
+            self.queries.send((kind, device))
+            return self.queries.recv()
+
+
+class Fleet:
+    def __init__(self, shards):
+        self.shards = [Shard() for _ in range(shards)]
+        self.seen_batches = {}  # device -> OrderedDict of (session, seq), oldest first
+        self.seen_lock = threading.Lock()
+
+    def shard(self, device):
+        return self.shards[zlib.crc32(device.encode()) % len(self.shards)]
+
+    def ingest(self, device, samples):
+        if samples:
+            self.shard(device).ingest.put((device, samples))
+
+    def ingest_batch(self, device, session, seq, payload):
+        samples = decode_batch(payload)
+        with self.seen_lock:
+            seen = self.seen_batches.setdefault(device, OrderedDict())
+            if (session, seq) in seen:
+                return 0
+            seen[(session, seq)] = None
+            if len(seen) > SEEN_BATCHES_PER_DEVICE:
+                seen.popitem(last=False)
+        self.ingest(device, samples)
+        return len(samples)
+
+    def ingest_lines(self, text):
+        per_device = {}
+        for line in text.splitlines():
+            parts = line.strip().split(",")
+            if len(parts) != 4:
+                continue
+            device, ts, temperature, humidity = parts
+            per_device.setdefault(device, []).append((int(ts), float(temperature), float(humidity)))
+        for device, samples in per_device.items():
+            self.ingest(device, samples)
+        return sum(len(s) for s in per_device.values())
+
+
+def make_handler(fleet):
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+        disable_nagle_algorithm = True
+        wbufsize = -1  # send headers and body in one segment, flushed per request
+
+        def reply(self, status, body=None, headers=()):
+            data = json.dumps(body).encode() if body is not None else b""
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(data)))
+            for name, value in headers:
+                self.send_header(name, value)
+            self.end_headers()
+            self.wfile.write(data)
+
+        def do_POST(self):
+            payload = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+            try:
+                if self.path == "/telemetry":
+                    count = fleet.ingest_batch(self.headers.get("X-Device-Id", "unknown"),
+                                               int(self.headers.get("X-Session-Id", 0)),
+                                               int(self.headers.get("X-Batch-Seq", 0)), payload)
+                elif self.path == "/readings":
+                    count = fleet.ingest_lines(payload.decode())
+                else:
+                    self.reply(404)
+                    return
+            except (ValueError, IndexError) as e:
+                self.reply(400, {"error": str(e)})
+                return
+            self.reply(200, {"accepted": count})
+
+        def do_GET(self):
+            if self.path.startswith("/stats/"):
+                device = self.path[len("/stats/"):]
+                started = time.perf_counter()
+                summary = fleet.shard(device).query("stats", device)
+                took_us = (time.perf_counter() - started) * 1e6
+                if summary is None:
+                    self.reply(404, {"error": "unknown device"})
+                else:
+                    self.reply(200, summary, [("X-Query-Us", "%.0f" % took_us)])
+            elif self.path == "/devices":
+                self.reply(200, [shard.query("count") for shard in fleet.shards])
+            else:
+                self.reply(404)
+
+        def log_message(self, format, *args):
+            pass
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=8090)
+    parser.add_argument("--shards", type=int, default=mp.cpu_count())
+    args = parser.parse_args()
+    fleet = Fleet(args.shards)
+    server = ThreadingHTTPServer(("", args.port), make_handler(fleet))
+    print("fleet aggregator on :%d with %d shards" % (args.port, args.shards))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
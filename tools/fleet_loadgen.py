@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Load generator for tools/fleet_aggregator.py: simulates a fleet uploading telemetry batches.
+
+Usage:
+    python3 tools/fleet_loadgen.py [--url http://localhost:8090] [--devices 2000]
+                                   [--batches 10] [--batch-size 360] [--threads 16]
+
+Every simulated device uploads --batches consecutive batches of --batch-size readings
+(40 s apart, random walk around 21 C / 68 %), then statistics of random devices are queried.
+Prints the ingest rate and the query latency, both end to end and inside the service.
+"""
+
+import argparse
+import http.client
+import random
+import statistics
+import threading
+import time
+from urllib.parse import urlparse
+
+from telemetry_collector import encode_batch
+
+
+def simulate(device_index, batch, batch_size, start=1700000000):
+    rnd = random.Random(device_index * 7919 + batch)
+    ts = start + batch * batch_size * 40
+    t, h = 21.0 + rnd.uniform(-1, 1), 68.0 + rnd.uniform(-3, 3)
+    samples = []
+    for _ in range(batch_size):
+        ts += 40 + rnd.choice((0, 0, 0, 1, -1))
+        t += rnd.gauss(0, 0.02)
+        h += rnd.gauss(0, 0.05)
+        samples.append((ts, round(t, 2), round(h, 2)))
+    return samples
+
+
+def worker(url, devices, batches, batch_size, sent):
+    conn = http.client.HTTPConnection(url.hostname, url.port)
+    for batch in range(batches):
+        for device in devices:
+            body = encode_batch(simulate(device, batch, batch_size))
+            conn.request("POST", "/telemetry", body, {"X-Device-Id": "dev%05d" % device,
+                                                      "X-Session-Id": "1",
+                                                      "X-Batch-Seq": str(batch)})
+            conn.getresponse().read()
+            sent[0] += batch_size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--url", default="http://localhost:8090")
+    parser.add_argument("--devices", type=int, default=2000)
+    parser.add_argument("--batches", type=int, default=10)
+    parser.add_argument("--batch-size", type=int, default=360)
+    parser.add_argument("--threads", type=int, default=16)
+    parser.add_argument("--queries", type=int, default=2000)
+    args = parser.parse_args()
+    url = urlparse(args.url)
+
+    counters = [[0] for _ in range(args.threads)]
+    threads = [threading.Thread(target=worker, args=(url, range(i, args.devices, args.threads), args.batches,
+                                                     args.batch_size, counters[i]))
+               for i in range(args.threads)]
+    started = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    took = time.perf_counter() - started
+    readings = sum(c[0] for c in counters)
+    print("ingested %d readings from %d devices in %.1fs: %.0f readings/s"
+          % (readings, args.devices, took, readings / took))
+
+    # let the shards drain their queues before measuring queries
+    conn = http.client.HTTPConnection(url.hostname, url.port)
+    time.sleep(1)
+    end_to_end, in_service = [], []
+    for _ in range(args.queries):
+        device = "dev%05d" % random.randrange(args.devices)
+        t0 = time.perf_counter()
+        conn.request("GET", "/stats/" + device)
+        response = conn.getresponse()
+        response.read()
+        end_to_end.append((time.perf_counter() - t0) * 1e6)
+        if response.status == 200:
+            in_service.append(float(response.getheader("X-Query-Us")))
+
+    def percentiles(values):
+        q = statistics.quantiles(values, n=100)
+        return "p50 %.0fus p99 %.0fus" % (q[49], q[98])
+
+    print("query latency end to end: %s" % percentiles(end_to_end))
+    print("query latency in service: %s" % percentiles(in_service))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Decode the binary log flushed by the firmware (lines starting with "#LOG:").
+
+Usage:
+    pio device monitor | python3 tools/log_decode.py
+    python3 tools/log_decode.py captured.txt
+
+Message formats are read from src/log_messages.h, so decode with the same revision
+that was flashed. Every other line is passed through unchanged.
+"""
+
+import re
+import struct
+import sys
+from pathlib import Path
+
+MESSAGES_H = Path(__file__).resolve().parent.parent / "src" / "log_messages.h"
+LEVELS = {1: "E", 2: "W", 3: "I", 4: "D"}
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?([udixXf%])")
+
+
+def load_formats(path=MESSAGES_H):
+    text = path.read_text()
+    return [(name, fmt.encode().decode("unicode_escape"))
+            for name, fmt in re.findall(r'X\((\w+),\s*"((?:[^"\\]|\\.)*)"\)', text)]
+
+
+def convert(word, kind):
+    if kind == "f":
+        return struct.unpack("<f", struct.pack("<I", word))[0]
+    if kind in "di":
+        return struct.unpack("<i", struct.pack("<I", word))[0]
+    return word
+
+
+def format_record(formats, msg_id, args):
+    if msg_id >= len(formats):
+        return "<unknown message %d> %s" % (msg_id, " ".join("%08x" % a for a in args))
+    name, fmt = formats[msg_id]
+    kinds = [k for k in CONVERSION.findall(fmt) if k != "%"]
+    try:
+        return fmt % tuple(convert(a, k) for a, k in zip(args, kinds))
+    except (TypeError, ValueError):
+        return "%s %s" % (name, args)
+
+
+def decode_words(formats, words):
+    i = 0
+    while i < len(words):
+        header = words[i]
+        msg_id, level, argc, ms = header >> 24, (header >> 21) & 0x7, (header >> 18) & 0x7, header & 0x3FFFF
+        args = words[i + 1:i + 1 + argc]
+        i += 1 + argc
+        yield "%8.3fs %s %s" % (ms / 1000.0, LEVELS.get(level, "?"), format_record(formats, msg_id, args))
+
+
+def decode_line(formats, line):
+    payload = line.split("#LOG:", 1)[1].strip()
+    words = [int(payload[i:i + 8], 16) for i in range(0, len(payload) - 7, 8)]
+    return list(decode_words(formats, words))
+
+
+def main():
+    formats = load_formats()
+    stream = open(sys.argv[1], errors="replace") if len(sys.argv) > 1 else sys.stdin
+    for line in stream:
+        if "#LOG:" in line:
+            for decoded in decode_line(formats, line):
+                print(decoded)
+        else:
+            sys.stdout.write(line)
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
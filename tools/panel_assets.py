@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Generates include/panel_assets.h: the img/*.png bitmaps and the GFX fonts pre-rotated into
+the panel-native layout PanelCanvas (src/panel_canvas.h) blits without per-pixel transforms.
+
+Usage:
+    python3 tools/panel_assets.py [--font path/to/Font.h ...] [--out include/panel_assets.h]
+
+The layout is one row per logical column, left to right; each row holds the column's pixels
+bottom to top (MSB first, 1 = ink), padded to whole bytes. That is the order the pixels have
+in the panel RAM with the display rotated by 90 degrees, so a row lands in one buffer line.
+
+Fonts are Adafruit GFX font headers (bitmap array, glyph array, GFXfont). The in-tree fonts
+are converted by default, fonts only converted with --font fall back to per-pixel drawing when
+missing. No dependencies: the PNG reader handles the non-interlaced formats image editors
+export.
+"""
+
+import argparse
+import re
+import struct
+import zlib
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+DEFAULT_FONTS = ("include/fnt_04b03b.h", "include/fnt_big_digits.h")
+
+
+def read_png(path):
+    """Returns (width, height, rows of (luminance, alpha) tuples)."""
+    data = Path(path).read_bytes()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG")
+    pos, idat, palette, trns = 8, b"", None, None
+    while pos < len(data):
+        length, kind = struct.unpack_from(">I4s", data, pos)
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+    if interlace or depth > 8:
+        raise ValueError(f"{path}: interlaced or 16-bit PNGs are not supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+    rows, prev = [], bytearray(stride)
+    for y in range(height):
+        kind, line = raw[y * (stride + 1)], bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        prev = line
+
+        def sample(x, ch=0):
+            if depth == 8:
+                return line[x * channels + ch]
+            bit = x * depth
+            return (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+
+        row = []
+        for x in range(width):
+            if color == 3:
+                index = sample(x)
+                r, g, b = palette[index]
+                alpha = trns[index] if trns is not None and index < len(trns) else 255
+            elif color in (0, 4):
+                r = g = b = sample(x) * 255 // ((1 << depth) - 1)
+                alpha = sample(x, 1) if color == 4 else 255
+            else:
+                r, g, b = (sample(x, ch) for ch in range(3))
+                alpha = sample(x, 3) if color == 6 else 255
+            row.append(((r * 299 + g * 587 + b * 114) // 1000, alpha))
+        rows.append(row)
+    return width, height, rows
+
+
+def native_rows(width, height, ink):
+    """ink(x, y) -> bool, logical coordinates. Returns the native row bytes."""
+    out = bytearray()
+    for x in range(width):
+        row = bytearray((height + 7) // 8)
+        for j in range(height):
+            if ink(x, height - 1 - j):
+                row[j // 8] |= 0x80 >> (j % 8)
+        out += row
+    return out
+
+
+def parse_font(path):
+    """Parses an Adafruit GFX font header, returns (font name, first, glyphs, bitmap bytes)."""
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", "", Path(path).read_text(), flags=re.S)
+    arrays = re.findall(r"(\w+)\s*\[\s*\]\s*PROGMEM\s*=\s*\{(.*?)\};", text, re.S)
+    bitmap = next(body for name, body in arrays if name.endswith("Bitmaps"))
+    glyphs = next(body for name, body in arrays if name.endswith("Glyphs"))
+    font = re.search(r"GFXfont\s+(\w+)\s+PROGMEM\s*=\s*\{[^,]*,[^,]*,\s*(\w+)\s*,", text)
+    bitmap = [int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", bitmap)]
+    glyphs = [tuple(int(v) for v in g.split(",")) for g in re.findall(r"\{([^{}]*)\}", glyphs)]
+    return font.group(1), int(font.group(2), 0), glyphs, bitmap
+
+
+def glyph_ink(bitmap, offset, width):
+    """Glyph bits are one continuous MSB-first stream, row after row."""
+    def ink(x, y):
+        bit = y * width + x
+        return bitmap[offset + bit // 8] & (0x80 >> (bit % 8))
+    return ink
+
+
+def c_bytes(data, indent="\t"):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate(images, fonts):
+    out = [
+        "#pragma once",
+        "",
+        "// Generated by tools/panel_assets.py from img/*.png and the GFX fonts, do not edit.",
+        "// Panel-native layout, see tools/panel_assets.py and PanelCanvas.",
+        "",
+        '#include "panel_canvas.h"',
+    ]
+    for f in fonts:
+        if Path(f).parent == ROOT / "include":
+            out.append(f'#include "{Path(f).name}"')
+        elif Path(f).parent.name == "Fonts":  # Adafruit GFX library font
+            out.append(f"#include <Fonts/{Path(f).name}>")
+    out.append("")
+
+    for path in images:
+        name = Path(path).stem
+        width, height, rows = read_png(path)
+        data = native_rows(width, height, lambda x, y: rows[y][x][1] >= 128 and rows[y][x][0] < 128)
+        out += [
+            f"// '{name}', {width}x{height}px",
+            f"const uint8_t nbmp_{name}_rows [] PROGMEM = {{",
+            c_bytes(data),
+            "};",
+            f"const NativeBitmap nbmp_{name} = {{ {width}, {height}, nbmp_{name}_rows }};",
+            "",
+        ]
+
+    names = []
+    for path in fonts:
+        name, first, glyphs, bitmap = parse_font(path)
+        data, offsets = bytearray(), []
+        for offset, width, height, _, _, _ in glyphs:
+            offsets.append(len(data))
+            data += native_rows(width, height, glyph_ink(bitmap, offset, width))
+        out += [
+            f"// Font: {name}, {len(glyphs)} glyphs from 0x{first:02X}",
+            f"const uint8_t {name}_NativeBitmaps [] PROGMEM = {{",
+            c_bytes(data),
+            "};",
+            f"const uint16_t {name}_NativeOffsets [] PROGMEM = {{",
+            "\t" + ", ".join(str(o) for o in offsets),
+            "};",
+            f"const NativeFont {name}_Native = {{ &{name}, {name}_NativeBitmaps, {name}_NativeOffsets }};",
+            "",
+        ]
+        names.append(name)
+
+    out += [
+        "const NativeFont* const nativeFonts[] = {",
+        "".join(f"\t&{name}_Native,\n" for name in names).rstrip("\n"),
+        "};",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--font", action="append", default=[], help="extra GFX font header")
+    parser.add_argument("--out", default=str(ROOT / "include" / "panel_assets.h"))
+    args = parser.parse_args()
+
+    images = sorted((ROOT / "img").glob("*.png"))
+    fonts = [ROOT / f for f in DEFAULT_FONTS] + [Path(f) for f in args.font]
+    Path(args.out).write_text(generate(images, fonts))
+    print(args.out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Pulls and decodes the binary state dump of the firmware (see src/state_dump.h).
+
+Usage:
+    python3 tools/state_dump.py get --port /dev/ttyUSB0 [--port /dev/ttyUSB1 ...] [--out dir]
+    python3 tools/state_dump.py listen --port /dev/ttyUSB0      # waits for a long button press
+    python3 tools/state_dump.py decode dump.bin                 # raw frame or captured serial output
+
+get asks over the serial window, which only opens after a cold boot or a button press: start
+it, then press the button on each unit. With several ports the units are read in parallel and
+the result is one JSON object keyed by port (or one file per port with --out).
+Needs pyserial (it comes with PlatformIO).
+"""
+
+import argparse
+import json
+import struct
+import sys
+import zlib
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+MAGIC = 0x5344
+FORMAT_VERSION = 1
+HEADER = struct.Struct("<HBBH")
+MARKER = b"#DUMP:"
+BUFFERS = ("current_t", "current_h", "hour_t", "hour_h", "day_t", "day_h",
+           "week_t", "week_h", "month_t", "month_h", "year_t", "year_h")
+TIER_PUSH = ("hour", "day", "week", "month", "year")
+STATS_KEYS = ("average", "median", "max", "min")
+EXPOSURE_KEYS = ("mean", "stddev", "out_of_band_percent", "danger_percent")
+ALERTS = ("none", "trending", "warning", "danger")
+
+
+def cobs_decode(data):
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        code = data[pos]
+        if code == 0:
+            raise ValueError("zero byte inside a COBS frame")
+        block = data[pos + 1:pos + code]
+        if len(block) != code - 1:
+            raise ValueError("truncated COBS frame")
+        out += block
+        pos += code
+        if code < 0xFF and pos < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.data, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return values if len(values) > 1 else values[0]
+
+
+def decode(frame):
+    magic, version, _, length = HEADER.unpack_from(frame)
+    if magic != MAGIC or version != FORMAT_VERSION:
+        raise ValueError(f"unsupported dump: magic {magic:#06x}, version {version}")
+    end = HEADER.size + length
+    (crc,) = struct.unpack_from("<I", frame, end)
+    if crc != zlib.crc32(frame[:end]):
+        raise ValueError("crc mismatch")
+
+    r = Reader(frame[HEADER.size:end])
+    state = {
+        "wakeup_counter": r.take("I"),
+        "unix_time": r.take("I"),
+        "temperature_alert": ALERTS[r.take("B")],
+        "humidity_alert": ALERTS[r.take("B")],
+    }
+    signed = r.take("B")
+    value_fmt = "h" if signed else "H"
+    gap = 0x7FFF if signed else 0xFFFF  # historyGap(): slot without readings, shown as null
+    state["last_collected_at"] = r.take("I")
+    state["seconds_since_push"] = {tier: r.take("I") for tier in TIER_PUSH}
+    state["buffers"] = {}
+    for name in BUFFERS:
+        capacity, count = r.take("B"), r.take("B")
+        values = [None if raw == gap else raw / 100 for raw in (r.take(value_fmt) for _ in range(count))]
+        state["buffers"][name] = {"capacity": capacity, "values": values}
+    for channel in ("temperature", "humidity"):
+        state[channel] = {"current": r.take(value_fmt) / 100}
+        for period in ("1d", "1w", "1m"):
+            state[channel][period] = {k: r.take(value_fmt) / 100 for k in STATS_KEYS}
+    for channel in ("temperature", "humidity"):
+        for period in ("1d", "1w", "1m"):
+            state[channel]["exposure_" + period] = {k: round(r.take("f"), 4) for k in EXPOSURE_KEYS}
+    return state
+
+
+def extract(raw):
+    """Finds the first dump frame in captured serial output, a bare frame is returned as is."""
+    at = raw.find(MARKER)
+    if at < 0:
+        return raw
+    end = raw.index(b"\x00", at)
+    return cobs_decode(raw[at + len(MARKER):end])
+
+
+def read_dump(port, command=None, baud=115200, timeout=30):
+    """Reads serial output until a dump frame arrives, sends `command` once the window opens."""
+    import serial
+
+    with serial.Serial(port, baud, timeout=timeout) as conn:
+        while True:
+            line = conn.readline()
+            if not line:
+                raise TimeoutError(f"{port}: no dump from the device")
+            if command and line.strip() == b"#CFG:READY":
+                conn.write((command + "\n").encode())
+            if MARKER in line:
+                rest = line[line.index(MARKER) + len(MARKER):]
+                while b"\x00" not in rest:
+                    chunk = conn.read_until(b"\x00")
+                    if not chunk:
+                        raise TimeoutError(f"{port}: truncated dump")
+                    rest += chunk
+                return decode(cobs_decode(rest[:rest.index(b"\x00")]))
+
+
+def read_all(ports, command, out):
+    print("waiting for the devices, press the button...", file=sys.stderr)
+    with ThreadPoolExecutor(max_workers=len(ports)) as pool:
+        states = dict(zip(ports, pool.map(lambda port: read_dump(port, command), ports)))
+    if out:
+        Path(out).mkdir(parents=True, exist_ok=True)
+        for port, state in states.items():
+            path = Path(out) / (Path(port).name + ".json")
+            path.write_text(json.dumps(state, indent=2))
+            print(path)
+    else:
+        print(json.dumps(states if len(ports) > 1 else states[ports[0]], indent=2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    for name in ("get", "listen"):
+        p = sub.add_parser(name)
+        p.add_argument("--port", required=True, action="append")
+        p.add_argument("--out")
+    p = sub.add_parser("decode")
+    p.add_argument("file")
+    args = parser.parse_args()
+
+    if args.command == "decode":
+        print(json.dumps(decode(extract(Path(args.file).read_bytes())), indent=2))
+    else:
+        read_all(args.port, "#DUMP?" if args.command == "get" else None, args.out)
+
+
+if __name__ == "__main__":
+    main()
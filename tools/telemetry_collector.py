@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""Local collector for telemetry batches uploaded by the firmware (see src/telemetry.h).
+
+Usage:
+    python3 tools/telemetry_collector.py [--port 8080] [--out telemetry]
+
+Every device gets a CSV file <out>/<device-id>.csv with timestamp,temperature,humidity rows.
+Batches are deduplicated by (device, X-Session-Id, X-Batch-Seq), so retried uploads are
+acknowledged without being stored twice. The sequence number starts over when a device cold
+boots, the session id it draws on every cold boot keeps those batches apart.
+"""
+
+import argparse
+import csv
+import struct
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from pathlib import Path
+
+FORMAT_VERSION = 1
+
+
+class BitReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def read(self, bits):
+        value = 0
+        for _ in range(bits):
+            byte = self.data[self.pos // 8]
+            value = (value << 1) | ((byte >> (7 - self.pos % 8)) & 1)
+            self.pos += 1
+        return value
+
+    def read_signed(self, bits):
+        value = self.read(bits)
+        return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+class BitWriter:
+    def __init__(self):
+        self.data = bytearray()
+        self.pos = 0
+
+    def write(self, value, bits):
+        for i in range(bits - 1, -1, -1):
+            if self.pos % 8 == 0:
+                self.data.append(0)
+            if (value >> i) & 1:
+                self.data[-1] |= 0x80 >> (self.pos % 8)
+            self.pos += 1
+
+
+def write_xor(writer, value, prev):
+    x = value ^ prev
+    if x == 0:
+        writer.write(0, 1)
+        return
+    leading = 16 - x.bit_length()
+    trailing = (x & -x).bit_length() - 1
+    meaningful = 16 - leading - trailing
+    writer.write(1, 1)
+    writer.write(leading, 4)
+    writer.write(meaningful - 1, 4)
+    writer.write(x >> trailing, meaningful)
+
+
+def encode_batch(samples):
+    """Same encoding as TelemetryQueue, for simulators. samples: (timestamp, temperature, humidity)."""
+    writer = BitWriter()
+    prev_ts, prev_delta, prev_t, prev_h = 0, 0, 0, 0
+    for i, (ts, temperature, humidity) in enumerate(samples):
+        t, h = round(temperature * 100.0) & 0xFFFF, round(humidity * 100.0) & 0xFFFF
+        if i == 0:
+            writer.write(ts, 32)
+            writer.write(t, 16)
+            writer.write(h, 16)
+        else:
+            delta = ts - prev_ts
+            dod = delta - prev_delta
+            if dod == 0:
+                writer.write(0, 1)
+            elif -64 <= dod <= 63:
+                writer.write(0b10, 2)
+                writer.write(dod & 0x7F, 7)
+            elif -256 <= dod <= 255:
+                writer.write(0b110, 3)
+                writer.write(dod & 0x1FF, 9)
+            elif -2048 <= dod <= 2047:
+                writer.write(0b1110, 4)
+                writer.write(dod & 0xFFF, 12)
+            else:
+                writer.write(0b1111, 4)
+                writer.write(dod & 0xFFFFFFFF, 32)
+            write_xor(writer, t, prev_t)
+            write_xor(writer, h, prev_h)
+            prev_delta = delta
+        prev_ts, prev_t, prev_h = ts, t, h
+    return struct.pack("<BH", FORMAT_VERSION, len(samples)) + bytes(writer.data)
+
+
+def read_xor(reader, prev):
+    if reader.read(1) == 0:
+        return prev
+    leading = reader.read(4)
+    meaningful = reader.read(4) + 1
+    trailing = 16 - leading - meaningful
+    return prev ^ (reader.read(meaningful) << trailing)
+
+
+def decode_batch(payload):
+    """Returns a list of (unix timestamp, temperature C, humidity %)."""
+    version, count = struct.unpack_from("<BH", payload)
+    if version != FORMAT_VERSION:
+        raise ValueError("unsupported telemetry format %d" % version)
+    reader = BitReader(payload[3:])
+    samples = []
+    ts, t, h, delta = 0, 0, 0, 0
+    for i in range(count):
+        if i == 0:
+            ts, t, h = reader.read(32), reader.read(16), reader.read(16)
+        else:
+            if reader.read(1) == 0:
+                dod = 0
+            elif reader.read(1) == 0:
+                dod = reader.read_signed(7)
+            elif reader.read(1) == 0:
+                dod = reader.read_signed(9)
+            elif reader.read(1) == 0:
+                dod = reader.read_signed(12)
+            else:
+                dod = reader.read_signed(32)
+            delta += dod
+            ts += delta
+            t = read_xor(reader, t)
+            h = read_xor(reader, h)
+        temperature = (t - 0x10000 if t & 0x8000 else t) / 100.0
+        samples.append((ts, temperature, h / 100.0))
+    return samples
+
+
+class Collector:
+    def __init__(self, out_dir):
+        self.out_dir = Path(out_dir)
+        self.out_dir.mkdir(parents=True, exist_ok=True)
+        self.seen = set()
+        self.lock = threading.Lock()
+
+    def ingest(self, device, session, seq, payload):
+        """Stores a batch, returns the decoded samples (empty for a duplicate)."""
+        samples = decode_batch(payload)
+        with self.lock:
+            if (device, session, seq) in self.seen:
+                return []
+            self.seen.add((device, session, seq))
+            path = self.out_dir / ("%s.csv" % device.replace(":", ""))
+            with path.open("a", newline="") as f:
+                csv.writer(f).writerows(samples)
+        return samples
+
+
+def make_handler(collector):
+    class Handler(BaseHTTPRequestHandler):
+        def do_POST(self):
+            payload = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+            device = self.headers.get("X-Device-Id", "unknown")
+            try:
+                session = int(self.headers.get("X-Session-Id", 0))
+                seq = int(self.headers.get("X-Batch-Seq", 0))
+                samples = collector.ingest(device, session, seq, payload)
+            except (ValueError, IndexError, struct.error) as e:
+                self.send_error(400, str(e))
+                return
+            self.log_message("%s session %08x batch #%d: %d readings stored, %s dropped on device",
+                             device, session, seq, len(samples), self.headers.get("X-Dropped", "?"))
+            self.send_response(204)
+            self.end_headers()
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--out", default="telemetry")
+    args = parser.parse_args()
+    server = ThreadingHTTPServer(("", args.port), make_handler(Collector(args.out)))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Tests for fleet_aggregator.py.
+
+Usage:
+    python3 -m unittest discover -s tools -p "test_*.py"
+"""
+
+import multiprocessing as mp
+import queue
+import threading
+import unittest
+
+import fleet_aggregator
+from telemetry_collector import encode_batch
+from tier_cascade import TierCascade
+
+SAMPLES_PER_BATCH = 400
+
+
+def batch(device_index):
+    return [(1700000000 + i * 40, 20.0 + (device_index + i) % 50 / 10.0, 60.0 + i % 7) for i in range(SAMPLES_PER_BATCH)]
+
+
+class ShardTest(unittest.TestCase):
+    """Runs shard_main in a thread of this process, queried while it ingests."""
+
+    def setUp(self):
+        self.ingest = queue.Queue()
+        self.queries, remote = mp.Pipe()
+        threading.Thread(target=fleet_aggregator.shard_main, args=(self.ingest, remote), daemon=True).start()
+
+    def query(self, kind, device=None):
+        self.queries.send((kind, device))
+        self.assertTrue(self.queries.poll(10), "query thread died")
+        return self.queries.recv()
+
+    def test_queries_see_whole_batches(self):
+        devices = 60
+        expected = []
+        for i in range(devices):
+            cascade = TierCascade()
+            for sample in batch(i):
+                cascade.collect(*sample)
+            expected.append(cascade.summary())
+        for i in range(devices):
+            self.ingest.put(("device-%d" % i, batch(i)))
+        seen = 0
+        while seen < devices:
+            for i in range(devices):
+                summary = self.query("stats", "device-%d" % i)
+                if summary is not None:
+                    self.assertEqual(expected[i], summary)
+            seen = self.query("count")
+        for i in range(devices):
+            self.assertEqual(expected[i], self.query("stats", "device-%d" % i))
+
+    def test_unknown_device(self):
+        self.assertIsNone(self.query("stats", "nobody"))
+        self.assertEqual(0, self.query("count"))
+
+
+class DedupTest(unittest.TestCase):
+    def test_window_per_device(self):
+        fleet = fleet_aggregator.Fleet(0)
+        ingested = []
+        fleet.ingest = lambda device, samples: ingested.append(device)
+        payload = encode_batch(batch(0)[:3])
+        self.assertEqual(3, fleet.ingest_batch("a", 1, 0, payload))
+        self.assertEqual(0, fleet.ingest_batch("a", 1, 0, payload))
+        self.assertEqual(3, fleet.ingest_batch("a", 2, 0, payload))
+        self.assertEqual(3, fleet.ingest_batch("b", 1, 0, payload))
+        for seq in range(1, fleet_aggregator.SEEN_BATCHES_PER_DEVICE + 1):
+            fleet.ingest_batch("a", 1, seq, payload)
+        # (1, 0) fell out of the window
+        self.assertEqual(3, fleet.ingest_batch("a", 1, 0, payload))
+        self.assertEqual(["a", "a", "b"], ingested[:3])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Tests for telemetry_collector.py against batches encoded by the firmware.
+
+Usage:
+    python3 -m unittest discover -s tools -p "test_*.py"
+
+The batch and the trace it encodes come from test/test_telemetry/test_main.cpp, where the
+native test checks TelemetryQueue produces exactly that batch, so a format change on either
+side fails one of the two.
+"""
+
+import http.client
+import re
+import tempfile
+import threading
+import unittest
+from http.server import ThreadingHTTPServer
+from pathlib import Path
+
+import telemetry_collector
+
+NATIVE_TEST = Path(__file__).resolve().parent.parent / "test" / "test_telemetry" / "test_main.cpp"
+
+
+def native_fixture():
+    """Returns (trace as the collector decodes it, encoded batch) from the native test."""
+    text = NATIVE_TEST.read_text()
+    trace = re.search(r"TRACE\[\]\s*=\s*\{(.*?)\};", text, re.S).group(1)
+    trace = [(int(ts), int(t) / 100.0, int(h) / 100.0)
+             for ts, t, h in re.findall(r"\{\s*(\d+),\s*(-?\d+),\s*(\d+)\s*\}", trace)]
+    batch = re.search(r"EXPECTED_BATCH\[\]\s*=\s*\{(.*?)\};", text, re.S).group(1)
+    return trace, bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", batch))
+
+
+class DecodeTest(unittest.TestCase):
+    def test_decodes_firmware_batch(self):
+        trace, batch = native_fixture()
+        self.assertEqual(10, len(trace))
+        self.assertEqual(trace, telemetry_collector.decode_batch(batch))
+
+    def test_encoder_matches_firmware(self):
+        trace, batch = native_fixture()
+        self.assertEqual(batch, telemetry_collector.encode_batch(trace))
+
+    def test_rejects_other_version(self):
+        _, batch = native_fixture()
+        with self.assertRaises(ValueError):
+            telemetry_collector.decode_batch(b"\x02" + batch[1:])
+
+
+class CollectorServerTest(unittest.TestCase):
+    """Posts the batch to a collector on a local port, as uploadTelemetry() does."""
+
+    def setUp(self):
+        self.out = tempfile.TemporaryDirectory()
+        collector = telemetry_collector.Collector(self.out.name)
+        self.server = ThreadingHTTPServer(("127.0.0.1", 0), telemetry_collector.make_handler(collector))
+        self.server.RequestHandlerClass.log_message = lambda *args: None
+        self.thread = threading.Thread(target=self.server.serve_forever, daemon=True)
+        self.thread.start()
+        self.trace, self.batch = native_fixture()
+
+    def tearDown(self):
+        self.server.shutdown()
+        self.server.server_close()
+        self.out.cleanup()
+
+    def post(self, session, seq, payload=None):
+        connection = http.client.HTTPConnection("127.0.0.1", self.server.server_address[1], timeout=5)
+        connection.request("POST", "/telemetry", body=self.batch if payload is None else payload, headers={
+            "Content-Type": "application/octet-stream",
+            "X-Device-Id": "24:6F:28:AA:BB:CC",
+            "X-Session-Id": str(session),
+            "X-Batch-Seq": str(seq),
+            "X-Dropped": "0",
+        })
+        status = connection.getresponse().status
+        connection.close()
+        return status
+
+    def stored_rows(self):
+        path = Path(self.out.name) / "246F28AABBCC.csv"
+        return path.read_text().splitlines() if path.exists() else []
+
+    def test_retry_stored_once(self):
+        self.assertEqual(204, self.post(0x1234, 0))
+        self.assertEqual(204, self.post(0x1234, 0))
+        self.assertEqual(len(self.trace), len(self.stored_rows()))
+        self.assertEqual(204, self.post(0x1234, 1))
+        self.assertEqual(2 * len(self.trace), len(self.stored_rows()))
+
+    def test_new_boot_session_restarts_sequence(self):
+        self.assertEqual(204, self.post(0x1234, 0))
+        # cold boot: the sequence starts over under a new session id
+        self.assertEqual(204, self.post(0x9876, 0))
+        self.assertEqual(2 * len(self.trace), len(self.stored_rows()))
+        self.assertEqual(204, self.post(0x9876, 0))
+        self.assertEqual(2 * len(self.trace), len(self.stored_rows()))
+
+    def test_bad_batch_rejected(self):
+        self.assertEqual(400, self.post(0x1234, 0, b"\x01\x05\x00"))
+        self.assertEqual(400, self.post("not-a-number", 0))
+        self.assertEqual([], self.stored_rows())
+
+
+if __name__ == "__main__":
+    unittest.main()
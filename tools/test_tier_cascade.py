@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Tests for tier_cascade.py against the firmware StatsCollector.
+
+Usage:
+    python3 -m unittest discover -s tools -p "test_*.py"
+
+The trace and the CRC of the state it ends in come from test/test_stats_collector/test_main.cpp,
+where the native test replays the trace through StatsCollector, so the cascade drifting from
+the firmware on either side fails one of the two.
+"""
+
+import re
+import unittest
+import zlib
+from pathlib import Path
+
+from tier_cascade import TierCascade
+
+NATIVE_TEST = Path(__file__).resolve().parent.parent / "test" / "test_stats_collector" / "test_main.cpp"
+START = 1700000000
+
+
+def native_fixture():
+    """Returns (segments, dump CRC) from the native test."""
+    text = NATIVE_TEST.read_text()
+    trace = re.search(r"PARITY_TRACE\[\]\s*=\s*\{(.*?)\};", text, re.S).group(1)
+    segments = [(int(n), int(interval), int(step), announced == "true") for n, interval, step, announced
+                in re.findall(r"\{\s*(\d+),\s*(-?\d+),\s*(-?\d+),\s*(true|false)\s*\}", trace)]
+    crc = re.search(r"PARITY_DUMP_CRC\s*=\s*(0x[0-9a-fA-F]+);", text).group(1)
+    return segments, int(crc, 16)
+
+
+def replay(segments, clock_steps=True):
+    """test_parity_trace() in the native test, `clock_steps` False leaves out clock_stepped()."""
+    cascade = TierCascade()
+    at = START
+    i = 0
+    for readings, interval, step, announced in segments:
+        at += step
+        if announced and clock_steps:
+            cascade.clock_stepped(step)
+        for _ in range(readings):
+            at += interval
+            cascade.collect(at, 18.0 + (i * 7 % 40) * 0.25, 55.0 + (i * 11 % 48) * 0.25)
+            i += 1
+    return cascade
+
+
+class ParityTest(unittest.TestCase):
+    def test_same_state_as_firmware(self):
+        segments, crc = native_fixture()
+        self.assertEqual(12, len(segments))
+        cascade = replay(segments)
+        self.assertGreater(len(cascade.t.year), 0)
+        self.assertEqual(crc, zlib.crc32(cascade.dump()))
+
+    def test_trace_needs_clock_steps(self):
+        segments, crc = native_fixture()
+        self.assertNotEqual(crc, zlib.crc32(replay(segments, clock_steps=False).dump()))
+
+
+class CollectTest(unittest.TestCase):
+    def test_backwards_reading_is_one_interval(self):
+        reference = TierCascade()
+        repeated = TierCascade()
+        for i in range(120):
+            reference.collect(START + i * 40, 21.0, 68.0)
+            repeated.collect(START + (i if i < 60 else i - 60) * 40, 21.0, 68.0)
+        reference.last_collected_at = repeated.last_collected_at
+        self.assertEqual(reference.dump(), repeated.dump())
+
+    def test_clock_stepped_before_first_reading(self):
+        cascade = TierCascade()
+        cascade.clock_stepped(3600)
+        self.assertEqual(0, cascade.last_collected_at)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,202 @@
+"""Host port of the StatsCollector tier cascade (src/stats_collector.h).
+
+Mirrors collect() step by step on compact (x100, uint16) values, so a host keeps exactly the
+hour/day/week/month/year tiers and 1D/1W/1M statistics the device would show for the same
+readings. Keep in sync with the firmware when the cascade changes, test_tier_cascade.py checks
+both end in the same state for a trace the native StatsCollector test replays as well.
+"""
+
+import struct
+from collections import deque
+
+SENSOR_READ_INTERVAL_SEC = 40
+HISTORY_GAP_SEC = 15 * 60
+PX_PER_1H, PX_PER_23H, PX_PER_6D, PX_PER_23D, PX_PER_11M = 30, 46, 36, 69, 48
+CURRENT_READING_MEDIAN_FILTER_SIZE = 60 // PX_PER_1H * 60 // SENSOR_READ_INTERVAL_SEC
+
+HOUR_PUSH = 60 // PX_PER_1H * 60
+DAY_PUSH = 60 // (PX_PER_23H // (24 - 1)) * 60
+WEEK_PUSH = (7 - 1) * 24 // PX_PER_6D * 60 * 60
+MONTH_PUSH = (24 - 1) * 24 // PX_PER_23D * 60 * 60
+YEAR_PUSH = int((12 - 1) * 30.0 / PX_PER_11M * 60 * 60 * 24)
+GAP = 0xFFFF  # historyGap(): tier slot without readings
+
+
+def pack(value):
+    return int(value * 100.0) & 0xFFFF
+
+
+def unpack(value):
+    return value / 100.0
+
+
+def c_div(a, b):
+    """Integer division truncating toward zero, like C."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+def statistics(values, oldest=None):
+    """calculateStatistics(): (average, median, max, min) over the oldest N entries."""
+    values = list(values)[:oldest] if oldest is not None else list(values)
+    if not values:
+        return (0, 0, 0, 0)
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    median = ordered[middle] if len(ordered) % 2 else (ordered[middle - 1] + ordered[middle]) // 2
+    return (c_div(sum(values), len(values)), median, max(values), min(values))
+
+
+def tier_median(values, oldest=None):
+    """tierMedian(): median of the oldest N entries without gaps, GAP if nothing is left."""
+    values = [v for v in (list(values)[:oldest] if oldest is not None else values) if v != GAP]
+    return statistics(values)[1] if values else GAP
+
+
+def period_statistics(median, tier):
+    """periodStatistics(): returns the stats and the median handed on to the next period."""
+    values = [v for v in [median] + list(tier) if v != GAP]
+    stats = statistics(values)
+    return stats, (stats[1] if values else median)
+
+
+def unpack_stats(stats):
+    return {"average": unpack(stats[0]), "median": unpack(stats[1]), "max": unpack(stats[2]), "min": unpack(stats[3])}
+
+
+class Channel:
+    def __init__(self):
+        self.current = deque(maxlen=CURRENT_READING_MEDIAN_FILTER_SIZE)
+        self.hour = deque(maxlen=PX_PER_1H)
+        self.day = deque(maxlen=PX_PER_23H)
+        self.week = deque(maxlen=PX_PER_6D)
+        self.month = deque(maxlen=PX_PER_23D)
+        self.year = deque(maxlen=PX_PER_11M)
+        self.stats_current = 0
+        self.stats_1d = self.stats_1w = self.stats_1m = (0, 0, 0, 0)
+
+    def update_period_stats(self):
+        median = tier_median(self.hour)
+        self.stats_1d, median = period_statistics(median, self.day)
+        self.stats_1w, median = period_statistics(median, self.week)
+        self.stats_1m, median = period_statistics(median, self.month)
+
+
+class TierCascade:
+    def __init__(self):
+        self.t = Channel()
+        self.h = Channel()
+        self.last_collected_at = 0
+        self.since_hour = HOUR_PUSH - 1
+        self.since_day = DAY_PUSH - 1
+        self.since_week = WEEK_PUSH - 1
+        self.since_month = MONTH_PUSH - 1
+        self.since_year = YEAR_PUSH - 1
+
+    def collect(self, now, temperature, humidity):
+        # the first reading, and one from a clock that went back without clock_stepped(), stand
+        # for one base interval
+        elapsed = now - self.last_collected_at
+        if self.last_collected_at == 0 or elapsed <= 0:
+            elapsed = SENSOR_READ_INTERVAL_SEC
+        self.last_collected_at = now
+        weight = max(1, min(c_div(elapsed + SENSOR_READ_INTERVAL_SEC // 2, SENSOR_READ_INTERVAL_SEC),
+                            CURRENT_READING_MEDIAN_FILTER_SIZE))
+        hour_pushed = False
+        if elapsed > HISTORY_GAP_SEC:
+            hour_pushed = self.skip_gap(elapsed - SENSOR_READ_INTERVAL_SEC)
+            elapsed = SENSOR_READ_INTERVAL_SEC
+        for _ in range(weight):
+            self.t.current.append(pack(temperature))
+            self.h.current.append(pack(humidity))
+        self.t.stats_current = self.t.current[-1]
+        self.h.stats_current = self.h.current[-1]
+
+        full = lambda ch, tier: len(getattr(ch, tier)) == getattr(ch, tier).maxlen
+        self.since_hour += elapsed * full(self.t, "current")
+        self.since_day += elapsed * full(self.t, "hour")
+        self.since_week += elapsed * full(self.t, "day")
+        self.since_month += elapsed * full(self.t, "week")
+        self.since_year += elapsed * full(self.t, "month")
+
+        if self.since_hour >= HOUR_PUSH:
+            hour_t, hour_h = statistics(self.t.current)[1], statistics(self.h.current)[1]
+            for _ in range(PX_PER_1H):
+                if self.since_hour < HOUR_PUSH:
+                    break
+                self.since_hour -= HOUR_PUSH
+                self.t.hour.append(hour_t)
+                self.h.hour.append(hour_h)
+            self.since_hour = min(self.since_hour, HOUR_PUSH - 1)
+            hour_pushed = True
+        if self.since_day >= DAY_PUSH:
+            self.since_day -= DAY_PUSH
+            for ch in (self.t, self.h):
+                ch.day.append(tier_median(ch.hour, 30 // 2))
+        if self.since_week >= WEEK_PUSH:
+            self.since_week -= WEEK_PUSH
+            for ch in (self.t, self.h):
+                ch.week.append(tier_median(ch.day, 4 * 60 // 30))
+        if self.since_month >= MONTH_PUSH:
+            self.since_month -= MONTH_PUSH
+            for ch in (self.t, self.h):
+                ch.month.append(tier_median(ch.week, 8 // 4))
+        if self.since_year >= YEAR_PUSH:
+            self.since_year -= YEAR_PUSH
+            for ch in (self.t, self.h):
+                ch.year.append(tier_median(ch.month, 7 * 24 // 8))
+
+        if hour_pushed:
+            self.t.update_period_stats()
+            self.h.update_period_stats()
+
+    def clock_stepped(self, step_sec):
+        """clockStepped(): the wall clock jumped by step_sec, the next reading is weighted by the
+        time that really passed."""
+        if self.last_collected_at != 0:
+            self.last_collected_at += step_sec
+
+    def skip_gap(self, gap):
+        """skipGap(): moves every running tier on by the slots the gap covers, coarsest first."""
+        full = lambda tier: len(getattr(self.t, tier)) == getattr(self.t, tier).maxlen
+        steps = (("year", "month", YEAR_PUSH, 7 * 24 // 8), ("month", "week", MONTH_PUSH, 8 // 4),
+                 ("week", "day", WEEK_PUSH, 4 * 60 // 30), ("day", "hour", DAY_PUSH, 30 // 2),
+                 ("hour", "current", HOUR_PUSH, None))
+        hour_pushed = False
+        for tier, finer, push, oldest in steps:
+            if not full(finer):
+                continue
+            since = getattr(self, "since_" + tier) + gap
+            setattr(self, "since_" + tier, since % push)
+            slots = since // push
+            if slots == 0:
+                continue
+            for ch in (self.t, self.h):
+                getattr(ch, tier).append(tier_median(getattr(ch, finer), oldest))
+                getattr(ch, tier).extend([GAP] * min(slots - 1, getattr(ch, tier).maxlen))
+            hour_pushed = hour_pushed or tier == "hour"
+        return hour_pushed
+
+    def dump(self):
+        """StatsCollector::dump() up to the exposure statistics, which the cascade does not model."""
+        out = struct.pack("<B6I", 0, *(v & 0xFFFFFFFF for v in (
+            self.last_collected_at, self.since_hour, self.since_day, self.since_week, self.since_month,
+            self.since_year)))
+        for tier in ("current", "hour", "day", "week", "month", "year"):
+            for ch in (self.t, self.h):
+                values = getattr(ch, tier)
+                out += struct.pack("<BB%dH" % len(values), values.maxlen, len(values), *values)
+        for ch in (self.t, self.h):
+            out += struct.pack("<H", ch.stats_current)
+            for stats in (ch.stats_1d, ch.stats_1w, ch.stats_1m):
+                out += struct.pack("<4H", *stats)
+        return out
+
+    def summary(self):
+        return {
+            "current": {"temperature": unpack(self.t.stats_current), "humidity": unpack(self.h.stats_current)},
+            "temperature": {"1D": unpack_stats(self.t.stats_1d), "1W": unpack_stats(self.t.stats_1w),
+                            "1M": unpack_stats(self.t.stats_1m)},
+            "humidity": {"1D": unpack_stats(self.h.stats_1d), "1W": unpack_stats(self.h.stats_1w),
+                         "1M": unpack_stats(self.h.stats_1m)},
+        }